@@ -0,0 +1,231 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Asynchronous logger used by the RDK build of log.h
+ *
+ * LOG() statements copy their message into a lock-free ring buffer and return. The log prefix
+ * (level, file, function and line) is formatted, and the output written and flushed, by a
+ * background thread in batches. Statements below ORB_LOG_MIN_LEVEL are compiled out, and each
+ * statement below ERROR is limited to ORB_LOG_RATE_LIMIT messages per second.
+ */
+
+#ifndef ORB_ASYNC_LOGGER_H
+#define ORB_ASYNC_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#define ORB_LOG_LEVEL_DEBUG 0
+#define ORB_LOG_LEVEL_INFO 1
+#define ORB_LOG_LEVEL_WARNING 2
+#define ORB_LOG_LEVEL_ERROR 3
+#define ORB_LOG_LEVEL_FATAL 4
+
+// Statements below this level are removed at compile time
+#ifndef ORB_LOG_MIN_LEVEL
+#define ORB_LOG_MIN_LEVEL ORB_LOG_LEVEL_DEBUG
+#endif
+
+// Maximum number of messages per second from a single LOG() statement, 0 for no limit. ERROR and
+// FATAL messages are never limited
+#ifndef ORB_LOG_RATE_LIMIT
+#define ORB_LOG_RATE_LIMIT 20
+#endif
+
+namespace orb
+{
+namespace logging
+{
+
+/**
+ * Per-statement state used to rate limit repetitive messages.
+ */
+class CallSite
+{
+public:
+    /**
+     * Check whether a message from this statement may be logged now.
+     *
+     * @param suppressed Set to the number of messages dropped since the last one allowed
+     * @return true if the message should be logged
+     */
+    bool Allow(uint32_t &suppressed);
+
+private:
+    std::atomic<int64_t> mWindow{-1};
+    std::atomic<uint32_t> mCount{0};
+    std::atomic<uint32_t> mSuppressed{0};
+};
+
+class AsyncLogger
+{
+public:
+    static const size_t MAX_MESSAGE_LENGTH = 400;
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    /**
+     * The logger used by LOG() statements. It writes to stdout.
+     */
+    static AsyncLogger& Instance();
+
+    /**
+     * @param capacity Number of messages the ring buffer can hold, rounded up to a power of two
+     * @param output Where the drain thread writes messages
+     */
+    AsyncLogger(size_t capacity, FILE *output);
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /**
+     * Add a message to the ring buffer. Does not wait for the output, and only takes a lock to
+     * wake the drain thread when it is idle. If the buffer is full the message is dropped and
+     * counted.
+     *
+     * @param level The ORB_LOG_LEVEL_* value
+     * @param file, function Must be string literals, they are read later by the drain thread
+     * @param line The line number
+     * @param suppressed Number of messages dropped by rate limiting before this one
+     * @param message, length The message text, truncated to MAX_MESSAGE_LENGTH
+     */
+    void Submit(int level, const char *file, const char *function, int line, uint32_t suppressed,
+        const char *message, size_t length);
+
+    /**
+     * Wait until every message submitted before the call has been written.
+     */
+    void Flush();
+
+    void SetOutput(FILE *output);
+    void SetRunLevel(int level) { mRunLevel.store(level, std::memory_order_relaxed); }
+    bool IsEnabled(int level) const { return level >= mRunLevel.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        int level;
+        int line;
+        const char *file;
+        const char *function;
+        uint32_t suppressed;
+        uint32_t length;
+        char text[MAX_MESSAGE_LENGTH];
+    };
+
+    void Drain();
+    size_t FormatAvailable(std::string &batch);
+    bool IsEmpty() const;
+
+    std::unique_ptr<Slot[]> mSlots;
+    size_t mMask;
+    alignas(64) std::atomic<size_t> mEnqueuePos{0};
+    alignas(64) size_t mDequeuePos = 0;
+    std::atomic<uint64_t> mDropped{0};
+    std::atomic<int> mRunLevel{ORB_LOG_LEVEL_DEBUG};
+
+    std::mutex mOutputMutex; // Held by the drain thread while writing
+    FILE *mOutput;
+
+    std::mutex mWakeMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDrained;
+    std::atomic<bool> mIdle{false}; // Set while the drain thread waits for a message
+    bool mStop = false; // Guarded by mWakeMutex
+    size_t mWrittenPos = 0; // Guarded by mWakeMutex
+    std::thread mThread;
+};
+
+/**
+ * Collects one message with operator<< and submits it when destroyed. The text is written to
+ * a fixed buffer, so building a message does not allocate.
+ */
+class LogMessage
+{
+public:
+    LogMessage(int level, const char *file, const char *function, int line, uint32_t suppressed);
+    ~LogMessage();
+
+    LogMessage(const LogMessage&) = delete;
+    LogMessage& operator=(const LogMessage&) = delete;
+
+    std::ostream& stream() { return mStream; }
+
+private:
+    class Buffer : public std::streambuf
+    {
+    public:
+        Buffer(char *begin, size_t size) { setp(begin, begin + size); }
+        size_t length() const { return pptr() - pbase(); }
+
+    protected:
+        int_type overflow(int_type ch) override { return traits_type::not_eof(ch); } // Truncate
+    };
+
+    int mLevel;
+    const char *mFile;
+    const char *mFunction;
+    int mLine;
+    uint32_t mSuppressed;
+    char mText[AsyncLogger::MAX_MESSAGE_LENGTH];
+    Buffer mBuffer;
+    std::ostream mStream;
+};
+
+/**
+ * Decides once, when a LOG() statement is reached, whether its message is written.
+ */
+class LogGate
+{
+public:
+    LogGate(int level, CallSite &site);
+
+    bool Open() const { return mOpen; }
+    void Close() { mOpen = false; }
+    uint32_t GetSuppressed() const { return mSuppressed; }
+
+private:
+    uint32_t mSuppressed = 0; // Declared first, it is set while mOpen is initialised
+    bool mOpen;
+};
+
+} // namespace logging
+} // namespace orb
+
+/**
+ * ORB_ASYNC_LOG(level) << ...; where level is one of DEBUG, INFO, WARNING, ERROR or FATAL.
+ * Each statement has its own CallSite for rate limiting.
+ */
+#define ORB_ASYNC_LOG(level) ORB_ASYNC_LOG_AT(ORB_LOG_LEVEL_##level)
+
+#define ORB_ASYNC_LOG_AT(levelValue) \
+    if ((levelValue) < ORB_LOG_MIN_LEVEL) {} else \
+        for (orb::logging::LogGate orb_log_gate((levelValue), \
+                 []() -> orb::logging::CallSite& { static orb::logging::CallSite site; return site; }()); \
+             orb_log_gate.Open(); orb_log_gate.Close()) \
+            orb::logging::LogMessage((levelValue), __FILE__, __FUNCTION__, __LINE__, \
+                orb_log_gate.GetSuppressed()).stream()
+
+#endif // ORB_ASYNC_LOGGER_H
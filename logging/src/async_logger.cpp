@@ -0,0 +1,286 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_logger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace orb
+{
+namespace logging
+{
+
+namespace
+{
+const char* LevelName(int level)
+{
+    switch (level)
+    {
+        case ORB_LOG_LEVEL_DEBUG: return "DEBUG";
+        case ORB_LOG_LEVEL_INFO: return "INFO";
+        case ORB_LOG_LEVEL_WARNING: return "WARNING";
+        case ORB_LOG_LEVEL_ERROR: return "ERROR";
+        default: return "FATAL";
+    }
+}
+
+const char* BaseName(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 2;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace
+
+bool CallSite::Allow(uint32_t &suppressed)
+{
+    if (ORB_LOG_RATE_LIMIT == 0)
+    {
+        suppressed = 0;
+        return true;
+    }
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t window = mWindow.load(std::memory_order_relaxed);
+    if (window != now && mWindow.compare_exchange_strong(window, now, std::memory_order_relaxed))
+    {
+        mCount.store(0, std::memory_order_relaxed);
+    }
+    if (mCount.fetch_add(1, std::memory_order_relaxed) < ORB_LOG_RATE_LIMIT)
+    {
+        suppressed = mSuppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    mSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+AsyncLogger& AsyncLogger::Instance()
+{
+    static AsyncLogger instance(DEFAULT_CAPACITY, stdout);
+    return instance;
+}
+
+AsyncLogger::AsyncLogger(size_t capacity, FILE *output) :
+    mSlots(new Slot[RoundUpToPowerOfTwo(capacity)]),
+    mMask(RoundUpToPowerOfTwo(capacity) - 1),
+    mOutput(output)
+{
+    for (size_t i = 0; i <= mMask; i++)
+    {
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mThread = std::thread(&AsyncLogger::Drain, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mStop = true;
+    }
+    mWake.notify_one();
+    mThread.join();
+}
+
+void AsyncLogger::Submit(int level, const char *file, const char *function, int line,
+    uint32_t suppressed, const char *message, size_t length)
+{
+    size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;)
+    {
+        slot = &mSlots[pos & mMask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full, the drain thread is behind
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->line = line;
+    slot->file = file;
+    slot->function = function;
+    slot->suppressed = suppressed;
+    slot->length = static_cast<uint32_t>(length < MAX_MESSAGE_LENGTH ? length : MAX_MESSAGE_LENGTH);
+    memcpy(slot->text, message, slot->length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in Drain, so that either the drain thread sees this message before it
+    // waits, or this sees that it is idle and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mIdle.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mIdle.store(false, std::memory_order_relaxed);
+        mWake.notify_one();
+    }
+}
+
+void AsyncLogger::Flush()
+{
+    size_t target = mEnqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mWakeMutex);
+    mIdle.store(false, std::memory_order_relaxed);
+    mWake.notify_one();
+    mDrained.wait(lock, [this, target] {
+        return mWrittenPos >= target || mStop;
+    });
+}
+
+void AsyncLogger::SetOutput(FILE *output)
+{
+    Flush();
+    std::lock_guard<std::mutex> lock(mOutputMutex);
+    mOutput = output;
+}
+
+bool AsyncLogger::IsEmpty() const
+{
+    return mSlots[mDequeuePos & mMask].sequence.load(std::memory_order_acquire) != mDequeuePos + 1;
+}
+
+size_t AsyncLogger::FormatAvailable(std::string &batch)
+{
+    size_t count = 0;
+    while (count <= mMask)
+    {
+        Slot &slot = mSlots[mDequeuePos & mMask];
+        if (slot.sequence.load(std::memory_order_acquire) != mDequeuePos + 1)
+        {
+            break;
+        }
+        batch += '[';
+        batch += LevelName(slot.level);
+        batch += "] ";
+        batch += BaseName(slot.file);
+        batch += ':';
+        batch += slot.function;
+        batch += ':';
+        batch += std::to_string(slot.line);
+        batch += ": ";
+        batch.append(slot.text, slot.length);
+        if (slot.suppressed > 0)
+        {
+            batch += " (";
+            batch += std::to_string(slot.suppressed);
+            batch += " similar messages suppressed)";
+        }
+        batch += '\n';
+        slot.sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+        mDequeuePos++;
+        count++;
+    }
+    return count;
+}
+
+void AsyncLogger::Drain()
+{
+    std::string batch;
+    batch.reserve(64 * 1024);
+    for (;;)
+    {
+        batch.clear();
+        size_t count = FormatAvailable(batch);
+        if (count > 0)
+        {
+            std::lock_guard<std::mutex> lock(mOutputMutex);
+            fwrite(batch.data(), 1, batch.size(), mOutput);
+            fflush(mOutput);
+        }
+
+        std::unique_lock<std::mutex> lock(mWakeMutex);
+        mWrittenPos = mDequeuePos;
+        mDrained.notify_all();
+        if (count == 0)
+        {
+            if (mStop)
+            {
+                break;
+            }
+            // Sleep until Submit, Flush or the destructor wakes the thread
+            mIdle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!IsEmpty())
+            {
+                mIdle.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            mWake.wait(lock, [this] {
+                return !mIdle.load(std::memory_order_relaxed) || mStop;
+            });
+            mIdle.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+LogGate::LogGate(int level, CallSite &site) :
+    mOpen(AsyncLogger::Instance().IsEnabled(level) &&
+          (level >= ORB_LOG_LEVEL_ERROR || site.Allow(mSuppressed)))
+{
+}
+
+LogMessage::LogMessage(int level, const char *file, const char *function, int line,
+    uint32_t suppressed) :
+    mLevel(level),
+    mFile(file),
+    mFunction(function),
+    mLine(line),
+    mSuppressed(suppressed),
+    mBuffer(mText, sizeof(mText)),
+    mStream(&mBuffer)
+{
+}
+
+LogMessage::~LogMessage()
+{
+    AsyncLogger &logger = AsyncLogger::Instance();
+    logger.Submit(mLevel, mFile, mFunction, mLine, mSuppressed, mText, mBuffer.length());
+    if (mLevel >= ORB_LOG_LEVEL_FATAL)
+    {
+        logger.Flush();
+        abort();
+    }
+}
+
+} // namespace logging
+} // namespace orb
@@ -0,0 +1,151 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for the cost of logging on the AIT section path (ApplicationManager::ProcessAitSection)
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "async_logger.h"
+#include "ait.h"
+
+namespace
+{
+
+/**
+ * Build an AIT section for application_type 0x0010 with the given number of applications and no
+ * descriptors.
+ */
+std::vector<uint8_t> BuildAitSection(uint8_t numApps)
+{
+    const uint16_t appLoopLength = numApps * 9;
+    const uint16_t sectionLength = 9 + appLoopLength + 4;
+    std::vector<uint8_t> section = {
+        0x74, static_cast<uint8_t>(0xB0 | (sectionLength >> 8)), static_cast<uint8_t>(sectionLength),
+        0x00, 0x10, // application_type
+        0xC3, // version 1, current
+        0x00, 0x00, // section_number, last_section_number
+        0xF0, 0x00, // common_descriptors_length
+        static_cast<uint8_t>(0xF0 | (appLoopLength >> 8)), static_cast<uint8_t>(appLoopLength),
+    };
+    for (uint8_t i = 0; i < numApps; i++)
+    {
+        const uint8_t app[] = {
+            0x00, 0x00, 0x00, 0x01, // organisation_id
+            0x00, static_cast<uint8_t>(i + 1), // application_id
+            0x01, // AUTOSTART
+            0xF0, 0x00, // application_descriptors_loop_length
+        };
+        section.insert(section.end(), app, app + sizeof(app));
+    }
+    section.resize(section.size() + 4); // CRC, not checked
+    return section;
+}
+
+// The logging pattern the RDK build used before, one synchronous write and flush per message
+#define LEGACY_LOG(fp, level, fmt, ...) do { \
+        fprintf(fp, "[%s] %s:%s:%d: " fmt "\n", level, __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+        fflush(fp); \
+} while (0)
+
+/**
+ * Repeated copies of a received AIT section, as filtered from the broadcast, logging with a
+ * synchronous fprintf and fflush per message.
+ */
+void BM_ProcessAitSection_SyncLogging(benchmark::State& state)
+{
+    std::vector<uint8_t> section = BuildAitSection(4);
+    FILE *fp = tmpfile();
+    orb::Ait ait;
+    ait.ProcessSection(section.data(), section.size());
+
+    for (auto _ : state) {
+        LEGACY_LOG(fp, "INFO", "ProcessAitSection");
+        bool updated = ait.ProcessSection(section.data(), section.size());
+        if (!updated)
+        {
+            LEGACY_LOG(fp, "INFO", "The AIT was not completed and/or updated, early out");
+        }
+        benchmark::DoNotOptimize(updated);
+    }
+    fclose(fp);
+}
+BENCHMARK(BM_ProcessAitSection_SyncLogging);
+
+/**
+ * As above, logging with the asynchronous logger. The messages are built with LogMessage, as a
+ * LOG() statement does, but without its rate limit, which would otherwise drop all but the first
+ * ORB_LOG_RATE_LIMIT messages each second and leave nothing to measure. The ring buffer is
+ * flushed, untimed, before it can fill, so that no message is dropped.
+ */
+void BM_ProcessAitSection_AsyncLogging(benchmark::State& state)
+{
+    std::vector<uint8_t> section = BuildAitSection(4);
+    FILE *fp = tmpfile();
+    orb::logging::AsyncLogger &logger = orb::logging::AsyncLogger::Instance();
+    logger.SetOutput(fp);
+    uint64_t droppedBefore = logger.GetDroppedCount();
+    orb::Ait ait;
+    ait.ProcessSection(section.data(), section.size());
+
+    // Each iteration logs two messages
+    const size_t flushInterval = orb::logging::AsyncLogger::DEFAULT_CAPACITY / 4;
+    size_t iterations = 0;
+    for (auto _ : state) {
+        if (++iterations % flushInterval == 0)
+        {
+            state.PauseTiming();
+            logger.Flush();
+            state.ResumeTiming();
+        }
+        orb::logging::LogMessage(ORB_LOG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, 0).stream()
+            << "ProcessAitSection";
+        bool updated = ait.ProcessSection(section.data(), section.size());
+        if (!updated)
+        {
+            orb::logging::LogMessage(ORB_LOG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, 0).stream()
+                << "The AIT was not completed and/or updated, early out";
+        }
+        benchmark::DoNotOptimize(updated);
+    }
+    logger.Flush();
+    logger.SetOutput(stdout);
+    fclose(fp);
+    state.counters["dropped"] = static_cast<double>(logger.GetDroppedCount() - droppedBefore);
+}
+BENCHMARK(BM_ProcessAitSection_AsyncLogging);
+
+/**
+ * The cost to the caller of one message that is not rate limited.
+ */
+void BM_AsyncLogger_Submit(benchmark::State& state)
+{
+    FILE *fp = tmpfile();
+    orb::logging::AsyncLogger logger(orb::logging::AsyncLogger::DEFAULT_CAPACITY, fp);
+    const char message[] = "The AIT was not completed and/or updated, early out";
+
+    for (auto _ : state) {
+        logger.Submit(ORB_LOG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, 0, message,
+            sizeof(message) - 1);
+    }
+    logger.Flush();
+    fclose(fp);
+}
+BENCHMARK(BM_AsyncLogger_Submit);
+
+} // namespace
@@ -0,0 +1,185 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for broadcast AIT sections received by ApplicationManager::ProcessAitSection
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "third_party/orb/orblibrary/moderator/app_mgr/application_manager.h"
+#include "MockApplicationSessionCallback.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace
+{
+
+const uint16_t ORIGINAL_NETWORK_ID = 0x233a;
+const uint16_t TRANSPORT_STREAM_ID = 0x1004;
+const uint16_t SERVICE_ID = 0x10bf;
+const uint16_t AIT_PID = 0x0bb9;
+
+void AppendDescriptor(std::vector<uint8_t>& loop, uint8_t tag, const std::vector<uint8_t>& body)
+{
+    loop.push_back(tag);
+    loop.push_back(static_cast<uint8_t>(body.size()));
+    loop.insert(loop.end(), body.begin(), body.end());
+}
+
+void AppendString(std::vector<uint8_t>& body, const std::string& text, bool withLength)
+{
+    if (withLength)
+    {
+        body.push_back(static_cast<uint8_t>(text.size()));
+    }
+    body.insert(body.end(), text.begin(), text.end());
+}
+
+/**
+ * Append an application signalled like a typical broadband HbbTV app: HbbTV 1.2.1, an HTTP
+ * transport, an English name and a simple application location.
+ */
+void AppendApplication(std::vector<uint8_t>& appLoop, uint16_t appId, uint8_t controlCode,
+    const std::string& name, const std::string& baseUrl, const std::string& location)
+{
+    std::vector<uint8_t> descriptors;
+    AppendDescriptor(descriptors, 0x00, { // application_descriptor
+        0x05, // application_profiles_length
+        0x00, 0x00, 0x01, 0x02, 0x01, // profile 0, version 1.2.1
+        0xff, // service_bound, visibility VISIBLE_ALL
+        0x01, // application_priority
+        0x01, // transport_protocol_label
+    });
+    std::vector<uint8_t> nameBody = {'e', 'n', 'g'};
+    AppendString(nameBody, name, true);
+    AppendDescriptor(descriptors, 0x01, nameBody); // application_name_descriptor
+    std::vector<uint8_t> transportBody = {
+        0x00, 0x03, // protocol_id HTTP
+        0x01, // transport_protocol_label
+    };
+    AppendString(transportBody, baseUrl, true);
+    transportBody.push_back(0x00); // URL_extension_count
+    AppendDescriptor(descriptors, 0x02, transportBody); // transport_protocol_descriptor
+    std::vector<uint8_t> locationBody;
+    AppendString(locationBody, location, false);
+    AppendDescriptor(descriptors, 0x15, locationBody); // simple_application_location_descriptor
+
+    const uint8_t header[] = {
+        0x00, 0x00, 0x00, 0x17, // organisation_id
+        static_cast<uint8_t>(appId >> 8), static_cast<uint8_t>(appId),
+        controlCode,
+        static_cast<uint8_t>(0xF0 | (descriptors.size() >> 8)),
+        static_cast<uint8_t>(descriptors.size()),
+    };
+    appLoop.insert(appLoop.end(), header, header + sizeof(header));
+    appLoop.insert(appLoop.end(), descriptors.begin(), descriptors.end());
+}
+
+/**
+ * Build the AIT section of a service with a red button app and a programme guide, as broadcast
+ * and repeated on the AIT PID.
+ */
+std::vector<uint8_t> BuildServiceAitSection(uint8_t version)
+{
+    std::vector<uint8_t> appLoop;
+    AppendApplication(appLoop, 1, 0x01 /* AUTOSTART */, "Red Button",
+        "http://hbbtv.example.com/redbutton/", "index.html?lloc=service");
+    AppendApplication(appLoop, 2, 0x02 /* PRESENT */, "Programme Guide",
+        "http://hbbtv.example.com/guide/", "guide.html");
+
+    const uint16_t sectionLength = 9 + appLoop.size() + 4;
+    std::vector<uint8_t> section = {
+        0x74, static_cast<uint8_t>(0xB0 | (sectionLength >> 8)), static_cast<uint8_t>(sectionLength),
+        0x00, 0x10, // application_type
+        static_cast<uint8_t>(0xC1 | ((version & 0x1F) << 1)), // version, current
+        0x00, 0x00, // section_number, last_section_number
+        0xF0, 0x00, // common_descriptors_length
+        static_cast<uint8_t>(0xF0 | (appLoop.size() >> 8)), static_cast<uint8_t>(appLoop.size()),
+    };
+    section.insert(section.end(), appLoop.begin(), appLoop.end());
+    section.resize(section.size() + 4); // CRC, not checked
+    return section;
+}
+
+/**
+ * ApplicationManager tuned to a service, with a session callback that answers every call.
+ */
+class TunedApplicationManager
+{
+public:
+    TunedApplicationManager()
+    {
+        ON_CALL(mCallback, GetParentalControlRegion()).WillByDefault(Return("GB"));
+        ON_CALL(mCallback, GetParentalControlRegion3()).WillByDefault(Return("GBR"));
+        ON_CALL(mCallback, GetParentalControlAge()).WillByDefault(Return(18));
+        mAppManager.OnNetworkAvailabilityChanged(true);
+        mAppManager.RegisterCallback(orb::APP_TYPE_HBBTV, &mCallback);
+        mAppManager.OnChannelChanged(ORIGINAL_NETWORK_ID, TRANSPORT_STREAM_ID, SERVICE_ID);
+    }
+
+    void ProcessAitSection(const std::vector<uint8_t>& section)
+    {
+        mAppManager.ProcessAitSection(AIT_PID, SERVICE_ID, section.data(), section.size());
+    }
+
+private:
+    NiceMock<orb::MockApplicationSessionCallback> mCallback;
+    orb::ApplicationManager mAppManager;
+};
+
+/**
+ * The same section repeated, as it is between AIT updates. The section is parsed and found to
+ * be unchanged.
+ */
+void BM_ApplicationManager_ProcessAitSection_Repeated(benchmark::State& state)
+{
+    const std::vector<uint8_t> section = BuildServiceAitSection(1);
+    TunedApplicationManager appManager;
+    appManager.ProcessAitSection(section);
+
+    for (auto _ : state)
+    {
+        appManager.ProcessAitSection(section);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * section.size());
+}
+BENCHMARK(BM_ApplicationManager_ProcessAitSection_Repeated);
+
+/**
+ * A new version of the section every time, so that the running app is checked against the
+ * updated AIT.
+ */
+void BM_ApplicationManager_ProcessAitSection_Updated(benchmark::State& state)
+{
+    const std::vector<uint8_t> sections[] = {
+        BuildServiceAitSection(1), BuildServiceAitSection(2)
+    };
+    TunedApplicationManager appManager;
+    appManager.ProcessAitSection(sections[0]);
+
+    size_t next = 1;
+    for (auto _ : state)
+    {
+        appManager.ProcessAitSection(sections[next]);
+        next ^= 1;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sections[0].size());
+}
+BENCHMARK(BM_ApplicationManager_ProcessAitSection_Updated);
+
+} // namespace
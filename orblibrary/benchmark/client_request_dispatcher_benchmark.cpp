@@ -0,0 +1,201 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for request latency through the JS bridge when some Live TV client requests are slow
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "ClientRequestDispatcher.h"
+#include "IOrbBrowser.h"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// One JS bridge issues this many requests per iteration, one every ARRIVAL_INTERVAL.
+// Every SLOW_EVERY'th request is a slow platform call such as a programme query.
+const int REQUESTS_PER_ITERATION = 32;
+const int SLOW_EVERY = 4;
+const std::chrono::microseconds ARRIVAL_INTERVAL(250);
+const std::chrono::microseconds FAST_COST(100);
+const std::chrono::microseconds SLOW_COST(2000);
+const int CLIENT_THREADS = 4;
+
+const std::string FAST_REQUEST = R"({"method":"Configuration.getLocalSystem","params":{}})";
+const std::string SLOW_REQUEST = R"({"method":"Programme.getProgrammes","params":{"ccid":"ccid:1"}})";
+
+/**
+ * Live TV client that takes a fixed time to answer each request. Asynchronous requests are
+ * answered by a small pool of client threads.
+ */
+class SimulatedClient : public orb::IOrbBrowser
+{
+public:
+    SimulatedClient()
+    {
+        for (int i = 0; i < CLIENT_THREADS; i++)
+        {
+            mThreads.emplace_back([this] { Run(); });
+        }
+    }
+
+    ~SimulatedClient() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        for (auto &thread : mThreads)
+        {
+            thread.join();
+        }
+    }
+
+    void loadApplication(std::string, std::string, orb::onPageLoadedSuccess) override {}
+    void showApplication() override {}
+    void hideApplication() override {}
+    void dispatchEvent(const std::string&, const std::string&) override {}
+    void notifyKeySetChange(const uint16_t, const std::vector<uint16_t>&) override {}
+
+    std::string sendRequestToClient(std::string jsonRequest) override
+    {
+        std::this_thread::sleep_for(jsonRequest == SLOW_REQUEST ? SLOW_COST : FAST_COST);
+        return "{\"result\": {}}";
+    }
+
+    void sendRequestToClientAsync(uint32_t requestId, std::string jsonRequest,
+        orb::onClientResponse callback) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueue.push_back([this, requestId, jsonRequest, callback] {
+                callback(requestId, sendRequestToClient(jsonRequest));
+            });
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    void Run()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this] { return mStop || !mQueue.empty(); });
+                if (mStop)
+                {
+                    return;
+                }
+                job = std::move(mQueue.front());
+                mQueue.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::function<void()>> mQueue;
+    std::vector<std::thread> mThreads;
+    bool mStop = false;
+};
+
+const std::string& RequestAt(int index)
+{
+    return (index % SLOW_EVERY == SLOW_EVERY - 1) ? SLOW_REQUEST : FAST_REQUEST;
+}
+
+void ReportLatency(benchmark::State& state, std::vector<double> latenciesUs)
+{
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&latenciesUs](double p) {
+        return latenciesUs[static_cast<size_t>(p * (latenciesUs.size() - 1))];
+    };
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["max_us"] = latenciesUs.back();
+}
+
+/**
+ * The bridge thread waits for each response before it can issue the next request
+ */
+void BM_ClientRequests_Synchronous(benchmark::State& state)
+{
+    SimulatedClient client;
+    std::vector<double> latencies;
+    for (auto _ : state)
+    {
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < REQUESTS_PER_ITERATION; i++)
+        {
+            const Clock::time_point arrival = start + i * ARRIVAL_INTERVAL;
+            std::this_thread::sleep_until(arrival);
+            std::string response = client.sendRequestToClient(RequestAt(i));
+            benchmark::DoNotOptimize(response.data());
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - arrival).count());
+        }
+    }
+    ReportLatency(state, latencies);
+}
+BENCHMARK(BM_ClientRequests_Synchronous)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * The bridge thread issues each request as it arrives and responses complete independently
+ */
+void BM_ClientRequests_Pipelined(benchmark::State& state)
+{
+    SimulatedClient client;
+    orb::ClientRequestDispatcher dispatcher(&client, state.range(0));
+    std::mutex latenciesMutex;
+    std::vector<double> latencies;
+    for (auto _ : state)
+    {
+        std::atomic<int> outstanding(REQUESTS_PER_ITERATION);
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < REQUESTS_PER_ITERATION; i++)
+        {
+            const Clock::time_point arrival = start + i * ARRIVAL_INTERVAL;
+            std::this_thread::sleep_until(arrival);
+            dispatcher.Send(RequestAt(i), [&, arrival](std::string response) {
+                benchmark::DoNotOptimize(response.data());
+                std::lock_guard<std::mutex> lock(latenciesMutex);
+                latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - arrival).count());
+                outstanding--;
+            });
+        }
+        while (outstanding > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    ReportLatency(state, latencies);
+}
+BENCHMARK(BM_ClientRequests_Pipelined)->Arg(1)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
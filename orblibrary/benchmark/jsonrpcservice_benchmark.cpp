@@ -0,0 +1,130 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for messages received by the JSON-RPC service from HbbTV applications and the IP
+ * player
+ */
+
+#include <chrono>
+#include <string>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "JsonRpcService.h"
+#include "IPPlaybackStateAggregator.h"
+
+using orb::networkServices::IPPlaybackStateAggregator;
+using orb::networkServices::JsonRpcService;
+using orb::networkServices::WebSocketService;
+
+namespace
+{
+
+// Media state notification sent by an app every time its player changes position or state
+const std::string STATE_MEDIA_NOTIFICATION =
+    R"({"jsonrpc":"2.0","method":"org.hbbtv.app.state.media","params":{"state":"playing",)"
+    R"("kind":"audio-video","type":"on-demand","currentTime":754.2,)"
+    R"("range":{"start":0,"end":3137.4},"availableActions":{"pause":true,"play":false,)"
+    R"("fast-forward":true,"fast-reverse":true,"stop":true,"seek-content":true,)"
+    R"("seek-relative":true,"seek-live":false,"seek-wallclock":false},)"
+    R"("metadata":{"mediaId":"urn:example:media:5a5d3c","title":"The News at Six",)"
+    R"("secondaryTitle":"Tuesday","synopsis":"The latest national and international news."},)"
+    R"("accessibility":{"subtitles":{"enabled":true,"available":true},)"
+    R"("audioDescription":{"enabled":false,"available":true},)"
+    R"("signLanguage":{"enabled":false,"available":false}}}})";
+
+const std::string NEGOTIATE_STATE_MEDIA_REQUEST =
+    R"({"jsonrpc":"2.0","id":1,"method":"org.hbbtv.negotiateMethods","params":)"
+    R"({"terminalToApp":[],"appToTerminal":["org.hbbtv.app.state.media"]}})";
+
+/**
+ * ISessionCallback that does nothing, so that only the service is measured
+ */
+class NullSessionCallback : public JsonRpcService::ISessionCallback
+{
+public:
+    void RequestNegotiateMethods() override {}
+    void RequestSubscribe(const JsonRpcService::SubscribeOptions&) override {}
+    void RequestUnsubscribe(const JsonRpcService::SubscribeOptions&) override {}
+    void RequestDialogueEnhancementOverride(int, std::string, int) override {}
+    void RequestTriggerResponseToUserAction(int, std::string, std::string) override {}
+    void RequestFeatureSupportInfo(int, std::string, int) override {}
+    void RequestFeatureSettingsQuery(int, std::string, int) override {}
+    void RequestFeatureSuppress(int, std::string, int) override {}
+    void NotifyVoiceReady(bool) override {}
+    void NotifyStateMedia(std::string state) override
+    {
+        benchmark::DoNotOptimize(state.data());
+    }
+    void RespondMessage(std::string) override {}
+    void ReceiveConfirm(int, std::string, std::string) override {}
+    void ReceiveConfirmForSelectChannel(int, std::string, std::string, int) override {}
+    void ReceiveError(int, std::string) override {}
+    void ReceiveError(int, std::string, std::string, std::string) override {}
+    void RequestIPPlaybackStatusUpdate(const Json::Value&) override {}
+    void RequestIPPlaybackMediaPositionUpdate(const Json::Value&) override {}
+    void RequestIPPlaybackSetComponents(const Json::Value&) override {}
+    void RequestIPPlaybackSetPresentFollowing(const Json::Value&) override {}
+    void RequestIPPlaybackSetTimelineMapping(const Json::Value&) override {}
+};
+
+/**
+ * A media state notification from a connected app that has negotiated the method. Notifications
+ * have no response, so nothing is queued on the connection.
+ */
+void BM_JsonRpcService_StateMediaNotification(benchmark::State& state)
+{
+    JsonRpcService service(8910, "/hbbtv/jsonrpc", std::make_unique<NullSessionCallback>());
+    WebSocketService::WebSocketConnection connection(nullptr, "/hbbtv/jsonrpc");
+    service.OnConnection(&connection);
+    service.OnMessageReceived(&connection, NEGOTIATE_STATE_MEDIA_REQUEST);
+
+    for (auto _ : state)
+    {
+        service.OnMessageReceived(&connection, STATE_MEDIA_NOTIFICATION);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+        STATE_MEDIA_NOTIFICATION.size());
+    service.OnDisconnected(&connection);
+}
+BENCHMARK(BM_JsonRpcService_StateMediaNotification);
+
+/**
+ * Media position updates from an IP player, forwarded through the IP playback state aggregator
+ * with the given interval in milliseconds. The player posts faster than the interval.
+ */
+void BM_IPPlaybackStateAggregator_MediaPosition(benchmark::State& state)
+{
+    int64_t forwarded = 0;
+    IPPlaybackStateAggregator aggregator(
+        [&forwarded](IPPlaybackStateAggregator::UpdateType, const Json::Value&) {
+        forwarded++;
+    });
+    aggregator.SetInterval(std::chrono::milliseconds(state.range(0)));
+    Json::Value params;
+    params["sessionID"] = 1;
+    double currentTime = 0;
+
+    for (auto _ : state)
+    {
+        currentTime += 0.04;
+        params["currentTime"] = currentTime;
+        aggregator.Update(IPPlaybackStateAggregator::UpdateType::MediaPosition, params);
+    }
+    aggregator.Stop();
+    state.counters["forwarded"] = static_cast<double>(forwarded);
+}
+BENCHMARK(BM_IPPlaybackStateAggregator_MediaPosition)->Arg(0)->Arg(250);
+
+} // namespace
@@ -0,0 +1,128 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for the per-request cost of the JS bridge in Moderator::handleOrbRequest
+ */
+
+#include <string>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "Moderator.h"
+#include "JsonImpl.h"
+#include "RequestEnvelope.h"
+#include "StringUtil.h"
+
+namespace
+{
+
+// A typical request that the moderator proxies to the Live TV client
+const std::string PROXY_REQUEST =
+    R"({"method":"Broadcast.getProgrammes","token":{"payload":{"appId":1,"uri":"http://example.com/app/index.html"},)"
+    R"("signature":"2a0d0a4d1a51b7c5a0f3f3d45d0e1c8d1e9d6d7e0bba6e9b0c3fd8a3b4f1d2c9"},)"
+    R"("params":{"ccid":"ccid:dvbt.1.1.1","startTime":1735689600,"count":16,"offset":0}})";
+
+// A typical request that the moderator handles itself
+const std::string MANAGER_REQUEST =
+    R"({"method":"Manager.getKeyMaximumValue","token":"token","params":{"id":1}})";
+
+/**
+ * IOrbBrowser that answers every request immediately, so that only the moderator is measured
+ */
+class NullOrbBrowser : public orb::IOrbBrowser
+{
+public:
+    void loadApplication(std::string, std::string, orb::onPageLoadedSuccess) override {}
+    void showApplication() override {}
+    void hideApplication() override {}
+    std::string sendRequestToClient(std::string jsonRequest) override
+    {
+        benchmark::DoNotOptimize(jsonRequest.data());
+        return "{\"result\": []}";
+    }
+    void dispatchEvent(const std::string&, const std::string&) override {}
+    void notifyKeySetChange(const uint16_t, const std::vector<uint16_t>&) override {}
+};
+
+/**
+ * The request handling that the moderator did before RequestEnvelope: parse into IJson, copy the
+ * params into a new object and serialise the whole request again to forward it
+ */
+void BM_ProxyRequest_IJsonRoundTrip(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::unique_ptr<orb::IJson> json = std::make_unique<orb::JsonImpl>();
+        json->parse(PROXY_REQUEST);
+        bool valid = !json->hasParam("error") && json->hasParam("method", orb::IJson::JSON_TYPE_STRING) &&
+            json->hasParam("params", orb::IJson::JSON_TYPE_OBJECT);
+        json->setInteger("params", orb::APP_TYPE_HBBTV, "applicationType");
+        std::string component;
+        std::string method;
+        orb::StringUtil::ResolveMethod(json->getString("method"), component, method);
+        std::unique_ptr<orb::IJson> params = json->getObject("params");
+        std::string token = json->getString("token");
+        std::string forward = json->toString();
+        benchmark::DoNotOptimize(valid);
+        benchmark::DoNotOptimize(params.get());
+        benchmark::DoNotOptimize(forward.data());
+    }
+}
+BENCHMARK(BM_ProxyRequest_IJsonRoundTrip);
+
+void BM_ProxyRequest_Envelope(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        orb::RequestEnvelope request;
+        bool valid = request.Parse(PROXY_REQUEST) == orb::RequestEnvelope::STATUS_OK;
+        request.SetApplicationType(orb::APP_TYPE_HBBTV);
+        std::string component;
+        std::string method;
+        orb::StringUtil::ResolveMethod(request.GetMethod(), component, method);
+        const orb::IJson& params = request.GetParams();
+        std::string token = request.GetToken();
+        std::string forward = request.TakeForwardRequest();
+        benchmark::DoNotOptimize(valid);
+        benchmark::DoNotOptimize(&params);
+        benchmark::DoNotOptimize(forward.data());
+    }
+}
+BENCHMARK(BM_ProxyRequest_Envelope);
+
+void BM_Moderator_ProxyRequest(benchmark::State& state)
+{
+    NullOrbBrowser browser;
+    orb::Moderator moderator(&browser, orb::APP_TYPE_HBBTV);
+    for (auto _ : state)
+    {
+        std::string response = moderator.handleOrbRequest(PROXY_REQUEST);
+        benchmark::DoNotOptimize(response.data());
+    }
+}
+BENCHMARK(BM_Moderator_ProxyRequest);
+
+void BM_Moderator_ManagerRequest(benchmark::State& state)
+{
+    NullOrbBrowser browser;
+    orb::Moderator moderator(&browser, orb::APP_TYPE_HBBTV);
+    for (auto _ : state)
+    {
+        std::string response = moderator.handleOrbRequest(MANAGER_REQUEST);
+        benchmark::DoNotOptimize(response.data());
+    }
+}
+BENCHMARK(BM_Moderator_ManagerRequest);
+
+} // namespace
@@ -0,0 +1,121 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for RFC 7692 permessage-deflate on the messages of the companion screen WebSocket
+ * services. Each message is compressed as libwebsockets does it: raw deflate, flushed with
+ * Z_SYNC_FLUSH and without the trailing 00 00 ff ff. With context takeover the deflate stream
+ * continues from the previous message, without it the stream is reset for each message.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "third_party/zlib/zlib.h"
+
+namespace
+{
+
+// CII message sent to every companion device when the presentation changes
+std::string CiiMessage(int i)
+{
+    return R"({"protocolVersion":"1.1","mrsUrl":null,)"
+        R"("contentId":"dvb://233a.1004.1044;)" + std::to_string(0x363a + i) + "~20250304T" +
+        std::to_string(1000 + i % 1400) + R"(Z--PT00H30M",)"
+        R"("contentIdStatus":"final","presentationStatus":"okay",)"
+        R"("wcUrl":"udp://192.168.1.20:6677","tsUrl":"ws://192.168.1.20:7681/ts",)"
+        R"("teUrl":null,"timelines":[{"timelineSelector":"urn:dvb:css:timeline:pts",)"
+        R"("timelineProperties":{"unitsPerTick":1,"unitsPerSecond":90000}},)"
+        R"({"timelineSelector":"urn:dvb:css:timeline:temi:1:)" + std::to_string(i % 4) +
+        R"(","timelineProperties":{"unitsPerTick":1,"unitsPerSecond":1000}}],)"
+        R"("private":[{"type":"urn:example:cii:programme","title":"The News at Six"}]})";
+}
+
+// Control timestamp sent by the TS service to each companion device
+std::string ControlTimestamp(int i)
+{
+    return R"({"contentTime":")" + std::to_string(1234567890 + i * 3600) +
+        R"(","wallClockTime":")" + std::to_string(1741113000000000000LL + i * 40000000LL) +
+        R"(","timelineSpeedMultiplier":1})";
+}
+
+// Media state notification, as JsonRpcService forwards to a companion app
+std::string StateMediaNotification(int i)
+{
+    return R"({"jsonrpc":"2.0","method":"org.hbbtv.app.state.media","params":{"state":"playing",)"
+        R"("kind":"audio-video","type":"on-demand","currentTime":)" + std::to_string(754 + i) +
+        R"(,"range":{"start":0,"end":3137.4},"availableActions":{"pause":true,"play":false,)"
+        R"("fast-forward":true,"fast-reverse":true,"stop":true,"seek-content":true,)"
+        R"("seek-relative":true,"seek-live":false,"seek-wallclock":false},)"
+        R"("metadata":{"mediaId":"urn:example:media:5a5d3c","title":"The News at Six"}}})";
+}
+
+/**
+ * Compress each message in turn and report the bytes on the wire per message.
+ */
+void CompressMessages(benchmark::State &state, std::string (*message)(int), bool contextTakeover)
+{
+    std::vector<std::string> messages;
+    // More messages than fit in the 32KB window, so that no message is an exact repeat
+    for (int i = 0; i < 1024; i++)
+    {
+        messages.push_back(message(i));
+    }
+    z_stream stream = {};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::vector<unsigned char> output(4096);
+    size_t inputBytes = 0;
+    size_t outputBytes = 0;
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        std::string &text = messages[i++ % messages.size()];
+        if (!contextTakeover)
+        {
+            deflateReset(&stream);
+        }
+        stream.next_in = reinterpret_cast<unsigned char *>(&text[0]);
+        stream.avail_in = static_cast<unsigned int>(text.size());
+        stream.next_out = output.data();
+        stream.avail_out = static_cast<unsigned int>(output.size());
+        deflate(&stream, Z_SYNC_FLUSH);
+        benchmark::DoNotOptimize(output.data());
+        inputBytes += text.size();
+        outputBytes += output.size() - stream.avail_out - 4;
+    }
+    deflateEnd(&stream);
+    state.counters["in_bytes_per_msg"] = static_cast<double>(inputBytes) / state.iterations();
+    state.counters["out_bytes_per_msg"] = static_cast<double>(outputBytes) / state.iterations();
+}
+
+void BM_PermessageDeflate_Cii(benchmark::State &state)
+{
+    CompressMessages(state, CiiMessage, state.range(0) != 0);
+}
+BENCHMARK(BM_PermessageDeflate_Cii)->ArgName("contextTakeover")->Arg(1)->Arg(0);
+
+void BM_PermessageDeflate_ControlTimestamp(benchmark::State &state)
+{
+    CompressMessages(state, ControlTimestamp, state.range(0) != 0);
+}
+BENCHMARK(BM_PermessageDeflate_ControlTimestamp)->ArgName("contextTakeover")->Arg(1)->Arg(0);
+
+void BM_PermessageDeflate_StateMedia(benchmark::State &state)
+{
+    CompressMessages(state, StateMediaNotification, state.range(0) != 0);
+}
+BENCHMARK(BM_PermessageDeflate_StateMedia)->ArgName("contextTakeover")->Arg(1)->Arg(0);
+
+} // namespace
@@ -0,0 +1,69 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for the app boundary check made for privileged requests
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "utils.h"
+
+namespace
+{
+
+const std::string kAppUri = "https://app.example.com/apps/entry.html";
+const std::string kPageUrl = "https://cdn7.example.com/apps/page.html?x=1";
+
+std::vector<std::string> BuildBoundaries(int count)
+{
+    std::vector<std::string> boundaries;
+    for (int i = 0; i < count; i++)
+    {
+        boundaries.push_back("https://cdn" + std::to_string(i) + ".example.com/");
+    }
+    return boundaries;
+}
+
+/**
+ * Origins of the app URI and boundaries parsed on every check
+ */
+void BM_CheckBoundaries(benchmark::State& state)
+{
+    const std::vector<std::string> boundaries = BuildBoundaries(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        bool allowed = orb::Utils::CheckBoundaries(kPageUrl, kAppUri, boundaries);
+        benchmark::DoNotOptimize(allowed);
+    }
+}
+BENCHMARK(BM_CheckBoundaries)->Arg(1)->Arg(8)->Arg(32);
+
+/**
+ * Origins compiled once per app, as HbbTVApp::IsInBoundaries
+ */
+void BM_OriginSetContains(benchmark::State& state)
+{
+    const orb::Utils::OriginSet origins(kAppUri, BuildBoundaries(static_cast<int>(state.range(0))));
+
+    for (auto _ : state) {
+        bool allowed = origins.Contains(kPageUrl);
+        benchmark::DoNotOptimize(allowed);
+    }
+}
+BENCHMARK(BM_OriginSetContains)->Arg(1)->Arg(8)->Arg(32);
+
+} // namespace
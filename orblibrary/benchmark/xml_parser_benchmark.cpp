@@ -0,0 +1,111 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for XML AIT parsing (XmlParser and XmlStreamParser)
+ */
+
+#include <string>
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+#include "xml_parser.h"
+
+namespace
+{
+
+/**
+ * Build an XML AIT like those fetched during OpApp discovery, with the given number of
+ * applications.
+ */
+std::string BuildXmlAit(int numApps)
+{
+    std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<mhp:ServiceDiscovery xmlns:mhp="urn:dvb:mhp:2009" xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance">
+  <mhp:ApplicationDiscovery DomainName="opapp.example.com">
+    <mhp:ApplicationList>)";
+    for (int i = 0; i < numApps; i++)
+    {
+        std::string id = std::to_string(i + 1);
+        xml += R"(
+      <mhp:Application>
+        <mhp:appName Language="eng">Operator application )" + id + R"(</mhp:appName>
+        <mhp:appName Language="deu">Betreiberanwendung )" + id + R"(</mhp:appName>
+        <mhp:applicationIdentifier>
+          <mhp:orgId>12345</mhp:orgId>
+          <mhp:appId>)" + id + R"(</mhp:appId>
+        </mhp:applicationIdentifier>
+        <mhp:applicationDescriptor>
+          <mhp:type>
+            <mhp:OtherApp>application/vnd.hbbtv.opapp.pkg</mhp:OtherApp>
+          </mhp:type>
+          <mhp:controlCode>AUTOSTART</mhp:controlCode>
+          <mhp:visibility>VISIBLE_ALL</mhp:visibility>
+          <mhp:serviceBound>false</mhp:serviceBound>
+          <mhp:priority>1</mhp:priority>
+          <mhp:version>)" + id + R"(</mhp:version>
+          <mhp:mhpVersion>
+            <mhp:profile>0</mhp:profile>
+            <mhp:versionMajor>1</mhp:versionMajor>
+            <mhp:versionMinor>7</mhp:versionMinor>
+            <mhp:versionMicro>1</mhp:versionMicro>
+          </mhp:mhpVersion>
+          <mhp:ParentalRating Scheme="dvb-si" Region="GBR">12</mhp:ParentalRating>
+          <mhp:GraphicsConstraints>
+            <mhp:GraphicsConfiguration>urn:hbbtv:graphics:resolution:1920x1080</mhp:GraphicsConfiguration>
+          </mhp:GraphicsConstraints>
+        </mhp:applicationDescriptor>
+        <mhp:applicationUsageDescriptor>
+          <mhp:ApplicationUsage>urn:hbbtv:opapp:privileged:2017</mhp:ApplicationUsage>
+        </mhp:applicationUsageDescriptor>
+        <mhp:applicationBoundary>
+          <mhp:BoundaryExtension>https://cdn.opapp.example.com/</mhp:BoundaryExtension>
+        </mhp:applicationBoundary>
+        <mhp:applicationTransport xsi:type="mhp:HTTPTransportType">
+          <mhp:URLBase>https://opapp.example.com/apps/)" + id + R"(/</mhp:URLBase>
+          <mhp:URLExtension>v1/</mhp:URLExtension>
+        </mhp:applicationTransport>
+        <mhp:applicationLocation>index.html</mhp:applicationLocation>
+      </mhp:Application>)";
+    }
+    xml += R"(
+    </mhp:ApplicationList>
+  </mhp:ApplicationDiscovery>
+</mhp:ServiceDiscovery>)";
+    return xml;
+}
+
+template <typename Parser>
+void BM_ParseAit(benchmark::State& state)
+{
+    const std::string xml = BuildXmlAit(static_cast<int>(state.range(0)));
+    Parser parser;
+
+    for (auto _ : state) {
+        auto ait = parser.ParseAit(xml.data(), xml.size());
+        benchmark::DoNotOptimize(ait);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * xml.size());
+}
+
+/**
+ * Document tree with xmlReadMemory
+ */
+BENCHMARK_TEMPLATE(BM_ParseAit, orb::XmlParser)->Arg(1)->Arg(8)->Arg(32);
+
+/**
+ * Streaming with SAX2 callbacks
+ */
+BENCHMARK_TEMPLATE(BM_ParseAit, orb::XmlStreamParser)->Arg(1)->Arg(8)->Arg(32);
+
+} // namespace
@@ -26,6 +26,7 @@
 #include <cstring>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <errno.h>
 
 #include "log.h"
@@ -425,29 +426,65 @@ std::string Utils::StrGetUrlOrigin(const std::string &url)
  * @param url
  * @param appUri
  * @param appBoundaries
- * @param num_boundaries
  * @return
  */
 bool Utils::CheckBoundaries(const std::string &url, const std::string &appUri,
     const std::vector<std::string> &appBoundaries)
 {
-    bool retval;
-    std::string origin1 = Utils::StrGetUrlOrigin(url);
-    std::string origin2 = Utils::StrGetUrlOrigin(appUri);
-    retval = Utils::CompareUrls(origin1, origin2);
-    if (!retval)
+    return OriginSet(appUri, appBoundaries).Contains(url);
+}
+
+/**
+ *
+ * @param appUri
+ * @param appBoundaries
+ */
+Utils::OriginSet::OriginSet(const std::string &appUri,
+    const std::vector<std::string> &appBoundaries)
+{
+    m_origins.reserve(appBoundaries.size() + 1);
+    Add(appUri);
+    for (const auto &app_boundary : appBoundaries)
     {
-        for (const auto & app_boundary : appBoundaries)
-        {
-            origin2 = Utils::StrGetUrlOrigin(app_boundary);
-            retval = Utils::CompareUrls(origin1, origin2);
-            if (retval)
-            {
-                break;
-            }
-        }
+        Add(app_boundary);
+    }
+}
+
+/**
+ * Returns true if url has the origin of the app URI or one of the boundaries
+ * @param url
+ * @return
+ */
+bool Utils::OriginSet::Contains(const std::string &url) const
+{
+    std::string origin = NormalizedOrigin(url);
+    return !origin.empty() && m_origins.count(origin) > 0;
+}
+
+/**
+ * Returns the origin of url as compared by CompareUrls (without trailing '/' or whitespace),
+ * or an empty string if it has none
+ * @param url
+ * @return
+ */
+std::string Utils::OriginSet::NormalizedOrigin(const std::string &url)
+{
+    std::string origin = StrGetUrlOrigin(url);
+    origin.erase(origin.find_last_not_of(" \t\n\r\f\v/") + 1);
+    return origin;
+}
+
+/**
+ *
+ * @param url
+ */
+void Utils::OriginSet::Add(const std::string &url)
+{
+    std::string origin = NormalizedOrigin(url);
+    if (!origin.empty())
+    {
+        m_origins.insert(std::move(origin));
     }
-    return retval;
 }
 
 /**
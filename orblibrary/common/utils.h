@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <unordered_set>
 
 #include <functional>
 #include <chrono>
@@ -147,6 +148,39 @@ public:
     static bool CheckBoundaries(const std::string &url, const std::string& appUri, const
         std::vector<std::string>& appBoundaries);
 
+    /**
+     * The origins of an application URI and its boundaries, compiled once so that checking a URL
+     * against them is one origin parse and one lookup. Matches as CheckBoundaries does.
+     */
+    class OriginSet {
+public:
+        OriginSet() = default;
+
+        /**
+         *
+         * @param appUri
+         * @param appBoundaries
+         */
+        OriginSet(const std::string &appUri, const std::vector<std::string> &appBoundaries);
+
+        /**
+         * Returns true if url has the origin of the app URI or one of the boundaries
+         * @param url
+         * @return
+         */
+        bool Contains(const std::string &url) const;
+
+private:
+        /**
+         * Returns the origin of url as compared by CompareUrls, or an empty string if it has none
+         */
+        static std::string NormalizedOrigin(const std::string &url);
+
+        void Add(const std::string &url);
+
+        std::unordered_set<std::string> m_origins;
+    };
+
     /**
      *
      * @param base
@@ -24,6 +24,7 @@
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <string>
+#include <vector>
 
 #include "log.h"
 
@@ -55,7 +56,7 @@ static inline int u8(uint8_t val) { return static_cast<int>(val); }
 
 std::unique_ptr<IXmlParser> IXmlParser::create()
 {
-    return std::make_unique<XmlParser>();
+    return std::make_unique<XmlStreamParser>();
 }
 
 /**
@@ -63,7 +64,7 @@ std::unique_ptr<IXmlParser> IXmlParser::create()
  * @param dptr
  * @return
  */
-static uint32_t XmlParseInt(xmlChar *dptr)
+static uint32_t XmlParseInt(const xmlChar *dptr)
 {
     uint32_t num = 0;
     while (*dptr >= '0' && *dptr <= '9')
@@ -79,7 +80,7 @@ static uint32_t XmlParseInt(xmlChar *dptr)
  * @param dptr
  * @return
  */
-static uint32_t XmlParseHex(xmlChar *dptr, uint8_t nibbles)
+static uint32_t XmlParseHex(const xmlChar *dptr, uint8_t nibbles)
 {
     uint32_t num = 0;
     while (nibbles--)
@@ -261,6 +262,16 @@ static void XmlAllocApplication(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
     app_ptr->numTransports = numTransports;
 }
 
+/**
+ *
+ * @param dptr ISO 639-2 language code
+ * @return
+ */
+static uint32_t XmlParseLangCode(const xmlChar *dptr)
+{
+    return (*dptr << 16u) + (*(dptr + 1) << 8u) + *(dptr + 2);
+}
+
 /**
  *
  * @param node
@@ -282,7 +293,7 @@ static void XmlParseAppName(xmlNodePtr node, Ait::S_APP_NAME_DESC *app_name)
         dptr = NODE_PROPERTY(node, (const xmlChar *)"Language");
         if (dptr)
         {
-            app_name->names[index].langCode = (*dptr << 16u) + (*(dptr + 1) << 8u) + *(dptr + 2);
+            app_name->names[index].langCode = XmlParseLangCode(dptr);
             NODE_PROP_FREE(dptr)
         }
         NODE_CONTENT_GET(node, dptr);
@@ -349,15 +360,13 @@ static void XmlParseAppUsage(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
 
 /**
  *
- * @param node
+ * @param dptr
  * @return
  */
-static Ait::E_AIT_APP_CONTROL XmlGetContentEnumControl(xmlNodePtr node)
+static Ait::E_AIT_APP_CONTROL XmlParseEnumControl(const xmlChar *dptr)
 {
-    xmlChar *dptr;
     Ait::E_AIT_APP_CONTROL result = Ait::APP_CTL_UNKNOWN;
 
-    NODE_CONTENT_GET(node, dptr);
     if (dptr != nullptr)
     {
         if (xmlStrEqual(dptr, (const xmlChar *)"AUTOSTART"))
@@ -392,7 +401,6 @@ static Ait::E_AIT_APP_CONTROL XmlGetContentEnumControl(xmlNodePtr node)
         {
             result = Ait::APP_CTL_PB_AUTO;
         }
-        NODE_CONTENT_RELEASE();
     }
 
     return result;
@@ -403,12 +411,30 @@ static Ait::E_AIT_APP_CONTROL XmlGetContentEnumControl(xmlNodePtr node)
  * @param node
  * @return
  */
-static uint8_t XmlGetContentVisibility(xmlNodePtr node)
+static Ait::E_AIT_APP_CONTROL XmlGetContentEnumControl(xmlNodePtr node)
 {
     xmlChar *dptr;
-    uint8_t visibility = Ait::NOT_VISIBLE_ALL;
+    Ait::E_AIT_APP_CONTROL result = Ait::APP_CTL_UNKNOWN;
 
     NODE_CONTENT_GET(node, dptr);
+    if (dptr != nullptr)
+    {
+        result = XmlParseEnumControl(dptr);
+        NODE_CONTENT_RELEASE();
+    }
+
+    return result;
+}
+
+/**
+ *
+ * @param dptr
+ * @return
+ */
+static uint8_t XmlParseVisibility(const xmlChar *dptr)
+{
+    uint8_t visibility = Ait::NOT_VISIBLE_ALL;
+
     if (dptr)
     {
         if (xmlStrEqual(dptr, (const xmlChar *)"VISIBLE_ALL"))
@@ -423,12 +449,98 @@ static uint8_t XmlGetContentVisibility(xmlNodePtr node)
         {
             visibility = Ait::NOT_VISIBLE_USERS;
         }
+    }
+
+    return visibility;
+}
+
+/**
+ *
+ * @param node
+ * @return
+ */
+static uint8_t XmlGetContentVisibility(xmlNodePtr node)
+{
+    xmlChar *dptr;
+    uint8_t visibility = Ait::NOT_VISIBLE_ALL;
+
+    NODE_CONTENT_GET(node, dptr);
+    if (dptr)
+    {
+        visibility = XmlParseVisibility(dptr);
         NODE_CONTENT_RELEASE();
     }
 
     return visibility;
 }
 
+/**
+ * Set the application type from an OtherApp or DvbApp element
+ * @param name element name
+ * @param dptr element content
+ * @param app_ptr
+ */
+static void XmlParseAppTypeValue(const xmlChar *name, const xmlChar *dptr,
+    Ait::S_AIT_APP_DESC *app_ptr)
+{
+    if (dptr == nullptr)
+    {
+        return;
+    }
+    if (xmlStrEqual(name, (const xmlChar *)"OtherApp"))
+    {
+        /* Recognise mime type for hbbtv and opapp */
+        if (xmlStrEqual(dptr, (const xmlChar *)"application/vnd.hbbtv.xhtml+xml"))
+        {
+            app_ptr->xmlType = Ait::XML_TYP_OTHER;
+        }
+        else if (xmlStrEqual(dptr, (const xmlChar *)"application/vnd.hbbtv.opapp.pkg"))
+        {
+            // Once complete, there is a further check for the Specific or Privileged type
+            app_ptr->xmlType = Ait::XML_TYP_OPAPP;
+        }
+    }
+    else if (xmlStrEqual(name, (const xmlChar *)"DvbApp"))
+    {
+        if (xmlStrEqual(dptr, (const xmlChar *)"DVB-J"))
+        {
+            app_ptr->xmlType = Ait::XML_TYP_DVB_J;
+        }
+        else if (xmlStrEqual(dptr, (const xmlChar *)"DVB-HTML"))
+        {
+            app_ptr->xmlType = Ait::XML_TYP_DVB_HTML;
+        }
+    }
+}
+
+/**
+ *
+ * @param dptr GraphicsConfiguration content
+ * @return Vertical resolution, or 0 if not recognised
+ */
+static uint16_t XmlParseGraphicsConfiguration(const xmlChar *dptr)
+{
+    uint16_t resolution = 0;
+
+    if (dptr)
+    {
+        if (xmlStrEqual(dptr, (const xmlChar *)"urn:hbbtv:graphics:resolution:1920x1080"))
+        {
+            resolution = 1080;
+        }
+        else if (xmlStrEqual(dptr, (const xmlChar *)"urn:hbbtv:graphics:resolution:3840x2160"))
+        {
+            resolution = 2160;
+        }
+        else if (xmlStrEqual(dptr, (const xmlChar *)"urn:hbbtv:graphics:resolution:7680x4320"))
+        {
+            resolution = 4320;
+        }
+    }
+
+    return resolution;
+}
+
 /**
  *
  * @param node
@@ -436,7 +548,6 @@ static uint8_t XmlGetContentVisibility(xmlNodePtr node)
  */
 static void XmlParseAppDescType(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
 {
-    const xmlChar *cptr;
     xmlChar *dptr;
 
     node = node->xmlChildrenNode;
@@ -444,40 +555,11 @@ static void XmlParseAppDescType(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
     {
         if (node->type == XML_ELEMENT_NODE)
         {
-            cptr = node->name;
-            if (xmlStrEqual(cptr, (const xmlChar *)"OtherApp"))
-            {
-                NODE_CONTENT_GET(node, dptr);
-                if (dptr)
-                {
-                    /* Recognise mime type for hbbtv and opapp */
-                    if (xmlStrEqual(dptr, (const xmlChar *)"application/vnd.hbbtv.xhtml+xml"))
-                    {
-                        app_ptr->xmlType = Ait::XML_TYP_OTHER;
-                    }
-                    else if (xmlStrEqual(dptr, (const xmlChar *)"application/vnd.hbbtv.opapp.pkg"))
-                    {
-                        // Once complete, there is a further check for the Specific or Privileged type
-                        app_ptr->xmlType = Ait::XML_TYP_OPAPP;
-                    }
-                    NODE_CONTENT_RELEASE();
-                }
-            }
-            else if (xmlStrEqual(cptr, (const xmlChar *)"DvbApp"))
+            NODE_CONTENT_GET(node, dptr);
+            if (dptr)
             {
-                NODE_CONTENT_GET(node, dptr);
-                if (dptr)
-                {
-                    if (xmlStrEqual(dptr, (const xmlChar *)"DVB-J"))
-                    {
-                        app_ptr->xmlType = Ait::XML_TYP_DVB_J;
-                    }
-                    else if (xmlStrEqual(dptr, (const xmlChar *)"DVB-HTML"))
-                    {
-                        app_ptr->xmlType = Ait::XML_TYP_DVB_HTML;
-                    }
-                    NODE_CONTENT_RELEASE();
-                }
+                XmlParseAppTypeValue(node->name, dptr, app_ptr);
+                NODE_CONTENT_RELEASE();
             }
         }
         node = node->next;
@@ -492,7 +574,7 @@ static void XmlParseAppDescType(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
 static void XmlParseAppDescProfile(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
 {
     const xmlChar *cptr;
-    Ait::S_APP_PROFILE appProfile;
+    Ait::S_APP_PROFILE appProfile = {};
 
     node = node->xmlChildrenNode;
     while (node != nullptr)
@@ -535,6 +617,7 @@ static void XmlParseAppDescGraphics(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_pt
 {
     const xmlChar *cptr;
     xmlChar *dptr;
+    uint16_t resolution;
 
     node = node->xmlChildrenNode;
     app_ptr->graphicsConstraints.push_back(720);
@@ -548,20 +631,10 @@ static void XmlParseAppDescGraphics(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_pt
                 NODE_CONTENT_GET(node, dptr);
                 if (dptr)
                 {
-                    if (xmlStrEqual(dptr, (const
-                                           xmlChar *)"urn:hbbtv:graphics:resolution:1920x1080"))
-                    {
-                        app_ptr->graphicsConstraints.push_back(1080);
-                    }
-                    else if (xmlStrEqual(dptr, (const
-                                                xmlChar *)"urn:hbbtv:graphics:resolution:3840x2160"))
-                    {
-                        app_ptr->graphicsConstraints.push_back(2160);
-                    }
-                    else if (xmlStrEqual(dptr, (const
-                                                xmlChar *)"urn:hbbtv:graphics:resolution:7680x4320"))
+                    resolution = XmlParseGraphicsConfiguration(dptr);
+                    if (resolution != 0)
                     {
-                        app_ptr->graphicsConstraints.push_back(4320);
+                        app_ptr->graphicsConstraints.push_back(resolution);
                     }
                     NODE_CONTENT_RELEASE();
                 }
@@ -720,18 +793,13 @@ static void XmlParseDvbTriplet(xmlNodePtr node, Utils::S_DVB_TRIPLET *dvb)
 
 /**
  *
- * @param node
- * @param trns
+ * @param dptr applicationTransport type attribute
+ * @return Protocol ID, or 0 if not recognised
  */
-static void XmlParseAppTransport(xmlNodePtr node, Ait::S_TRANSPORT_PROTOCOL_DESC *trns)
+static uint16_t XmlParseTransportType(const xmlChar *dptr)
 {
-    const xmlChar *cptr;
-    xmlChar *dptr;
     uint16_t protocolId = 0;
-    uint8_t i, freeIndex;
-    Ait::S_TRANSPORT_PROTOCOL_DESC *trns_ptr;
 
-    dptr = NODE_PROPERTY(node, (const xmlChar *)"type");
     if (dptr)
     {
         if (xmlStrEqual(dptr, (const xmlChar *)"mhp:HTTPTransportType"))
@@ -742,9 +810,22 @@ static void XmlParseAppTransport(xmlNodePtr node, Ait::S_TRANSPORT_PROTOCOL_DESC
         {
             protocolId = Ait::PROTOCOL_OBJECT_CAROUSEL;
         }
-        NODE_PROP_FREE(dptr)
     }
 
+    return protocolId;
+}
+
+/**
+ * Find the slot for a new transport protocol
+ * @param trns transport array of the application
+ * @param protocolId
+ * @return The slot to fill, or nullptr if the protocol was already parsed or there is no room
+ */
+static Ait::S_TRANSPORT_PROTOCOL_DESC* XmlAllocTransport(Ait::S_TRANSPORT_PROTOCOL_DESC *trns,
+    uint16_t protocolId)
+{
+    uint8_t i, freeIndex;
+
     freeIndex = Ait::MAX_NUM_PROTOCOLS;
     for (i = 0; i < Ait::MAX_NUM_PROTOCOLS; i++)
     {
@@ -758,17 +839,43 @@ static void XmlParseAppTransport(xmlNodePtr node, Ait::S_TRANSPORT_PROTOCOL_DESC
             freeIndex = i;
         }
     }
+    if (i < Ait::MAX_NUM_PROTOCOLS)
+    {
+        LOG(DEBUG) << "protocol " << protocolId << " already parsed for this app, skipping";
+        return nullptr;
+    }
     if (freeIndex == Ait::MAX_NUM_PROTOCOLS)
     {
         LOG(ERROR) << "No free slots for this protocol: " << protocolId;
-        i = Ait::MAX_NUM_PROTOCOLS;
+        return nullptr;
     }
 
-    if (i >= Ait::MAX_NUM_PROTOCOLS)
+    trns[freeIndex].protocolId = protocolId;
+    return &trns[freeIndex];
+}
+
+/**
+ *
+ * @param node
+ * @param trns
+ */
+static void XmlParseAppTransport(xmlNodePtr node, Ait::S_TRANSPORT_PROTOCOL_DESC *trns)
+{
+    const xmlChar *cptr;
+    xmlChar *dptr;
+    uint16_t protocolId = 0;
+    Ait::S_TRANSPORT_PROTOCOL_DESC *trns_ptr;
+
+    dptr = NODE_PROPERTY(node, (const xmlChar *)"type");
+    if (dptr)
     {
-        trns_ptr = &(trns[freeIndex]);
-        trns_ptr->protocolId = protocolId;
+        protocolId = XmlParseTransportType(dptr);
+        NODE_PROP_FREE(dptr)
+    }
 
+    trns_ptr = XmlAllocTransport(trns, protocolId);
+    if (trns_ptr != nullptr)
+    {
         node = node->xmlChildrenNode;
         switch (protocolId)
         {
@@ -847,10 +954,6 @@ static void XmlParseAppTransport(xmlNodePtr node, Ait::S_TRANSPORT_PROTOCOL_DESC
 
         trns_ptr->failedToLoad = false;
     }
-    else
-    {
-        LOG(DEBUG) << "protocol " << protocolId << " already parsed for this app, skipping";
-    }
 }
 
 /**
@@ -871,6 +974,26 @@ static void XmlParseAppLocation(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
     }
 }
 
+/**
+ * For OpApp, check the ApplicationUsage against the OtherApp type
+ * @param app_ptr
+ */
+static void XmlCheckOpAppUsage(Ait::S_AIT_APP_DESC *app_ptr)
+{
+    if (app_ptr->xmlType == Ait::XML_TYP_OPAPP)
+    {
+        if (app_ptr->appUsage == "urn:hbbtv:opapp:specific:2017")
+        {
+            app_ptr->xmlType = 0x81; // See TS 103606 Table 8
+        }
+        else if (app_ptr->appUsage != "urn:hbbtv:opapp:privileged:2017")
+        {
+            // Sanity check that it was set. Just report and move on.
+            LOG(ERROR) << "OpApp ApplicationUsage does not match the OpApp type: " << app_ptr->appUsage;
+        }
+    }
+}
+
 /**
  *
  * @param node
@@ -925,19 +1048,7 @@ static void XmlParseApplication(xmlNodePtr node, Ait::S_AIT_APP_DESC *app_ptr)
         node = node->next;
     }
 
-    // For OpApp, check the ApplicationUsage against the OtherApp type
-    if (app_ptr->xmlType == Ait::XML_TYP_OPAPP)
-    {
-        if (app_ptr->appUsage == "urn:hbbtv:opapp:specific:2017")
-        {
-            app_ptr->xmlType = 0x81; // See TS 103606 Table 8
-        }
-        else if (app_ptr->appUsage != "urn:hbbtv:opapp:privileged:2017")
-        {
-            // Sanity check that it was set. Just report and move on.
-            LOG(ERROR) << "OpApp ApplicationUsage does not match the OpApp type: " << app_ptr->appUsage;
-        }
-    }
+    XmlCheckOpAppUsage(app_ptr);
 }
 
 /**
@@ -1075,6 +1186,717 @@ std::unique_ptr<Ait::S_AIT_TABLE> XmlParser::ParseAit(const char *content, uint3
     return aitTable;
 }
 
+/**
+ * SAX2 handler for XmlStreamParser. Each open element is given a context from its name and its
+ * parent's context, and the table is filled as elements start and end. Like NODE_CONTENT_GET,
+ * only the first child node of an element is taken as its content.
+ */
+class XmlAitSaxHandler
+{
+public:
+    explicit XmlAitSaxHandler(Ait::S_AIT_TABLE *ait_table) :
+        m_ait(ait_table)
+    {
+        m_stack.reserve(16);
+    }
+
+    bool FoundRoot() const
+    {
+        return m_foundRoot;
+    }
+
+    static void StartElement(void *ctx, const xmlChar *localname, const xmlChar *prefix,
+        const xmlChar *URI, int nb_namespaces, const xmlChar **namespaces, int nb_attributes,
+        int nb_defaulted, const xmlChar **attributes);
+    static void EndElement(void *ctx, const xmlChar *localname, const xmlChar *prefix,
+        const xmlChar *URI);
+    static void Characters(void *ctx, const xmlChar *ch, int len);
+    static void CData(void *ctx, const xmlChar *value, int len);
+    static void Comment(void *ctx, const xmlChar *value);
+    static void ProcessingInstruction(void *ctx, const xmlChar *target, const xmlChar *data);
+
+private:
+    enum Context : uint8_t
+    {
+        CTX_IGNORE,
+        CTX_ROOT,
+        CTX_DISCOVERY,
+        CTX_LIST,
+        CTX_APPLICATION,
+        CTX_APP_NAME,
+        CTX_APP_IDENTIFIER,
+        CTX_ORG_ID,
+        CTX_APP_ID,
+        CTX_DESCRIPTOR,
+        CTX_TYPE,
+        CTX_TYPE_VALUE,
+        CTX_CONTROL_CODE,
+        CTX_VISIBILITY,
+        CTX_SERVICE_BOUND,
+        CTX_PRIORITY,
+        CTX_VERSION,
+        CTX_MHP_VERSION,
+        CTX_PROFILE,
+        CTX_VERSION_MAJOR,
+        CTX_VERSION_MINOR,
+        CTX_VERSION_MICRO,
+        CTX_PARENTAL_RATING,
+        CTX_GRAPHICS,
+        CTX_GRAPHICS_CONFIGURATION,
+        CTX_USAGE,
+        CTX_APPLICATION_USAGE,
+        CTX_BOUNDARY,
+        CTX_BOUNDARY_EXTENSION,
+        CTX_TRANSPORT_HTTP,
+        CTX_URL_BASE,
+        CTX_URL_EXTENSION,
+        CTX_TRANSPORT_OC,
+        CTX_LOCATION,
+    };
+
+    // Progress of the first child node of the innermost element, which is its content
+    enum ContentState : uint8_t
+    {
+        CONTENT_NONE, // No child yet
+        CONTENT_TEXT, // First child is text, more may follow
+        CONTENT_CDATA, // First child is CDATA, more may follow
+        CONTENT_DONE, // First child is complete
+        CONTENT_ELEMENT, // First child is an element, so there is no content
+    };
+
+    struct Element
+    {
+        Context context;
+        ContentState content;
+        const xmlChar *name; // Interned by the parser
+        size_t start; // Offset of the content in m_content
+    };
+
+    const xmlChar* GetAttribute(int nb_attributes, const xmlChar **attributes, const char *name);
+    Context ChildContext(Context parent, const xmlChar *name);
+    void Start(Context context, int nb_attributes, const xmlChar **attributes);
+    void End(const Element &element);
+    void AppendContent(ContentState type, const xmlChar *value, int len);
+    void SetContent(const xmlChar *value);
+
+    Ait::S_AIT_TABLE *m_ait;
+    Ait::S_AIT_APP_DESC *m_app = nullptr;
+    Ait::S_TRANSPORT_PROTOCOL_DESC *m_transport = nullptr;
+    uint8_t m_numLangs = 0;
+    size_t m_nameIndex = 0;
+    std::vector<Element> m_stack;
+    std::string m_content; // Content of the open elements, reused so that it does not allocate
+    std::string m_attribute;
+    bool m_foundRoot = false;
+};
+
+/**
+ * Get an attribute from the array passed to startElementNs, which holds five pointers per
+ * attribute: localname, prefix, URI, value and end of value. The value is not null terminated.
+ * @return A copy of the value, valid until the next call, or nullptr if absent or empty
+ */
+const xmlChar* XmlAitSaxHandler::GetAttribute(int nb_attributes, const xmlChar **attributes,
+    const char *name)
+{
+    for (int i = 0; i < nb_attributes; i++, attributes += 5)
+    {
+        if (xmlStrEqual(attributes[0], (const xmlChar *)name))
+        {
+            if (attributes[4] == attributes[3])
+            {
+                return nullptr;
+            }
+            m_attribute.assign(reinterpret_cast<const char *>(attributes[3]),
+                attributes[4] - attributes[3]);
+            return reinterpret_cast<const xmlChar *>(m_attribute.c_str());
+        }
+    }
+    return nullptr;
+}
+
+XmlAitSaxHandler::Context XmlAitSaxHandler::ChildContext(Context parent, const xmlChar *name)
+{
+    switch (parent)
+    {
+        case CTX_ROOT:
+            return xmlStrEqual(name, (const xmlChar *)"ApplicationDiscovery") ? CTX_DISCOVERY :
+                   CTX_IGNORE;
+        case CTX_DISCOVERY:
+            return xmlStrEqual(name, (const xmlChar *)"ApplicationList") ? CTX_LIST : CTX_IGNORE;
+        case CTX_LIST:
+            return xmlStrEqual(name, (const xmlChar *)"Application") ? CTX_APPLICATION :
+                   CTX_IGNORE;
+        case CTX_APPLICATION:
+            if (xmlStrEqual(name, (const xmlChar *)"appName"))
+            {
+                return CTX_APP_NAME;
+            }
+            if (!xmlStrncmp(name, (const xmlChar *)"application", 11))
+            {
+                name += 11; // Skip "application" prefix
+                if (xmlStrEqual(name, (const xmlChar *)"Identifier"))
+                {
+                    return CTX_APP_IDENTIFIER;
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"Descriptor"))
+                {
+                    return CTX_DESCRIPTOR;
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"UsageDescriptor"))
+                {
+                    return CTX_USAGE;
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"Boundary"))
+                {
+                    return CTX_BOUNDARY;
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"Transport"))
+                {
+                    return CTX_TRANSPORT_HTTP; // Refined by Start() from the type attribute
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"Location"))
+                {
+                    return CTX_LOCATION;
+                }
+                return CTX_IGNORE;
+            }
+            return xmlStrEqual(name, (const xmlChar *)"GraphicsConstraints") ? CTX_GRAPHICS :
+                   CTX_IGNORE;
+        case CTX_APP_IDENTIFIER:
+            if (xmlStrEqual(name, (const xmlChar *)"orgId"))
+            {
+                return CTX_ORG_ID;
+            }
+            return xmlStrEqual(name, (const xmlChar *)"appId") ? CTX_APP_ID : CTX_IGNORE;
+        case CTX_DESCRIPTOR:
+            if (xmlStrEqual(name, (const xmlChar *)"type"))
+            {
+                return CTX_TYPE;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"controlCode"))
+            {
+                return CTX_CONTROL_CODE;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"visibility"))
+            {
+                return CTX_VISIBILITY;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"serviceBound"))
+            {
+                return CTX_SERVICE_BOUND;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"priority"))
+            {
+                return CTX_PRIORITY;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"version"))
+            {
+                return CTX_VERSION;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"mhpVersion"))
+            {
+                return CTX_MHP_VERSION;
+            }
+            if (xmlStrEqual(name, (const xmlChar *)"ParentalRating"))
+            {
+                return CTX_PARENTAL_RATING;
+            }
+            return xmlStrEqual(name, (const xmlChar *)"GraphicsConstraints") ? CTX_GRAPHICS :
+                   CTX_IGNORE;
+        case CTX_TYPE:
+            return CTX_TYPE_VALUE;
+        case CTX_MHP_VERSION:
+            if (xmlStrEqual(name, (const xmlChar *)"profile"))
+            {
+                return CTX_PROFILE;
+            }
+            if (!xmlStrncmp(name, (const xmlChar *)"versionM", 8))
+            {
+                name += 8;
+                if (xmlStrEqual(name, (const xmlChar *)"ajor"))
+                {
+                    return CTX_VERSION_MAJOR;
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"inor"))
+                {
+                    return CTX_VERSION_MINOR;
+                }
+                if (xmlStrEqual(name, (const xmlChar *)"icro"))
+                {
+                    return CTX_VERSION_MICRO;
+                }
+            }
+            return CTX_IGNORE;
+        case CTX_GRAPHICS:
+            return xmlStrEqual(name, (const xmlChar *)"GraphicsConfiguration") ?
+                   CTX_GRAPHICS_CONFIGURATION : CTX_IGNORE;
+        case CTX_USAGE:
+            return xmlStrEqual(name, (const xmlChar *)"ApplicationUsage") ?
+                   CTX_APPLICATION_USAGE : CTX_IGNORE;
+        case CTX_BOUNDARY:
+            return xmlStrEqual(name, (const xmlChar *)"BoundaryExtension") ?
+                   CTX_BOUNDARY_EXTENSION : CTX_IGNORE;
+        case CTX_TRANSPORT_HTTP:
+            // See TS 102 809, section 5.4.4.20
+            if (xmlStrEqual(name, (const xmlChar *)"URLBase"))
+            {
+                return CTX_URL_BASE;
+            }
+            return xmlStrEqual(name, (const xmlChar *)"URLExtension") ? CTX_URL_EXTENSION :
+                   CTX_IGNORE;
+        default:
+            // Includes CTX_TRANSPORT_OC, whose children are handled in StartElement()
+            return CTX_IGNORE;
+    }
+}
+
+void XmlAitSaxHandler::Start(Context context, int nb_attributes, const xmlChar **attributes)
+{
+    const xmlChar *dptr;
+
+    switch (context)
+    {
+        case CTX_APPLICATION:
+            m_ait->appArray.emplace_back();
+            m_app = &m_ait->appArray.back();
+            m_numLangs = 0;
+            break;
+
+        case CTX_APP_NAME:
+        {
+            // As XmlParseAppName, except the names grow as appName elements are found. Entries
+            // past the number of appName elements with content are removed by End().
+            Ait::S_APP_NAME_DESC *app_name = &m_app->appName;
+            for (m_nameIndex = 0; m_nameIndex < app_name->names.size(); m_nameIndex++)
+            {
+                if (!app_name->names[m_nameIndex].langCode)
+                {
+                    break;
+                }
+            }
+            if (m_nameIndex == app_name->names.size())
+            {
+                app_name->names.emplace_back();
+            }
+            dptr = GetAttribute(nb_attributes, attributes, "Language");
+            if (dptr)
+            {
+                app_name->names[m_nameIndex].langCode = XmlParseLangCode(dptr);
+            }
+            break;
+        }
+
+        case CTX_DESCRIPTOR:
+            /* TS 102809, sec 5.4.4.4 states that service_bound default is true */
+            m_app->appDesc.serviceBound = true;
+            break;
+
+        case CTX_MHP_VERSION:
+            m_app->appDesc.appProfiles.push_back({});
+            break;
+
+        case CTX_PARENTAL_RATING:
+        {
+            Ait::S_APP_PARENTAL_RATING pr;
+
+            dptr = GetAttribute(nb_attributes, attributes, "Scheme");
+            if (dptr)
+            {
+                pr.scheme = std::string(reinterpret_cast<const char *>(dptr), xmlStrlen(dptr));
+            }
+            dptr = GetAttribute(nb_attributes, attributes, "Region");
+            if (dptr)
+            {
+                pr.region = std::string(reinterpret_cast<const char *>(dptr), xmlStrlen(dptr));
+            }
+            pr.value = 0;
+            m_app->parentalRatings.push_back(pr);
+            break;
+        }
+
+        case CTX_GRAPHICS:
+            m_app->graphicsConstraints.push_back(720);
+            break;
+
+        default:;
+    }
+}
+
+void XmlAitSaxHandler::End(const Element &element)
+{
+    // Content of children has been removed, so the element's content runs to the end
+    const char *text = m_content.c_str() + element.start;
+    const xmlChar *dptr = nullptr;
+    if (element.content != CONTENT_NONE && element.content != CONTENT_ELEMENT)
+    {
+        dptr = reinterpret_cast<const xmlChar *>(text);
+    }
+
+    switch (element.context)
+    {
+        case CTX_APPLICATION:
+            m_app->appName.numLangs = m_numLangs;
+            m_app->appName.names.resize(m_numLangs);
+            XmlCheckOpAppUsage(m_app);
+            m_app = nullptr;
+            break;
+
+        case CTX_APP_NAME:
+            if (dptr)
+            {
+                m_app->appName.names[m_nameIndex].name = text;
+                m_numLangs++;
+            }
+            break;
+
+        case CTX_ORG_ID:
+            m_app->orgId = dptr ? XmlParseInt(dptr) : 0;
+            break;
+
+        case CTX_APP_ID:
+            m_app->appId = (uint16_t)(dptr ? XmlParseInt(dptr) : 0);
+            break;
+
+        case CTX_TYPE_VALUE:
+            XmlParseAppTypeValue(element.name, dptr, m_app);
+            break;
+
+        case CTX_CONTROL_CODE:
+            m_app->controlCode = (uint8_t)XmlParseEnumControl(dptr);
+            break;
+
+        case CTX_VISIBILITY:
+            m_app->appDesc.visibility = XmlParseVisibility(dptr);
+            break;
+
+        case CTX_SERVICE_BOUND:
+            m_app->appDesc.serviceBound = dptr && xmlStrEqual(dptr, (const xmlChar *)"true");
+            break;
+
+        case CTX_PRIORITY:
+            m_app->appDesc.priority = (uint8_t)(dptr ? XmlParseHex(dptr, 2) : 0);
+            break;
+
+        case CTX_VERSION:
+            // OpApp specific version is stored as uint32_t
+            m_app->xmlVersion = dptr ? XmlParseInt(dptr) : 0;
+            break;
+
+        case CTX_PROFILE:
+            m_app->appDesc.appProfiles.back().appProfile = (uint16_t)(dptr ? XmlParseHex(dptr, 4) : 0);
+            break;
+
+        case CTX_VERSION_MAJOR:
+            m_app->appDesc.appProfiles.back().versionMajor = (uint8_t)(dptr ? XmlParseHex(dptr, 2) : 0);
+            break;
+
+        case CTX_VERSION_MINOR:
+            m_app->appDesc.appProfiles.back().versionMinor = (uint8_t)(dptr ? XmlParseHex(dptr, 2) : 0);
+            break;
+
+        case CTX_VERSION_MICRO:
+            m_app->appDesc.appProfiles.back().versionMicro = (uint8_t)(dptr ? XmlParseHex(dptr, 2) : 0);
+            break;
+
+        case CTX_PARENTAL_RATING:
+            m_app->parentalRatings.back().value = (uint8_t)(dptr ? XmlParseInt(dptr) : 0);
+            break;
+
+        case CTX_GRAPHICS_CONFIGURATION:
+        {
+            uint16_t resolution = XmlParseGraphicsConfiguration(dptr);
+            if (resolution != 0)
+            {
+                m_app->graphicsConstraints.push_back(resolution);
+            }
+            break;
+        }
+
+        case CTX_APPLICATION_USAGE:
+            m_app->appUsage = dptr ? text : "";
+            break;
+
+        case CTX_BOUNDARY_EXTENSION:
+            if (dptr)
+            {
+                LOG(DEBUG) << "additional boundary: \"" << text << "\"";
+                m_app->boundaries.emplace_back(text);
+            }
+            break;
+
+        case CTX_TRANSPORT_HTTP:
+        case CTX_TRANSPORT_OC:
+            m_transport->failedToLoad = false;
+            m_transport = nullptr;
+            break;
+
+        case CTX_URL_BASE:
+            if (dptr)
+            {
+                m_transport->url.baseUrl = text;
+            }
+            break;
+
+        case CTX_URL_EXTENSION:
+            if (dptr)
+            {
+                m_transport->url.extensionUrls.emplace_back(text);
+            }
+            break;
+
+        case CTX_LOCATION:
+            if (dptr)
+            {
+                m_app->location = text;
+                LOG(DEBUG) << "location: " << m_app->location;
+            }
+            break;
+
+        default:;
+    }
+}
+
+void XmlAitSaxHandler::StartElement(void *ctx, const xmlChar *localname, const xmlChar *prefix,
+    const xmlChar *URI, int nb_namespaces, const xmlChar **namespaces, int nb_attributes,
+    int nb_defaulted, const xmlChar **attributes)
+{
+    XmlAitSaxHandler *handler = static_cast<XmlAitSaxHandler *>(ctx);
+    Context context;
+    const xmlChar *dptr;
+
+    if (handler->m_stack.empty())
+    {
+        context = handler->m_foundRoot ? CTX_IGNORE : CTX_ROOT;
+        handler->m_foundRoot = true;
+    }
+    else
+    {
+        Element &parent = handler->m_stack.back();
+        if (parent.content == CONTENT_NONE)
+        {
+            parent.content = CONTENT_ELEMENT;
+        }
+        else if (parent.content != CONTENT_ELEMENT)
+        {
+            parent.content = CONTENT_DONE;
+        }
+        context = handler->ChildContext(parent.context, localname);
+
+        if (context == CTX_TRANSPORT_HTTP)
+        {
+            uint16_t protocolId = XmlParseTransportType(
+                handler->GetAttribute(nb_attributes, attributes, "type"));
+            handler->m_app->numTransports++;
+            handler->m_transport = XmlAllocTransport(handler->m_app->transportArray, protocolId);
+            if (handler->m_transport == nullptr)
+            {
+                context = CTX_IGNORE;
+            }
+            else if (protocolId == Ait::PROTOCOL_OBJECT_CAROUSEL)
+            {
+                context = CTX_TRANSPORT_OC;
+            }
+        }
+        else if (parent.context == CTX_TRANSPORT_OC)
+        {
+            // See TS 102 809, section 5.4.4.21
+            if (xmlStrEqual(localname, (const xmlChar *)"DvbTriplet"))
+            {
+                Utils::S_DVB_TRIPLET *dvb = &handler->m_transport->oc.dvb;
+                dptr = handler->GetAttribute(nb_attributes, attributes, "OrigNetId");
+                if (dptr)
+                {
+                    dvb->originalNetworkId = (uint16_t)XmlParseInt(dptr);
+                }
+                dptr = handler->GetAttribute(nb_attributes, attributes, "TSId");
+                if (dptr)
+                {
+                    dvb->transportStreamId = (uint16_t)XmlParseInt(dptr);
+                }
+                dptr = handler->GetAttribute(nb_attributes, attributes, "ServiceId");
+                if (dptr)
+                {
+                    dvb->serviceId = (uint16_t)XmlParseInt(dptr);
+                }
+                handler->m_transport->oc.remoteConnection = true;
+            }
+            else if (xmlStrEqual(localname, (const xmlChar *)"ComponentTag"))
+            {
+                // spec says this element MUST be present: minOccurs="1" maxOccurs="1"
+                dptr = handler->GetAttribute(nb_attributes, attributes, "ComponentTag");
+                if (dptr)
+                {
+                    handler->m_transport->oc.componentTag = (uint8_t)XmlParseHex(dptr, 2);
+                    LOG(DEBUG) << "ComponentTag=" << std::hex << u8(handler->m_transport->oc.componentTag);
+                }
+                else
+                {
+                    LOG(ERROR) << "No ComponentTag attr";
+                }
+            }
+        }
+    }
+
+    if (context != CTX_IGNORE)
+    {
+        handler->Start(context, nb_attributes, attributes);
+    }
+    handler->m_stack.push_back({context, CONTENT_NONE, localname, handler->m_content.size()});
+}
+
+void XmlAitSaxHandler::EndElement(void *ctx, const xmlChar *localname, const xmlChar *prefix,
+    const xmlChar *URI)
+{
+    XmlAitSaxHandler *handler = static_cast<XmlAitSaxHandler *>(ctx);
+
+    if (handler->m_stack.empty())
+    {
+        return;
+    }
+    Element element = handler->m_stack.back();
+    handler->m_stack.pop_back();
+    if (element.context != CTX_IGNORE)
+    {
+        handler->End(element);
+    }
+    handler->m_content.resize(element.start);
+}
+
+void XmlAitSaxHandler::AppendContent(ContentState type, const xmlChar *value, int len)
+{
+    if (m_stack.empty())
+    {
+        return;
+    }
+    Element &element = m_stack.back();
+    if (element.context == CTX_IGNORE)
+    {
+        return;
+    }
+    if (element.content == CONTENT_NONE)
+    {
+        element.content = type;
+        m_content.append(reinterpret_cast<const char *>(value), len);
+    }
+    else if (element.content == type)
+    {
+        // Parts of the same node
+        m_content.append(reinterpret_cast<const char *>(value), len);
+    }
+    else if (element.content != CONTENT_ELEMENT)
+    {
+        element.content = CONTENT_DONE;
+    }
+}
+
+void XmlAitSaxHandler::SetContent(const xmlChar *value)
+{
+    if (m_stack.empty())
+    {
+        return;
+    }
+    Element &element = m_stack.back();
+    if (element.context == CTX_IGNORE)
+    {
+        return;
+    }
+    if (element.content == CONTENT_NONE)
+    {
+        if (value)
+        {
+            m_content.append(reinterpret_cast<const char *>(value));
+        }
+        element.content = CONTENT_DONE;
+    }
+    else if (element.content != CONTENT_ELEMENT)
+    {
+        element.content = CONTENT_DONE;
+    }
+}
+
+void XmlAitSaxHandler::Characters(void *ctx, const xmlChar *ch, int len)
+{
+    static_cast<XmlAitSaxHandler *>(ctx)->AppendContent(CONTENT_TEXT, ch, len);
+}
+
+void XmlAitSaxHandler::CData(void *ctx, const xmlChar *value, int len)
+{
+    static_cast<XmlAitSaxHandler *>(ctx)->AppendContent(CONTENT_CDATA, value, len);
+}
+
+void XmlAitSaxHandler::Comment(void *ctx, const xmlChar *value)
+{
+    static_cast<XmlAitSaxHandler *>(ctx)->SetContent(value);
+}
+
+void XmlAitSaxHandler::ProcessingInstruction(void *ctx, const xmlChar *target,
+    const xmlChar *data)
+{
+    static_cast<XmlAitSaxHandler *>(ctx)->SetContent(data);
+}
+
+/**
+ * Parse Xml data as specified in TS 102 809 section 5.4, without building a document tree
+ * @param content pointer to Xml data
+ * @param length length of Xml data
+ * @return AIT table data in same format as generated from DVB broadcast data
+ */
+std::unique_ptr<Ait::S_AIT_TABLE> XmlStreamParser::ParseAit(const char *content, uint32_t length)
+{
+    std::unique_ptr<Ait::S_AIT_TABLE> aitTable = std::make_unique<Ait::S_AIT_TABLE>();
+    xmlParserCtxtPtr ctxt;
+    xmlSAXHandler sax = {};
+    bool wellFormed;
+    int options = 0;
+
+#ifdef RDK
+    options = XML_PARSE_RECOVER;
+#endif
+
+    LOG(DEBUG) << "len=" << length;
+    XmlAitSaxHandler handler(aitTable.get());
+    sax.initialized = XML_SAX2_MAGIC;
+    sax.startElementNs = XmlAitSaxHandler::StartElement;
+    sax.endElementNs = XmlAitSaxHandler::EndElement;
+    sax.characters = XmlAitSaxHandler::Characters;
+    sax.ignorableWhitespace = XmlAitSaxHandler::Characters;
+    sax.cdataBlock = XmlAitSaxHandler::CData;
+    sax.comment = XmlAitSaxHandler::Comment;
+    sax.processingInstruction = XmlAitSaxHandler::ProcessingInstruction;
+
+    ctxt = xmlCreatePushParserCtxt(&sax, &handler, nullptr, 0, "noname.xml");
+    if (ctxt == nullptr)
+    {
+        LOG(ERROR) << "Failed to create parser";
+        return nullptr;
+    }
+    xmlCtxtUseOptions(ctxt, options);
+    xmlParseChunk(ctxt, content, length, 1);
+    wellFormed = ctxt->wellFormed;
+    xmlFreeParserCtxt(ctxt);
+
+    if (!wellFormed)
+    {
+        if (options & XML_PARSE_RECOVER)
+        {
+            // Use the tree parser so that what is recovered from the document is unchanged
+            LOG(INFO) << "Malformed document, parsing with the tree parser";
+            return XmlParser().ParseAit(content, length);
+        }
+        LOG(ERROR) << "Failed to parse document!!";
+        return nullptr;
+    }
+    if (!handler.FoundRoot())
+    {
+        LOG(ERROR) << "Empty document";
+        return nullptr;
+    }
+
+    aitTable->appType = Ait::APP_TYP_XML;
+    aitTable->numApps = (uint8_t)aitTable->appArray.size();
+    return aitTable;
+}
+
 #if 0 // TODO(C++-ize)
 
 /**
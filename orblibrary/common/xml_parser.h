@@ -75,6 +75,22 @@ public:
 #endif
 };
 
+/**
+ * Parses the XML AIT with libxml2 SAX2 callbacks instead of building a document tree. The result
+ * is the same as XmlParser::ParseAit, but the table is filled as the document is read and nothing
+ * is allocated per node. Only ParseAit is supported.
+ */
+class XmlStreamParser : public IXmlParser {
+public:
+    /**
+     * Parse Xml data as specified in TS 102 809 section 5.4
+     * @param content pointer to Xml data
+     * @param length length of Xml data
+     * @return AIT table data in same format as generated from DVB broadcast data
+     */
+    std::unique_ptr<Ait::S_AIT_TABLE> ParseAit(const char *content, uint32_t length) override;
+};
+
 } // namespace orb
 
 #endif  /* XML_PARSE_H */
@@ -19,11 +19,14 @@
 #include <cstdint>
 #include <string>
 #include <functional>
+#include <utility>
 
 namespace orb
 {
 
 using onPageLoadedSuccess = std::function<void()>;
+using onClientResponse = std::function<void(uint32_t requestId, std::string jsonResponse)>;
+using onOrbResponse = std::function<void(std::string jsonResponse)>;
 
 class IOrbBrowser
 {
@@ -59,6 +62,23 @@ public:
      */
     virtual std::string sendRequestToClient(std::string jsonRequest) = 0;
 
+    /**
+     * Send Orb message request to external client (DVB stack) without waiting for the response.
+     * The request has the same form as for sendRequestToClient. The callback must be called
+     * exactly once with the request ID and the response, from any thread.
+     *
+     * The default implementation calls sendRequestToClient and so completes before it returns.
+     * Clients that can answer requests concurrently should override it.
+     *
+     * @param requestId ID that identifies the request in the callback
+     * @param jsonRequest String representation of the JSON request
+     * @param callback Called when the response is available
+     */
+    virtual void sendRequestToClientAsync(uint32_t requestId, std::string jsonRequest, onClientResponse callback)
+    {
+        callback(requestId, sendRequestToClient(std::move(jsonRequest)));
+    }
+
     /**
      * Dispatch Orb message to javascript
      */
@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
 
 #include "IOrbBrowser.h"
 #include "OrbConstants.h"
@@ -25,6 +27,8 @@ namespace orb
 
 class ComponentBase;
 class IAppMgrInterface;
+class ClientRequestDispatcher;
+class RequestEnvelope;
 
 // These must match the Java values
 enum class KeyType {
@@ -73,6 +77,18 @@ public:
      */
     std::string handleOrbRequest(std::string request);
 
+    /** Handle ORB request from Javascript without blocking on the Live TV client.
+     * The request and response have the same form as for handleOrbRequest.
+     *
+     * Requests handled by the moderator itself complete before this returns. Requests that are
+     * passed to the Live TV client are pipelined with other requests in flight, and the callback
+     * is called on the thread that the client completes them on.
+     *
+     * @param request String representation of the JSON request
+     * @param callback Called once with the string representation of the JSON response
+     */
+    void handleOrbRequestAsync(std::string request, onOrbResponse callback);
+
     // Notify that URL has been loaded for an application
     void notifyApplicationPageChanged(std::string url);
 
@@ -91,13 +107,55 @@ public:
 
     static KeyType ClassifyKey(const uint16_t keyCode);
 
+    // --------------------------------------------------------
+    // Metrics and tracing
+    // --------------------------------------------------------
+
+    /**
+     * Get the counters and latency histograms recorded by the ORB library in this process.
+     *
+     * @param prometheusText true for the Prometheus text format, false for JSON
+     * @return The metrics
+     */
+    static std::string getMetrics(bool prometheusText = false);
+
+    /**
+     * Write the counters and latency histograms recorded by the ORB library in this process to a
+     * local file.
+     *
+     * @param path The file path
+     * @param prometheusText true for the Prometheus text format, false for JSON
+     * @return true if the file was written
+     */
+    static bool dumpMetrics(const std::string& path, bool prometheusText = false);
+
+    /**
+     * Write the trace spans recorded by the ORB library in this process to a local file, in the
+     * Chrome trace event JSON format. Spans are only recorded in builds with orb_enable_tracing.
+     *
+     * @param path The file path
+     * @return true if the file was written
+     */
+    static bool dumpTrace(const std::string& path);
+
 private:
+    /**
+     * Parse a request and execute it if a moderator component handles it.
+     *
+     * @param request Receives the parsed request
+     * @param jsonRqst String representation of the JSON request
+     * @param response Receives the response if the request was handled
+     * @return true if the response is complete, false if the request is for the Live TV client
+     */
+    bool routeOrbRequest(RequestEnvelope &request, std::string jsonRqst, std::string &response);
+
     //Todo: use smart pointers to manager IOrbBrowser
     IOrbBrowser *mOrbBrowser;
     std::unique_ptr<ComponentBase> mNetwork;
     std::unique_ptr<ComponentBase> mMediaSynchroniser;
     std::unique_ptr<IAppMgrInterface> mAppMgrInterface;
     std::unique_ptr<ComponentBase> mDrm;
+    std::unique_ptr<ClientRequestDispatcher> mClientDispatcher;
 }; // class Moderator
 
 } // namespace orb
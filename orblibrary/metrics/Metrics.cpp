@@ -0,0 +1,226 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Metrics.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace orb
+{
+namespace metrics
+{
+
+namespace
+{
+
+const double QUANTILES[] = {0.5, 0.9, 0.99};
+const char *QUANTILE_NAMES[] = {"p50", "p90", "p99"};
+
+int HighestBit(uint64_t value)
+{
+    return 63 - __builtin_clzll(value);
+}
+
+} // namespace
+
+uint64_t Counter::Value() const
+{
+    uint64_t total = 0;
+    for (const Stripe &stripe : mStripes)
+    {
+        total += stripe.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t Counter::ThreadStripe()
+{
+    static std::atomic<size_t> nextStripe{0};
+    thread_local const size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) %
+        COUNTER_STRIPES;
+    return stripe;
+}
+
+void Histogram::Record(uint64_t value)
+{
+    mBuckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = mMax.load(std::memory_order_relaxed);
+    while (value > max &&
+           !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+size_t Histogram::BucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKETS)
+    {
+        return value;
+    }
+    const int exponent = HighestBit(value);
+    const uint64_t subBucket = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t Histogram::BucketUpperBound(size_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+    const int shift = index / SUB_BUCKETS - 1;
+    const uint64_t lowerBound = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lowerBound + ((uint64_t(1) << shift) - 1);
+}
+
+Histogram::Snapshot Histogram::GetSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.buckets.resize(BUCKETS);
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        snapshot.buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum = mSum.load(std::memory_order_relaxed);
+    snapshot.max = mMax.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+uint64_t Histogram::Snapshot::ValueAtQuantile(double quantile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(quantile * count + 0.5);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            uint64_t upperBound = BucketUpperBound(i);
+            return upperBound < max ? upperBound : max;
+        }
+    }
+    return max;
+}
+
+Registry& Registry::Instance()
+{
+    static Registry registry;
+    return registry;
+}
+
+Counter& Registry::GetCounter(const std::string &name, const std::string &help)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry<Counter> &entry = mCounters[name];
+    if (!entry.metric)
+    {
+        entry.help = help;
+        entry.metric.reset(new Counter());
+    }
+    return *entry.metric;
+}
+
+Histogram& Registry::GetHistogram(const std::string &name, const std::string &help)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry<Histogram> &entry = mHistograms[name];
+    if (!entry.metric)
+    {
+        entry.help = help;
+        entry.metric.reset(new Histogram());
+    }
+    return *entry.metric;
+}
+
+std::string Registry::Write(Format format) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::ostringstream out;
+    if (format == Format::JSON)
+    {
+        out << "{\"counters\":{";
+        const char *separator = "";
+        for (const auto &counter : mCounters)
+        {
+            out << separator << "\"" << counter.first << "\":" << counter.second.metric->Value();
+            separator = ",";
+        }
+        out << "},\"histograms\":{";
+        separator = "";
+        for (const auto &histogram : mHistograms)
+        {
+            Histogram::Snapshot snapshot = histogram.second.metric->GetSnapshot();
+            out << separator << "\"" << histogram.first << "\":{\"count\":" << snapshot.count <<
+                ",\"sum\":" << snapshot.sum << ",\"max\":" << snapshot.max;
+            for (size_t i = 0; i < sizeof(QUANTILES) / sizeof(QUANTILES[0]); i++)
+            {
+                out << ",\"" << QUANTILE_NAMES[i] << "\":" << snapshot.ValueAtQuantile(
+                    QUANTILES[i]);
+            }
+            out << "}";
+            separator = ",";
+        }
+        out << "}}";
+    }
+    else
+    {
+        for (const auto &counter : mCounters)
+        {
+            out << "# HELP " << counter.first << " " << counter.second.help << "\n";
+            out << "# TYPE " << counter.first << " counter\n";
+            out << counter.first << " " << counter.second.metric->Value() << "\n";
+        }
+        for (const auto &histogram : mHistograms)
+        {
+            Histogram::Snapshot snapshot = histogram.second.metric->GetSnapshot();
+            out << "# HELP " << histogram.first << " " << histogram.second.help << "\n";
+            out << "# TYPE " << histogram.first << " summary\n";
+            for (double quantile : QUANTILES)
+            {
+                out << histogram.first << "{quantile=\"" << quantile << "\"} " <<
+                    snapshot.ValueAtQuantile(quantile) << "\n";
+            }
+            out << histogram.first << "_sum " << snapshot.sum << "\n";
+            out << histogram.first << "_count " << snapshot.count << "\n";
+        }
+    }
+    return out.str();
+}
+
+bool Registry::WriteToFile(const std::string &path, Format format) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file << Write(format);
+    return static_cast<bool>(file);
+}
+
+} // namespace metrics
+} // namespace orb
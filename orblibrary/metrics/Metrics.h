@@ -0,0 +1,252 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Process-wide counters and latency histograms
+ *
+ * Metrics are registered by name with the Registry and kept for the life of the process, so an
+ * instrumentation point looks its metric up once and keeps the reference:
+ *
+ *     static metrics::Counter &sections = metrics::Registry::Instance().GetCounter(
+ *         "orb_ait_sections_total", "AIT sections received");
+ *     sections.Increment();
+ *
+ * Recording takes a relaxed atomic add and does not lock. Counters are striped across cache
+ * lines so that threads recording at the same time do not contend.
+ */
+
+#ifndef ORB_METRICS_H
+#define ORB_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace orb
+{
+namespace metrics
+{
+
+// Number of cache line stripes in each counter. Each thread uses one stripe.
+constexpr size_t COUNTER_STRIPES = 16;
+
+/**
+ * Monotonic count of events.
+ */
+class Counter
+{
+public:
+    Counter() = default;
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    /**
+     * Add to the counter.
+     *
+     * @param n The number of events.
+     */
+    void Increment(uint64_t n = 1)
+    {
+        mStripes[ThreadStripe()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The total of all increments.
+     */
+    uint64_t Value() const;
+
+    /**
+     * @return The stripe used by the calling thread.
+     */
+    static size_t ThreadStripe();
+
+private:
+    struct alignas(64) Stripe
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Stripe, COUNTER_STRIPES> mStripes;
+};
+
+/**
+ * Distribution of values, such as latencies in microseconds, with log-linear buckets in the
+ * style of HdrHistogram. Values are exact below 8 and otherwise within 12.5%.
+ */
+class Histogram
+{
+public:
+    // Each power of two is divided into 2^SUB_BUCKET_BITS buckets
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    struct Snapshot
+    {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+        std::vector<uint64_t> buckets;
+
+        /**
+         * @param quantile The quantile, from 0 to 1.
+         * @return The upper bound of the bucket that holds the quantile, or 0 if empty.
+         */
+        uint64_t ValueAtQuantile(double quantile) const;
+    };
+
+    Histogram() = default;
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+     * Record a value.
+     *
+     * @param value The value.
+     */
+    void Record(uint64_t value);
+
+    /**
+     * @return A copy of the histogram. Values recorded while the copy is taken may be missing
+     * from some of its fields.
+     */
+    Snapshot GetSnapshot() const;
+
+    /**
+     * @param value A value.
+     * @return The index of the bucket that holds the value.
+     */
+    static size_t BucketIndex(uint64_t value);
+
+    /**
+     * @param index A bucket index.
+     * @return The largest value held by the bucket.
+     */
+    static uint64_t BucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> mBuckets{};
+    std::atomic<uint64_t> mSum{0};
+    std::atomic<uint64_t> mMax{0};
+};
+
+/**
+ * Records the time from construction to destruction in microseconds.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Histogram &histogram)
+        : mHistogram(histogram), mStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        mHistogram.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - mStart).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram &mHistogram;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+/**
+ * The process-wide set of metrics, by name.
+ */
+class Registry
+{
+public:
+    enum class Format
+    {
+        JSON,
+        PROMETHEUS_TEXT
+    };
+
+    /**
+     * @return The registry for the process.
+     */
+    static Registry& Instance();
+
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    /**
+     * Get a counter, registering it on first use.
+     *
+     * @param name The metric name, in Prometheus style, e.g. orb_ait_sections_total.
+     * @param help A description of the metric.
+     * @return The counter, valid for the life of the registry.
+     */
+    Counter& GetCounter(const std::string &name, const std::string &help = "");
+
+    /**
+     * Get a histogram, registering it on first use.
+     *
+     * @param name The metric name, in Prometheus style with the unit as a suffix, e.g.
+     * orb_ait_section_processing_microseconds.
+     * @param help A description of the metric.
+     * @return The histogram, valid for the life of the registry.
+     */
+    Histogram& GetHistogram(const std::string &name, const std::string &help = "");
+
+    /**
+     * Write every metric as text.
+     *
+     * The JSON format is an object with a counters object of name to value and a histograms
+     * object of name to an object with count, sum, max, p50, p90 and p99 members. The
+     * Prometheus text format writes each histogram as a summary with the same quantiles.
+     *
+     * @param format The format.
+     * @return The metrics.
+     */
+    std::string Write(Format format) const;
+
+    /**
+     * Write every metric to a local file.
+     *
+     * @param path The file path.
+     * @param format The format.
+     * @return true if the file was written, otherwise false.
+     */
+    bool WriteToFile(const std::string &path, Format format) const;
+
+private:
+    template <typename Metric>
+    struct Entry
+    {
+        std::string help;
+        std::unique_ptr<Metric> metric;
+    };
+
+    mutable std::mutex mMutex;
+    std::map<std::string, Entry<Counter> > mCounters;
+    std::map<std::string, Entry<Histogram> > mHistograms;
+};
+
+} // namespace metrics
+} // namespace orb
+
+#endif // ORB_METRICS_H
@@ -0,0 +1,148 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Trace.h"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace orb
+{
+namespace metrics
+{
+
+Tracer& Tracer::Instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::ThreadBuffer& Tracer::GetThreadBuffer()
+{
+    // Held by the tracer as well, so that the events of a thread outlive it. The buffer is
+    // returned to the tracer when the thread exits.
+    struct Holder
+    {
+        std::shared_ptr<ThreadBuffer> buffer;
+        ~Holder()
+        {
+            if (buffer)
+            {
+                Tracer::Instance().ReleaseThreadBuffer(buffer);
+            }
+        }
+    };
+    thread_local Holder holder;
+    if (!holder.buffer)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFreeBuffers.empty())
+        {
+            holder.buffer = std::move(mFreeBuffers.back());
+            mFreeBuffers.pop_back();
+            // The events of the exited thread are dropped
+            std::lock_guard<std::mutex> bufferLock(holder.buffer->mutex);
+            holder.buffer->next = 0;
+        }
+        else
+        {
+            holder.buffer = std::make_shared<ThreadBuffer>();
+            holder.buffer->events.resize(TRACE_EVENTS_PER_THREAD);
+            mBuffers.push_back(holder.buffer);
+        }
+        holder.buffer->threadId = mNextThreadId++;
+    }
+    return *holder.buffer;
+}
+
+void Tracer::ReleaseThreadBuffer(const std::shared_ptr<ThreadBuffer> &buffer)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFreeBuffers.push_back(buffer);
+}
+
+void Tracer::Record(const TraceEvent &event)
+{
+    ThreadBuffer &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events[buffer.next % TRACE_EVENTS_PER_THREAD] = event;
+    buffer.next++;
+}
+
+std::string Tracer::Write() const
+{
+    const int pid = getpid();
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const char *separator = "";
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto &buffer : mBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        uint64_t first = buffer->next > TRACE_EVENTS_PER_THREAD ?
+            buffer->next - TRACE_EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < buffer->next; i++)
+        {
+            const TraceEvent &event = buffer->events[i % TRACE_EVENTS_PER_THREAD];
+            out << separator << "{\"name\":\"" << event.name << "\",\"cat\":\"orb\",\"ph\":\"" <<
+                static_cast<char>(event.phase) << "\",\"ts\":" << event.timestampUs <<
+                ",\"pid\":" << pid << ",\"tid\":" << buffer->threadId;
+            switch (event.phase)
+            {
+                case TraceEvent::Phase::COMPLETE:
+                    out << ",\"dur\":" << event.durationUs;
+                    break;
+                case TraceEvent::Phase::INSTANT:
+                    out << ",\"s\":\"t\"";
+                    break;
+                case TraceEvent::Phase::ASYNC_BEGIN:
+                case TraceEvent::Phase::ASYNC_END:
+                    out << ",\"id\":\"0x" << std::hex << event.id << std::dec << "\"";
+                    break;
+            }
+            out << "}";
+            separator = ",";
+        }
+    }
+    out << "]}";
+    return out.str();
+}
+
+bool Tracer::WriteToFile(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file << Write();
+    return static_cast<bool>(file);
+}
+
+void Tracer::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto &buffer : mBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->next = 0;
+    }
+}
+
+} // namespace metrics
+} // namespace orb
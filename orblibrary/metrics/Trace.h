@@ -0,0 +1,187 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Trace spans for the application lifecycle
+ *
+ * Events are recorded in a ring buffer for each thread and written on request in the Chrome
+ * trace event JSON format, which can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ *     ORB_TRACE_SCOPE("ApplicationManager::OnChannelChanged");
+ *     ORB_TRACE_ASYNC_BEGIN("App load", appId);
+ *     ORB_TRACE_ASYNC_END("App load", appId);
+ *
+ * The buffer of a thread that has exited is handed to the next new thread, so short-lived threads
+ * do not add a buffer each. Its events are kept until then.
+ *
+ * A scope records a span from the macro to the end of the enclosing block. An async span pairs a
+ * begin and an end with the same name and id, which may be on different threads. Names must be
+ * string literals, as only the pointer is stored.
+ *
+ * The macros compile to nothing unless ORB_TRACING is defined (GN arg orb_enable_tracing).
+ */
+
+#ifndef ORB_TRACE_H
+#define ORB_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace orb
+{
+namespace metrics
+{
+
+// Number of events kept for each thread. When full, the oldest events are overwritten.
+constexpr size_t TRACE_EVENTS_PER_THREAD = 4096;
+
+struct TraceEvent
+{
+    enum class Phase : char
+    {
+        COMPLETE = 'X',
+        INSTANT = 'i',
+        ASYNC_BEGIN = 'b',
+        ASYNC_END = 'e'
+    };
+
+    const char *name;
+    Phase phase;
+    uint64_t timestampUs;
+    uint64_t durationUs;
+    uint64_t id;
+};
+
+/**
+ * The trace events recorded by every thread in the process.
+ */
+class Tracer
+{
+public:
+    /**
+     * @return The tracer for the process.
+     */
+    static Tracer& Instance();
+
+    /**
+     * Record an event in the ring buffer of the calling thread.
+     *
+     * @param event The event.
+     */
+    void Record(const TraceEvent &event);
+
+    /**
+     * @return The events of every thread in the Chrome trace event JSON format.
+     */
+    std::string Write() const;
+
+    /**
+     * Write the events of every thread to a local file in the Chrome trace event JSON format.
+     *
+     * @param path The file path.
+     * @return true if the file was written, otherwise false.
+     */
+    bool WriteToFile(const std::string &path) const;
+
+    /**
+     * Discard the events of every thread.
+     */
+    void Clear();
+
+    /**
+     * @return Microseconds on the clock used for event timestamps.
+     */
+    static uint64_t NowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    // The buffer is only locked by its own thread and while events are written or cleared, so
+    // the lock is uncontended when recording.
+    struct ThreadBuffer
+    {
+        std::mutex mutex;
+        uint64_t threadId = 0;
+        uint64_t next = 0;
+        std::vector<TraceEvent> events;
+    };
+
+    Tracer() = default;
+    ThreadBuffer& GetThreadBuffer();
+    void ReleaseThreadBuffer(const std::shared_ptr<ThreadBuffer> &buffer);
+
+    mutable std::mutex mMutex;
+    std::vector<std::shared_ptr<ThreadBuffer> > mBuffers;
+    // Buffers of exited threads, for reuse by new threads
+    std::vector<std::shared_ptr<ThreadBuffer> > mFreeBuffers;
+    uint64_t mNextThreadId = 1;
+};
+
+/**
+ * Records a complete event from construction to destruction.
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name) : mName(name), mStartUs(Tracer::NowUs())
+    {
+    }
+
+    ~TraceSpan()
+    {
+        Tracer::Instance().Record({mName, TraceEvent::Phase::COMPLETE, mStartUs,
+                                   Tracer::NowUs() - mStartUs, 0});
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char *mName;
+    uint64_t mStartUs;
+};
+
+inline void TraceMark(const char *name, TraceEvent::Phase phase, uint64_t id)
+{
+    Tracer::Instance().Record({name, phase, Tracer::NowUs(), 0, id});
+}
+
+} // namespace metrics
+} // namespace orb
+
+#ifdef ORB_TRACING
+#define ORB_TRACE_CONCAT_(a, b) a ## b
+#define ORB_TRACE_CONCAT(a, b) ORB_TRACE_CONCAT_(a, b)
+#define ORB_TRACE_SCOPE(name) \
+    ::orb::metrics::TraceSpan ORB_TRACE_CONCAT(orbTraceSpan, __LINE__)(name)
+#define ORB_TRACE_INSTANT(name) \
+    ::orb::metrics::TraceMark(name, ::orb::metrics::TraceEvent::Phase::INSTANT, 0)
+#define ORB_TRACE_ASYNC_BEGIN(name, id) \
+    ::orb::metrics::TraceMark(name, ::orb::metrics::TraceEvent::Phase::ASYNC_BEGIN, id)
+#define ORB_TRACE_ASYNC_END(name, id) \
+    ::orb::metrics::TraceMark(name, ::orb::metrics::TraceEvent::Phase::ASYNC_END, id)
+#else
+#define ORB_TRACE_SCOPE(name) do { } while (0)
+#define ORB_TRACE_INSTANT(name) do { } while (0)
+#define ORB_TRACE_ASYNC_BEGIN(name, id) do { } while (0)
+#define ORB_TRACE_ASYNC_END(name, id) do { } while (0)
+#endif
+
+#endif // ORB_TRACE_H
@@ -22,6 +22,8 @@
 #include "app_mgr/application_manager.h"
 #include "xml_parser.h"
 #include "log.h"
+#include "Trace.h"
+#include "JsonResponseWriter.h"
 
 
 using namespace std;
@@ -34,16 +36,9 @@ const int KEY_OTHERS_MAX = 0x416; // temporary value based on v1.0
 
 static std::string buildJsonResponse(const std::string &value)
 {
-    std::unique_ptr<IJson> json = IJson::create();
-    json->setString("result", value);
-    return json->toString();
-}
-
-static std::string buildJsonResponse(const int value)
-{
-    std::unique_ptr<IJson> json = IJson::create();
-    json->setInteger("result", value);
-    return json->toString();
+    std::string response;
+    JsonResponseWriter(response).WriteResult(value);
+    return response;
 }
 
 AppMgrInterface::AppMgrInterface(IOrbBrowser* browser, ApplicationType apptype)
@@ -59,19 +54,21 @@ AppMgrInterface::AppMgrInterface(IOrbBrowser* browser, ApplicationType apptype)
 string AppMgrInterface::executeRequest(const string& method, const string& token, const IJson& params)
 {
     std::lock_guard<std::mutex> lock(mMutex);
-    string response = buildJsonResponse(""); // default response
+    // The response is written into a buffer that is reused by every request
+    JsonResponseWriter response(mResponseBuffer);
+    response.WriteResult(""); // default response
 
     auto &appMgr = ApplicationManager::instance();
     int appId = params.getInteger("id");
 
     // Helper function to check if the request is supported for OpApp
-    auto isOpAppRequest = [this](const string& method, std::string& json_response) -> bool {
+    auto isOpAppRequest = [this](const string& method, JsonResponseWriter& json_response) -> bool {
         // The response is built by the isOpAppRequest function if the method is not supported for OpApp
         // and returned to the caller
         if (mAppType != ApplicationType::APP_TYPE_OPAPP) {
             std::string errorMessage = "method [" + method + "] is only supported for OpApp";
             LOGE(errorMessage);
-            json_response = buildJsonResponse(errorMessage);
+            json_response.WriteResult(errorMessage);
             return false;
         }
         return true;
@@ -84,7 +81,7 @@ string AppMgrInterface::executeRequest(const string& method, const string& token
           appId, params.getString("url"), params.getBool("runAsOpApp"));
 
         LOGI("app type: " << mAppType << " new AppID" << newAppId);
-        response = buildJsonResponse(newAppId);
+        response.WriteResult(newAppId);
     }
     else if (method == MANAGER_DESTROY_APP)
     {
@@ -105,18 +102,16 @@ string AppMgrInterface::executeRequest(const string& method, const string& token
     {
         // Get running app IDs from ApplicationManager
         std::vector<int> runningAppIds = appMgr.GetRunningAppIds();
-        std::unique_ptr<IJson> json = IJson::create();
-        json->setArray("result", runningAppIds);
-        response = json->toString();
+        response.WriteResult(runningAppIds);
         LOGI("getRunningAppIds: returned " << runningAppIds.size() << " app IDs");
     }
     else if (method == MANAGER_GET_APP_URL)
     {
-        response = buildJsonResponse(appMgr.GetApplicationUrl(appId));
+        response.WriteResult(appMgr.GetApplicationUrl(appId));
     }
     else if (method == MANAGER_GET_APP_SCHEME)
     {
-        response = buildJsonResponse(appMgr.GetApplicationScheme(appId));
+        response.WriteResult(appMgr.GetApplicationScheme(appId));
     }
     else if (method == MANAGER_SET_KEY_VALUE)
     {
@@ -135,70 +130,68 @@ string AppMgrInterface::executeRequest(const string& method, const string& token
     }
     else if (method == MANAGER_GET_KEY_VALUES)
     {
-        response = buildJsonResponse(appMgr.GetKeySetMask(appId));
+        response.WriteResult(appMgr.GetKeySetMask(appId));
     }
     else if (method == MANAGER_GET_OKEY_VALUES)
     {
         std::vector<uint16_t> otherkeys = appMgr.GetOtherKeyValues(appId);
         // Create JSON response with array of other key values
-        std::unique_ptr<IJson> json = IJson::create();
-        json->setArray("result", otherkeys);
-        response = json->toString();
+        response.WriteResult(otherkeys);
         LOGI("return: " << otherkeys.size() << " other key values");
     }
     else if (method == MANAGER_GET_KEY_MAX_VAL)
     {
         int maxval = KEY_SET_RED | KEY_SET_GREEN | KEY_SET_YELLOW | KEY_SET_BLUE |
                 KEY_SET_NAVIGATION | KEY_SET_VCR | KEY_SET_NUMERIC;
-        response = buildJsonResponse(maxval);
+        response.WriteResult(maxval);
     }
     else if (method == MANAGER_GET_MAX_OKEYS)
     {
-        response = buildJsonResponse(KEY_OTHERS_MAX);
+        response.WriteResult(KEY_OTHERS_MAX);
     }
     else if (method == MANAGER_GET_KEY_ICON)
     {
-        response = buildJsonResponse("AppMgrInterface; method [" + method + "] unsupported");
+        response.WriteResult("AppMgrInterface; method [" + method + "] unsupported");
     }
     else if (method == MANAGER_GET_FREE_MEM)
     {
-        response = buildJsonResponse("AppMgrInterface; method [" + method + "] unsupported");
+        response.WriteResult("AppMgrInterface; method [" + method + "] unsupported");
     }
     else if (method == MANAGER_GET_OP_APP_STATE)
     {
         if (!isOpAppRequest(method, response)) {
-            return response;
+            return mResponseBuffer;
         }
-        response = buildJsonResponse(appMgr.GetOpAppState(appId));
+        response.WriteResult(appMgr.GetOpAppState(appId));
     }
     else if (method == MANAGER_OP_APP_REQUEST_BACKGROUND)
     {
         if (!isOpAppRequest(method, response)) {
-            return response;
+            return mResponseBuffer;
         }
-        response = buildJsonResponse(appMgr.OpAppRequestStateChange(appId, BaseApp::BACKGROUND_STATE));
+        response.WriteResult(appMgr.OpAppRequestStateChange(appId, BaseApp::BACKGROUND_STATE));
     }
     else if (method == MANAGER_OP_APP_REQUEST_FOREGROUND)
     {
         if (!isOpAppRequest(method, response)) {
-            return response;
+            return mResponseBuffer;
         }
-        response = buildJsonResponse(appMgr.OpAppRequestStateChange(appId, BaseApp::FOREGROUND_STATE));
+        response.WriteResult(appMgr.OpAppRequestStateChange(appId, BaseApp::FOREGROUND_STATE));
     }
     else if (method == MANAGER_OP_APP_REQUEST_TRANSIENT)
     {
         if (!isOpAppRequest(method, response)) {
-            return response;
+            return mResponseBuffer;
         }
-        response = buildJsonResponse(appMgr.OpAppRequestStateChange(appId, BaseApp::TRANSIENT_STATE));
+        response.WriteResult(appMgr.OpAppRequestStateChange(appId, BaseApp::TRANSIENT_STATE));
     }
     else
     {
         LOGI("Unknown method: " << method);
-        response = buildJsonResponse("AppMgrInterface; method [" + method + "] unknown");
+        response.WriteResult("AppMgrInterface; method [" + method + "] unknown");
     }
 
-    return response;
+    return mResponseBuffer;
 }
 
 void AppMgrInterface::onNetworkStatusChange(bool available) {
@@ -227,6 +220,7 @@ void AppMgrInterface::processXmlAit(const std::vector<uint8_t>& xmlait) {
 
 // ApplicationSessionCallback implementation
 void AppMgrInterface::LoadApplication(const int appId, const char *entryUrl, onPageLoadedSuccess callback) {
+    ORB_TRACE_SCOPE("IOrbBrowser::loadApplication");
     LOGI("Apptyp: " << mAppType << ", appID: " << appId << ", url: " << entryUrl);
     mOrbBrowser->loadApplication(std::to_string(appId), entryUrl, callback);
 }
@@ -234,6 +228,7 @@ void AppMgrInterface::LoadApplication(const int appId, const char *entryUrl, onP
 void AppMgrInterface::LoadApplication(
     const int appId, const char *entryUrl, int size, const std::vector<uint16_t> graphics,
     onPageLoadedSuccess callback) {
+    ORB_TRACE_SCOPE("IOrbBrowser::loadApplication");
     LOGI("Apptyp: " << mAppType << ", appID: " << appId << ", url: " << entryUrl);
     // TODO: need a different API to add extra params
     mOrbBrowser->loadApplication(std::to_string(appId), entryUrl, callback);
@@ -334,18 +329,18 @@ bool AppMgrInterface::IsRequestAllowed(string token)
 }
 
 bool AppMgrInterface::InKeySet(const uint16_t keyCode) {
-    return ApplicationManager::instance().InKeySet(
-        ApplicationManager::instance().GetRunningAppId(mAppType), keyCode);
+    return ApplicationManager::instance().InRunningAppKeySet(mAppType, keyCode);
 }
 
 // static
 KeyType AppMgrInterface::ClassifyKey(const uint16_t keyCode)
 {
-    if ((BaseApp::GetKeySetMaskForKeyCode(keyCode) != 0) || HbbTVApp::IsAllowedOtherKey(keyCode)) {
+    const KeyClass keyClass = ClassifyKeyCode(keyCode);
+    if ((keyClass.keySet != 0) || (keyClass.flags & KeyClass::ALLOWED_OTHER_KEY) != 0) {
         return KeyType::REGULAR_HBBTV;
     }
 
-    if (OpApp::IsOperatorApplicationKey(keyCode)) {
+    if ((keyClass.flags & KeyClass::OPERATOR_APPLICATION) != 0) {
         return KeyType::OPERATOR_APPLICATION;
     }
 
@@ -129,6 +129,7 @@ private:
     IOrbBrowser *mOrbBrowser;
     ApplicationType mAppType;
     mutable std::mutex mMutex;
+    std::string mResponseBuffer; // Guarded by mMutex
 
     bool IsRequestAllowed(std::string token);
 
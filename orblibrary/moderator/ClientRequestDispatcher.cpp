@@ -0,0 +1,156 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ClientRequestDispatcher.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "log.h"
+
+namespace orb
+{
+
+static const char CANCELLED_RESPONSE[] = "{\"error\": \"Request cancelled\"}";
+
+ClientRequestDispatcher::ClientRequestDispatcher(IOrbBrowser *browser, size_t maxInFlight)
+    : mState(std::make_shared<State>())
+{
+    mState->browser = browser;
+    mState->maxInFlight = std::max<size_t>(maxInFlight, 1);
+}
+
+ClientRequestDispatcher::~ClientRequestDispatcher()
+{
+    std::deque<Request> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        mState->closed = true;
+        cancelled.swap(mState->waiting);
+    }
+    for (auto &request : cancelled)
+    {
+        LOGI("Cancelling client request " << request.id);
+        request.callback(CANCELLED_RESPONSE);
+    }
+}
+
+uint32_t ClientRequestDispatcher::Send(std::string jsonRequest, onOrbResponse callback)
+{
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        id = mState->nextId++;
+        if (mState->nextId == 0)
+        {
+            mState->nextId = 1;
+        }
+        Request request{id, std::move(jsonRequest), std::move(callback)};
+        if (mState->inFlight.size() < mState->maxInFlight)
+        {
+            mState->inFlight.emplace(id, std::move(request.callback));
+            mState->ready.push_back(std::move(request));
+        }
+        else
+        {
+            mState->waiting.push_back(std::move(request));
+        }
+    }
+    SendReady(mState);
+    return id;
+}
+
+size_t ClientRequestDispatcher::GetInFlightCount() const
+{
+    std::lock_guard<std::mutex> lock(mState->mutex);
+    return mState->inFlight.size();
+}
+
+size_t ClientRequestDispatcher::GetQueuedCount() const
+{
+    std::lock_guard<std::mutex> lock(mState->mutex);
+    return mState->waiting.size();
+}
+
+void ClientRequestDispatcher::Complete(const std::weak_ptr<State> &weakState, uint32_t requestId,
+    std::string jsonResponse)
+{
+    std::shared_ptr<State> state = weakState.lock();
+    if (!state)
+    {
+        LOGI("Dropping response to client request " << requestId);
+        return;
+    }
+
+    onOrbResponse callback;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto it = state->inFlight.find(requestId);
+        if (it == state->inFlight.end())
+        {
+            LOGE("Response to unknown client request " << requestId);
+            return;
+        }
+        callback = std::move(it->second);
+        state->inFlight.erase(it);
+
+        if (!state->closed && !state->waiting.empty())
+        {
+            Request next = std::move(state->waiting.front());
+            state->waiting.pop_front();
+            state->inFlight.emplace(next.id, std::move(next.callback));
+            state->ready.push_back(std::move(next));
+        }
+    }
+
+    callback(std::move(jsonResponse));
+    SendReady(state);
+}
+
+void ClientRequestDispatcher::SendReady(const std::shared_ptr<State> &state)
+{
+    // A client that completes requests before sendRequestToClientAsync returns calls back into
+    // Complete on this thread. The requests that makes ready are sent by the loop below rather
+    // than by recursion.
+    thread_local std::vector<const State *> draining;
+    if (std::find(draining.begin(), draining.end(), state.get()) != draining.end())
+    {
+        return;
+    }
+    draining.push_back(state.get());
+
+    std::weak_ptr<State> weakState = state;
+    while (true)
+    {
+        Request request;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->ready.empty())
+            {
+                break;
+            }
+            request = std::move(state->ready.front());
+            state->ready.pop_front();
+        }
+        state->browser->sendRequestToClientAsync(request.id, std::move(request.json),
+            [weakState](uint32_t requestId, std::string jsonResponse) {
+                Complete(weakState, requestId, std::move(jsonResponse));
+            });
+    }
+
+    draining.pop_back();
+}
+
+} // namespace orb
@@ -0,0 +1,101 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CLIENT_REQUEST_DISPATCHER_H
+#define CLIENT_REQUEST_DISPATCHER_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "IOrbBrowser.h"
+
+namespace orb
+{
+
+/**
+ * Pipelines requests to the Live TV client through IOrbBrowser::sendRequestToClientAsync.
+ *
+ * Each request is given an ID and up to a fixed number of requests are in flight at once.
+ * Requests beyond that window wait in FIFO order and are sent as earlier ones complete. The
+ * response callback is called on whichever thread the client completes the request.
+ */
+class ClientRequestDispatcher
+{
+public:
+    /**
+     * @param browser The browser used to reach the client. It must outlive the dispatcher.
+     * @param maxInFlight The maximum number of requests sent to the client at once.
+     */
+    ClientRequestDispatcher(IOrbBrowser *browser, size_t maxInFlight);
+
+    /**
+     * Requests that are still waiting to be sent are completed with an error response.
+     * Responses that arrive for requests in flight after destruction are dropped.
+     */
+    ~ClientRequestDispatcher();
+
+    ClientRequestDispatcher(const ClientRequestDispatcher&) = delete;
+    ClientRequestDispatcher& operator=(const ClientRequestDispatcher&) = delete;
+
+    /**
+     * Send a request to the client, or queue it if the window is full.
+     *
+     * @param jsonRequest String representation of the JSON request
+     * @param callback Called once with the response
+     * @return The ID given to the request
+     */
+    uint32_t Send(std::string jsonRequest, onOrbResponse callback);
+
+    size_t GetInFlightCount() const;
+    size_t GetQueuedCount() const;
+
+private:
+    struct Request
+    {
+        uint32_t id;
+        std::string json;
+        onOrbResponse callback;
+    };
+
+    /**
+     * State shared with the completion callbacks given to the browser, so that a late response
+     * does not touch a destroyed dispatcher.
+     */
+    struct State
+    {
+        IOrbBrowser *browser;
+        size_t maxInFlight;
+        mutable std::mutex mutex;
+        uint32_t nextId = 1;
+        std::unordered_map<uint32_t, onOrbResponse> inFlight;
+        std::deque<Request> waiting;
+        std::deque<Request> ready;
+        bool closed = false;
+    };
+
+    static void Complete(const std::weak_ptr<State> &weakState, uint32_t requestId, std::string jsonResponse);
+    static void SendReady(const std::shared_ptr<State> &state);
+
+    std::shared_ptr<State> mState;
+}; // class ClientRequestDispatcher
+
+} // namespace orb
+
+#endif // CLIENT_REQUEST_DISPATCHER_H
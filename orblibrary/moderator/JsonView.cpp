@@ -0,0 +1,136 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "JsonView.h"
+#include "JsonUtil.h"
+
+namespace orb
+{
+JsonView::JsonView(Json::Value& json)
+    : mValue(&json)
+{
+}
+
+bool JsonView::parse(std::string jsonString)
+{
+    return JsonUtil::decodeJson(jsonString, mValue);
+}
+
+bool JsonView::hasParam(const std::string &param, const JsonType& type) const
+{
+    return JsonUtil::HasParam(*mValue, param, convertToJsonValueType(type));
+}
+
+std::string JsonView::toString() const
+{
+    return JsonUtil::convertJsonToString(*mValue);
+}
+
+int JsonView::getInteger(const std::string& key) const
+{
+    return JsonUtil::getIntegerValue(*mValue, key);
+}
+
+bool JsonView::getBool(const std::string& key) const
+{
+    return JsonUtil::getBoolValue(*mValue, key);
+}
+
+std::string JsonView::getString(const std::string& key) const
+{
+    return JsonUtil::getStringValue(*mValue, key);
+}
+
+std::unique_ptr<IJson> JsonView::getObject(const std::string& key) const
+{
+    if (!JsonUtil::HasJsonParam(*mValue, key)) {
+        return nullptr;
+    }
+    return std::make_unique<JsonView>((*mValue)[key]);
+}
+
+Json::ValueType JsonView::convertToJsonValueType(const JsonType& type) const
+{
+    switch (type) {
+        case JsonType::JSON_TYPE_STRING:
+            return Json::stringValue;
+        case JsonType::JSON_TYPE_INTEGER:
+            return Json::intValue;
+        case JsonType::JSON_TYPE_BOOLEAN:
+            return Json::booleanValue;
+        case JsonType::JSON_TYPE_ARRAY:
+            return Json::arrayValue;
+        case JsonType::JSON_TYPE_OBJECT:
+            return Json::objectValue;
+    }
+    return Json::nullValue;
+}
+
+void JsonView::setInteger(const std::string& key, const int value, const std::string& subKey)
+{
+    setValue(key, Json::Value(value), subKey);
+}
+
+void JsonView::setBool(const std::string& key, const bool value, const std::string& subKey)
+{
+    setValue(key, Json::Value(value), subKey);
+}
+
+void JsonView::setString(const std::string& key, const std::string& value, const std::string& subKey)
+{
+    setValue(key, Json::Value(value), subKey);
+}
+
+void JsonView::setValue(const std::string& key, Json::Value value, const std::string& subKey)
+{
+    if (!subKey.empty()) {
+        (*mValue)[key][subKey] = std::move(value);
+    }
+    else {
+        (*mValue)[key] = std::move(value);
+    }
+}
+
+void JsonView::setArray(const std::string& key, const std::vector<uint16_t>& array)
+{
+    setJsonArray(key, array);
+}
+
+void JsonView::setArray(const std::string& key, const std::vector<int>& array)
+{
+    setJsonArray(key, array);
+}
+
+template<typename T>
+void JsonView::setJsonArray(const std::string& key, const std::vector<T>& array)
+{
+    Json::Value jsonArray(Json::arrayValue);
+    for (const auto& item : array)
+    {
+        jsonArray.append(item);
+    }
+    (*mValue)[key] = std::move(jsonArray);
+}
+
+std::vector<uint16_t> JsonView::getUint16Array(const std::string& key) const
+{
+    std::vector<uint16_t> result;
+    for (const auto& item : JsonUtil::getIntegerArray(*mValue, key)) {
+        result.push_back(static_cast<uint16_t>(item));
+    }
+    return result;
+}
+
+} // namespace orb
@@ -0,0 +1,79 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JSONVIEW_H
+#define JSONVIEW_H
+
+#include "IJson.h"
+#include <json/json.h>
+
+namespace orb
+{
+
+/**
+ * IJson implementation over a Json::Value that is owned by someone else.
+ *
+ * No copy of the wrapped value is made, so the view must not outlive it. Setters write
+ * through to the wrapped value. getObject() returns a view of the child rather than a copy.
+ */
+class JsonView : public IJson
+{
+public:
+    explicit JsonView(Json::Value& json);
+    virtual ~JsonView() {}
+
+    JsonView(const JsonView&) = delete;
+    JsonView& operator=(const JsonView&) = delete;
+
+    bool parse(std::string jsonString) override;
+    bool hasParam(const std::string &param, const JsonType& type = JsonType::JSON_TYPE_OBJECT) const override;
+    std::string toString() const override;
+    int getInteger(const std::string& key) const override;
+    bool getBool(const std::string& key) const override;
+    std::string getString(const std::string& key) const override;
+    std::unique_ptr<IJson> getObject(const std::string& key) const override;
+    void setInteger(const std::string& key, const int value, const std::string& subKey) override;
+    void setBool(const std::string& key, const bool value, const std::string& subKey) override;
+    void setString(const std::string& key, const std::string& value, const std::string& subKey) override;
+    void setArray(const std::string& key, const std::vector<uint16_t>& array) override;
+    void setArray(const std::string& key, const std::vector<int>& array) override;
+    std::vector<uint16_t> getUint16Array(const std::string& key) const override;
+
+    /**
+     * Point the view at a different value.
+     *
+     * @param json The value to wrap. It must outlive the view.
+     */
+    void bind(Json::Value& json) { mValue = &json; }
+
+protected:
+    /**
+     * For subclasses that own the value, or holders that bind it later. bind() must be called
+     * before the view is used.
+     */
+    JsonView() = default;
+
+private:
+    Json::ValueType convertToJsonValueType(const JsonType& type) const;
+    void setValue(const std::string& key, Json::Value value, const std::string& subKey);
+    template<typename T>
+    void setJsonArray(const std::string& key, const std::vector<T>& array);
+
+private:
+    Json::Value *mValue = nullptr;
+};
+} // namespace orb
+
+#endif // JSONVIEW_H
@@ -24,7 +24,11 @@
 #include "log.h"
 #include "StringUtil.h"
 #include "IJson.h"
+#include "RequestEnvelope.h"
+#include "ClientRequestDispatcher.h"
 #include "Drm.hpp"
+#include "Metrics.h"
+#include "Trace.h"
 
 using namespace std;
 
@@ -37,12 +41,16 @@ const string COMPONENT_NETWORK = "Network";
 const string COMPONENT_MEDIA_SYNCHRONISER = "MediaSynchroniser";
 const string COMPONENT_DRM = "Drm";
 
+// Maximum number of requests passed to the Live TV client at once by handleOrbRequestAsync
+const size_t MAX_CLIENT_REQUESTS_IN_FLIGHT = 8;
+
 Moderator::Moderator(IOrbBrowser* browser, ApplicationType apptype)
     : mOrbBrowser(browser)
     , mNetwork(std::make_unique<Network>())
     , mMediaSynchroniser(std::make_unique<MediaSynchroniser>())
     , mAppMgrInterface(std::make_unique<AppMgrInterface>(browser, apptype))
     , mDrm(std::make_unique<Drm>())
+    , mClientDispatcher(std::make_unique<ClientRequestDispatcher>(browser, MAX_CLIENT_REQUESTS_IN_FLIGHT))
 {
     LOGI("HbbTV version " << ORB_HBBTV_VERSION);
 }
@@ -57,80 +65,109 @@ Moderator::Moderator(
     , mMediaSynchroniser(std::make_unique<MediaSynchroniser>())
     , mAppMgrInterface(std::move(appMgrInterface))
     , mDrm(std::move(drm))
+    , mClientDispatcher(std::make_unique<ClientRequestDispatcher>(browser, MAX_CLIENT_REQUESTS_IN_FLIGHT))
 {}
 
 Moderator::~Moderator() {}
 
 string Moderator::handleOrbRequest(string jsonRqst)
 {
-    std::unique_ptr<IJson> json = IJson::create();
-
-    if (!json->parse(jsonRqst))
+    ORB_TRACE_SCOPE("Moderator::handleOrbRequest");
+    RequestEnvelope request;
+    std::string response;
+    if (routeOrbRequest(request, std::move(jsonRqst), response))
     {
-        return "{\"error\": \"Invalid Request\"}";
+        return response;
     }
 
-    if (json->hasParam("error"))
-    {
-        LOGE("Json request reports error");
-        return "{\"error\": \"Error Request\"}";
-    }
+    LOGI("Passing request to Live TV App");
+    return mOrbBrowser->sendRequestToClient(request.TakeForwardRequest());
+}
 
-    if (!json->hasParam("method", IJson::JSON_TYPE_STRING))
+void Moderator::handleOrbRequestAsync(string jsonRqst, onOrbResponse callback)
+{
+    RequestEnvelope request;
+    std::string response;
+    if (routeOrbRequest(request, std::move(jsonRqst), response))
     {
-        LOGE("Request has no method");
-        return "{\"error\": \"No method\"}";
+        callback(std::move(response));
+        return;
     }
 
-    // add application type to params. Guard against missing params.
-    if (!json->hasParam("params", IJson::JSON_TYPE_OBJECT)) {
-        LOGE("Request has no params");
-        return "{\"error\": \"No params\"}";
+    LOGI("Passing request to Live TV App");
+    mClientDispatcher->Send(request.TakeForwardRequest(), std::move(callback));
+}
+
+bool Moderator::routeOrbRequest(RequestEnvelope &request, string jsonRqst, string &response)
+{
+    switch (request.Parse(std::move(jsonRqst)))
+    {
+        case RequestEnvelope::STATUS_OK:
+            break;
+        case RequestEnvelope::STATUS_INVALID:
+            response = "{\"error\": \"Invalid Request\"}";
+            return true;
+        case RequestEnvelope::STATUS_ERROR:
+            response = "{\"error\": \"Error Request\"}";
+            return true;
+        case RequestEnvelope::STATUS_NO_METHOD:
+            response = "{\"error\": \"No method\"}";
+            return true;
+        case RequestEnvelope::STATUS_NO_PARAMS:
+            response = "{\"error\": \"No params\"}";
+            return true;
     }
 
-    json->setInteger("params", mAppMgrInterface->GetApplicationType(), "applicationType");
+    // add application type to params
+    request.SetApplicationType(mAppMgrInterface->GetApplicationType());
 
     std::string component;
     std::string method;
-    if (!StringUtil::ResolveMethod(json->getString("method"), component, method))
+    if (!StringUtil::ResolveMethod(request.GetMethod(), component, method))
     {
-        return "{\"error\": \"Invalid method\"}";
+        response = "{\"error\": \"Invalid method\"}";
+        return true;
     }
 
-    std::unique_ptr<IJson> params = json->getObject("params");
-    std::string token = json->getString("token");
+    const IJson &params = request.GetParams();
+    std::string token = request.GetToken();
     if (component == COMPONENT_MANAGER)
     {
-        return mAppMgrInterface->executeRequest(method, token, *params);
+        response = mAppMgrInterface->executeRequest(method, token, params);
     }
     else if (component == COMPONENT_NETWORK)
     {
-        return mNetwork->executeRequest(method, token, *params);
+        response = mNetwork->executeRequest(method, token, params);
     }
     else if (component == COMPONENT_MEDIA_SYNCHRONISER)
     {
-        return mMediaSynchroniser->executeRequest(method, token, *params);
+        response = mMediaSynchroniser->executeRequest(method, token, params);
     }
     else if (component == COMPONENT_DRM)
     {
-        return mDrm->executeRequest(method, token, *params);
+        response = mDrm->executeRequest(method, token, params);
     }
-
-    LOGI("Passing request to Live TV App");
-    return mOrbBrowser->sendRequestToClient(json->toString());
+    else
+    {
+        return false;
+    }
+    return true;
 }
 
 void Moderator::notifyApplicationPageChanged(string url)
 {
+    ORB_TRACE_INSTANT("Moderator::notifyApplicationPageChanged");
     LOGI("url: " << url);
 }
 
 void Moderator::notifyApplicationLoadFailed(string url, string errorText)
 {
+    ORB_TRACE_INSTANT("Moderator::notifyApplicationLoadFailed");
     LOGI("url: " << url << " err: " << errorText);
 }
 
 bool Moderator::handleBridgeEvent(const std::string& etype, const std::string& properties) {
+    ORB_TRACE_SCOPE("Moderator::handleBridgeEvent");
     bool consumed = false;
     LOGI("etype: " << etype << " props: " << properties);
     if (etype == CHANNEL_STATUS_CHANGE) {
@@ -155,12 +192,14 @@ bool Moderator::handleBridgeEvent(const std::string& etype, const std::string& p
 
 void Moderator::processAitSection(int32_t aitPid, int32_t serviceId, const vector<uint8_t>& section)
 {
+    ORB_TRACE_SCOPE("Moderator::processAitSection");
     LOGI("pid: " << aitPid << "serviceId: " << serviceId);
     mAppMgrInterface->processAitSection(aitPid, serviceId, section);
 }
 
 void Moderator::processXmlAit(const vector<uint8_t>& xmlait)
 {
+    ORB_TRACE_SCOPE("Moderator::processXmlAit");
     LOGI("");
     mAppMgrInterface->processXmlAit(xmlait);
 }
@@ -174,4 +213,36 @@ KeyType Moderator::ClassifyKey(const uint16_t keyCode)
 {
     return AppMgrInterface::ClassifyKey(keyCode);
 }
+
+string Moderator::getMetrics(bool prometheusText)
+{
+    return metrics::Registry::Instance().Write(prometheusText ?
+        metrics::Registry::Format::PROMETHEUS_TEXT : metrics::Registry::Format::JSON);
+}
+
+bool Moderator::dumpMetrics(const string& path, bool prometheusText)
+{
+    bool written = metrics::Registry::Instance().WriteToFile(path, prometheusText ?
+        metrics::Registry::Format::PROMETHEUS_TEXT : metrics::Registry::Format::JSON);
+    if (!written)
+    {
+        LOGE("Could not write metrics to " << path);
+    }
+    return written;
+}
+
+bool Moderator::dumpTrace(const string& path)
+{
+#ifdef ORB_TRACING
+    bool written = metrics::Tracer::Instance().WriteToFile(path);
+    if (!written)
+    {
+        LOGE("Could not write trace to " << path);
+    }
+    return written;
+#else
+    LOGE("Tracing is not enabled in this build (GN arg orb_enable_tracing)");
+    return false;
+#endif
+}
 } // namespace orb
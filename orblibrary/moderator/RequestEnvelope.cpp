@@ -0,0 +1,136 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "RequestEnvelope.h"
+
+#include <memory>
+
+#include "JsonUtil.h"
+#include "log.h"
+
+namespace orb
+{
+
+static const char KEY_METHOD[] = "method";
+static const char KEY_TOKEN[] = "token";
+static const char KEY_PARAMS[] = "params";
+static const char KEY_ERROR[] = "error";
+static const char KEY_APPLICATION_TYPE[] = "applicationType";
+
+/**
+ * The reader is reused by every request handled on the same thread. It uses the same
+ * settings as JsonUtil::decodeJson.
+ */
+static Json::CharReader& GetThreadReader()
+{
+    thread_local std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+    return *reader;
+}
+
+RequestEnvelope::RequestEnvelope()
+    : mParams(mNull)
+    , mApplicationType(0)
+    , mApplicationTypeSet(false)
+    , mSpliceable(false)
+{
+}
+
+RequestEnvelope::Status RequestEnvelope::Parse(std::string request)
+{
+    mRequest = std::move(request);
+    mRoot = Json::Value();
+    mParams.bind(mNull);
+    mMethod.clear();
+    mApplicationTypeSet = false;
+    mSpliceable = false;
+
+    std::string errors;
+    const char *begin = mRequest.data();
+    if (!GetThreadReader().parse(begin, begin + mRequest.size(), &mRoot, &errors) || !mRoot.isObject())
+    {
+        LOGE("Json parsing failed: " << errors);
+        return STATUS_INVALID;
+    }
+
+    if (JsonUtil::HasParam(mRoot, KEY_ERROR, Json::objectValue))
+    {
+        LOGE("Json request reports error");
+        return STATUS_ERROR;
+    }
+
+    if (!JsonUtil::HasParam(mRoot, KEY_METHOD, Json::stringValue))
+    {
+        LOGE("Request has no method");
+        return STATUS_NO_METHOD;
+    }
+
+    if (!JsonUtil::HasParam(mRoot, KEY_PARAMS, Json::objectValue))
+    {
+        LOGE("Request has no params");
+        return STATUS_NO_PARAMS;
+    }
+
+    mMethod = mRoot[KEY_METHOD].asString();
+    Json::Value &params = mRoot[KEY_PARAMS];
+    mParams.bind(params);
+
+    // The forward request can be patched in place if the offset recorded by the parser leads
+    // to the opening brace of params and there is no existing member that would be duplicated
+    const ptrdiff_t offset = params.getOffsetStart();
+    mSpliceable = offset >= 0 && static_cast<size_t>(offset) < mRequest.size() &&
+        mRequest[offset] == '{' && !params.isMember(KEY_APPLICATION_TYPE);
+
+    return STATUS_OK;
+}
+
+std::string RequestEnvelope::GetToken() const
+{
+    return JsonUtil::getStringValue(mRoot, KEY_TOKEN);
+}
+
+void RequestEnvelope::SetApplicationType(int applicationType)
+{
+    mApplicationType = applicationType;
+    mApplicationTypeSet = true;
+    mParams.setInteger(KEY_APPLICATION_TYPE, applicationType, {});
+}
+
+std::string RequestEnvelope::TakeForwardRequest()
+{
+    if (!mApplicationTypeSet)
+    {
+        return std::move(mRequest);
+    }
+
+    if (!mSpliceable)
+    {
+        return JsonUtil::convertJsonToString(mRoot);
+    }
+
+    // The params now hold applicationType, so it is the only member if the size is 1
+    const size_t brace = static_cast<size_t>(mRoot[KEY_PARAMS].getOffsetStart());
+    const bool emptyParams = mRoot[KEY_PARAMS].size() == 1;
+    const std::string member = std::string("\"") + KEY_APPLICATION_TYPE + "\":" +
+        std::to_string(mApplicationType) + (emptyParams ? "" : ",");
+
+    std::string forward;
+    forward.reserve(mRequest.size() + member.size());
+    forward.append(mRequest, 0, brace + 1);
+    forward.append(member);
+    forward.append(mRequest, brace + 1, std::string::npos);
+    return forward;
+}
+
+} // namespace orb
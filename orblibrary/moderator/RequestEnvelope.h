@@ -0,0 +1,108 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef REQUEST_ENVELOPE_H
+#define REQUEST_ENVELOPE_H
+
+#include <string>
+#include <json/json.h>
+
+#include "JsonView.h"
+
+namespace orb
+{
+
+/**
+ * A JS bridge request of the form:
+ * {
+ *    "method": <method>
+ *    "token": <app_id>
+ *    "params": <params>
+ * }
+ *
+ * The request is parsed once. The params are exposed as a view into the parsed tree, and the
+ * original request bytes are kept so that a request which is only proxied to the Live TV client
+ * does not have to be serialised again.
+ */
+class RequestEnvelope
+{
+public:
+    enum Status
+    {
+        STATUS_OK,
+        STATUS_INVALID,
+        STATUS_ERROR,
+        STATUS_NO_METHOD,
+        STATUS_NO_PARAMS
+    };
+
+    RequestEnvelope();
+
+    RequestEnvelope(const RequestEnvelope&) = delete;
+    RequestEnvelope& operator=(const RequestEnvelope&) = delete;
+
+    /**
+     * Parse a request, replacing any previously parsed one.
+     *
+     * @param request The request bytes. Ownership is taken, no copy is made.
+     * @return STATUS_OK if the request is well formed, otherwise the reason it is not.
+     */
+    Status Parse(std::string request);
+
+    /**
+     * @return The "method" member of the request.
+     */
+    const std::string& GetMethod() const { return mMethod; }
+
+    /**
+     * @return The "token" member of the request, or an empty string if there is none.
+     */
+    std::string GetToken() const;
+
+    /**
+     * @return A view of the "params" object. Valid until the next call to Parse().
+     */
+    const IJson& GetParams() const { return mParams; }
+
+    /**
+     * Add "applicationType" to the params.
+     *
+     * @param applicationType The type of the application that sent the request.
+     */
+    void SetApplicationType(int applicationType);
+
+    /**
+     * Get the request as it should be forwarded to the Live TV client. This is the original
+     * request bytes with "applicationType" inserted at the start of the params object. The
+     * request is only re-serialised if the bytes cannot be patched in place.
+     *
+     * @return The request to forward.
+     */
+    std::string TakeForwardRequest();
+
+private:
+    std::string mRequest;
+    Json::Value mRoot;
+    Json::Value mNull;
+    JsonView mParams;
+    std::string mMethod;
+    int mApplicationType;
+    bool mApplicationTypeSet;
+    bool mSpliceable;
+}; // class RequestEnvelope
+
+} // namespace orb
+
+#endif // REQUEST_ENVELOPE_H
@@ -55,6 +55,23 @@ namespace orb
         std::unique_ptr<JsonRpcService> webSocketServer = std::make_unique<JsonRpcService>(port,endpoint,std::move(callback));
         webSocketServer->SetOpAppEnabled(appType == orb::APP_TYPE_OPAPP);
 
+        // Optionally handle requests on worker threads, so that a slow one does not hold up the
+        // others. JsonRpcCallback is stateless, so it may be called from them
+        const std::string SERVER_WORKER_THREAD_COUNT_KEY = "jsonRpcWorkerThreadCount";
+        if (JsonUtil::HasParam(result, SERVER_WORKER_THREAD_COUNT_KEY, Json::intValue))
+        {
+            webSocketServer->SetWorkerThreadCount(
+                JsonUtil::getIntegerValue(result, SERVER_WORKER_THREAD_COUNT_KEY));
+        }
+
+        // Optionally compress messages, for a server that companion devices reach over the network
+        const std::string SERVER_PERMESSAGE_DEFLATE_KEY = "jsonRpcPermessageDeflate";
+        if (JsonUtil::HasParam(result, SERVER_PERMESSAGE_DEFLATE_KEY, Json::booleanValue) &&
+            result[SERVER_PERMESSAGE_DEFLATE_KEY].asBool())
+        {
+            webSocketServer->EnablePermessageDeflate();
+        }
+
         return webSocketServer;
     }
 }
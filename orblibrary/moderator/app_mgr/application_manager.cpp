@@ -28,8 +28,11 @@
 #include <iostream>
 #include <string>
 #include <stdexcept>
+#include <thread>
 
 #include "ait.h"
+#include "Metrics.h"
+#include "Trace.h"
 #include "third_party/orb/logging/include/log.h"
 #include "utils.h"
 #include "xml_parser.h"
@@ -46,7 +49,13 @@ ApplicationManager::ApplicationManager(std::unique_ptr<IXmlParser> xmlParser) :
 {
 }
 
-ApplicationManager::~ApplicationManager() = default;
+ApplicationManager::~ApplicationManager()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_lock);
+    // Stop key checks from using the apps before they are destroyed
+    publishKeySetApp(APP_TYPE_HBBTV, nullptr);
+    publishKeySetApp(APP_TYPE_OPAPP, nullptr);
+}
 
 ApplicationManager& ApplicationManager::instance()
 {
@@ -338,6 +347,21 @@ bool ApplicationManager::InKeySet(const int appId, const uint16_t keyCode)
     return false;
 }
 
+bool ApplicationManager::InRunningAppKeySet(const ApplicationType appType, const uint16_t keyCode)
+{
+    if (appType >= APP_TYPE_MAX)
+    {
+        return false;
+    }
+    // publishKeySetApp does not reset an app while the count of this epoch is non-zero
+    std::atomic<int> &readers = m_keySetReaders[m_keySetEpoch.load() & 1];
+    readers.fetch_add(1);
+    BaseApp *app = m_keySetApps[appType].load();
+    bool result = app != nullptr && app->InKeySet(keyCode);
+    readers.fetch_sub(1, std::memory_order_release);
+    return result;
+}
+
 std::vector<uint16_t> ApplicationManager::GetOtherKeyValues(int appId)
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
@@ -421,13 +445,19 @@ std::string ApplicationManager::GetOpAppState(int appId)
 void ApplicationManager::ProcessAitSection(uint16_t aitPid, uint16_t serviceId,
     const uint8_t *sectionData, uint32_t sectionDataBytes)
 {
+    static metrics::Counter &sections = metrics::Registry::Instance().GetCounter(
+        "orb_ait_sections_total", "AIT sections received");
+    static metrics::Histogram &updateTime = metrics::Registry::Instance().GetHistogram(
+        "orb_ait_update_microseconds", "Time to apply a new or updated broadcast AIT");
+    sections.Increment();
+
     std::lock_guard<std::recursive_mutex> lock(m_lock);
 
-    LOG(INFO) << "ProcessAitSection";
+    LOG(DEBUG) << "ProcessAitSection";
 
     if (serviceId != m_currentService.serviceId)
     {
-        LOG(INFO) << "The AIT is for service " << serviceId << ", not current service " << m_currentService.serviceId << ", early out";
+        LOG(DEBUG) << "The AIT is for service " << serviceId << ", not current service " << m_currentService.serviceId << ", early out";
         return;
     }
 
@@ -443,9 +473,12 @@ void ApplicationManager::ProcessAitSection(uint16_t aitPid, uint16_t serviceId,
 
     if (!m_ait.ProcessSection(sectionData, sectionDataBytes))
     {
-        LOG(INFO) << "The AIT was not completed and/or updated, early out";
+        LOG(DEBUG) << "The AIT was not completed and/or updated, early out";
         return;
     }
+    // Repeated sections are only counted, to keep the clock off their path
+    metrics::ScopedTimer timer(updateTime);
+    ORB_TRACE_SCOPE("ApplicationManager::ProcessAitSection");
 
     const Ait::S_AIT_TABLE *updated_ait = m_ait.Get();
     if (updated_ait == nullptr)
@@ -475,7 +508,12 @@ int ApplicationManager::ProcessXmlAit(
     const Ait::S_AIT_APP_DESC *app_description;
     int result = BaseApp::INVALID_APP_ID;
 
+    static metrics::Histogram &processing = metrics::Registry::Instance().GetHistogram(
+        "orb_xml_ait_processing_microseconds", "Time to process an XML AIT");
+
     std::lock_guard<std::recursive_mutex> lock(m_lock);
+    metrics::ScopedTimer timer(processing);
+    ORB_TRACE_SCOPE("ApplicationManager::ProcessXmlAit");
 
     LOG(INFO) << "ProcessXmlAit";
 
@@ -602,7 +640,7 @@ bool ApplicationManager::IsRequestAllowed(int callingAppId, const
         case MethodRequirement::FOR_TRUSTED_APP_ONLY:
         {
             // Check document URL is inside app boundaries
-            if (!Utils::CheckBoundaries(callingPageUrl, m_hbbtvApp->GetEntryUrl(), m_hbbtvApp->GetAitDescription().boundaries))
+            if (!m_hbbtvApp->IsInBoundaries(callingPageUrl))
             {
                 return false;
             }
@@ -657,8 +695,11 @@ void ApplicationManager::OnBroadcastStopped()
 void ApplicationManager::OnChannelChanged(uint16_t originalNetworkId,
     uint16_t transportStreamId, uint16_t serviceId)
 {
+    ORB_TRACE_SCOPE("ApplicationManager::OnChannelChanged");
     LOG(DEBUG) << "OnChannelChanged (current service: " << m_currentService.serviceId << ")";
     std::lock_guard<std::recursive_mutex> lock(m_lock);
+    // Ends when the first AIT of the service is received or times out
+    ORB_TRACE_ASYNC_BEGIN("AIT acquisition", serviceId);
     m_currentServiceReceivedFirstAit = false;
     m_currentServiceAitPid = 0;
     m_ait.Clear();
@@ -681,6 +722,7 @@ void ApplicationManager::OnNetworkAvailabilityChanged(bool available)
 void ApplicationManager::OnLoadApplicationFailed(int appId)
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
+    ORB_TRACE_ASYNC_END("App load", appId);
 
     // TODO If a call to createApplication has failed, set app_ back to old_app_ and send event?
 
@@ -724,6 +766,7 @@ void ApplicationManager::OnLoadApplicationFailed(int appId)
 
 void ApplicationManager::OnApplicationPageChanged(int appId, const std::string &url)
 {
+    ORB_TRACE_SCOPE("ApplicationManager::OnApplicationPageChanged");
     std::lock_guard<std::recursive_mutex> lock(m_lock);
     BaseApp* app = getAppById(appId);
     if (app)
@@ -765,6 +808,7 @@ void ApplicationManager::onSelectedServiceAitReceived()
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
     LOG(INFO) << "OnSelectedServiceAitReceived";
+    ORB_TRACE_ASYNC_END("AIT acquisition", m_currentService.serviceId);
     auto ait = m_ait.Get();
     if (ait != nullptr)
     {
@@ -838,6 +882,7 @@ void ApplicationManager::onSelectedServiceAitTimeout()
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
     LOG(INFO) << "OnSelectedServiceAitTimeout";
+    ORB_TRACE_ASYNC_END("AIT acquisition", m_currentService.serviceId);
     killRunningApp(getCurrentHbbTVAppId());
 }
 
@@ -939,8 +984,10 @@ int ApplicationManager::runOpApp(std::unique_ptr<OpApp> app)
     std::lock_guard<std::recursive_mutex> lock(m_lock);
 
     // Clear existing OpApp
+    publishKeySetApp(APP_TYPE_OPAPP, nullptr);
     m_opApp.reset();
     m_opApp = std::move(app);
+    publishKeySetApp(APP_TYPE_OPAPP, m_opApp.get());
     return m_opApp->Load();
 }
 
@@ -949,6 +996,7 @@ int ApplicationManager::runHbbTVApp(std::unique_ptr<HbbTVApp> app)
     std::lock_guard<std::recursive_mutex> lock(m_lock);
 
     // Clear existing HbbTV app
+    publishKeySetApp(APP_TYPE_HBBTV, nullptr);
     m_hbbtvApp.reset();
 
     // Extract callback to avoid repeated checks
@@ -974,10 +1022,25 @@ int ApplicationManager::runHbbTVApp(std::unique_ptr<HbbTVApp> app)
 
     // Store the HbbTV app
     m_hbbtvApp = std::move(app);
+    publishKeySetApp(APP_TYPE_HBBTV, m_hbbtvApp.get());
 
     return m_hbbtvApp->Load();
 }
 
+void ApplicationManager::publishKeySetApp(const ApplicationType appType, BaseApp *app)
+{
+    m_keySetApps[appType].store(app);
+    // A key check that started before the store may still be using the previous app. Key checks
+    // that start from now on count themselves in the new epoch and see the new app, so only the
+    // checks already in progress are waited for. They do not take m_lock and only test a key
+    // set, so the spin is short even though m_lock is held.
+    unsigned int epoch = m_keySetEpoch.fetch_add(1);
+    while (m_keySetReaders[epoch & 1].load() != 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
 bool ApplicationManager::updateRunningApp(const Ait::S_AIT_APP_DESC &desc)
 {
     if (m_hbbtvApp) {
@@ -1016,6 +1079,7 @@ void ApplicationManager::killRunningApp(int appid)
     callback->HideApplication(appid);
     callback->LoadApplication(BaseApp::INVALID_APP_ID, "about:blank");
 
+    publishKeySetApp(type, nullptr);
     if (type == APP_TYPE_HBBTV)
     {
         m_hbbtvApp.reset();
@@ -1098,6 +1162,7 @@ bool ApplicationManager::isAppTrusted(bool)
  */
 const Ait::S_AIT_APP_DESC * ApplicationManager::getAutoStartApp(const Ait::S_AIT_TABLE *aitTable)
 {
+    ORB_TRACE_SCOPE("ApplicationManager::getAutoStartApp");
     //int index;
     LOG(INFO) << "GetAutoStartApp";
 
@@ -26,6 +26,7 @@
 #include <vector>
 #include <cstdint>
 #include <alloca.h>
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 
@@ -157,6 +158,16 @@ public:
      */
     bool InKeySet(const int appId, const uint16_t keyCode);
 
+    /**
+     * Check the key code is accepted by the key set of the running app of a type. Activate the
+     * app as a result if the key is accepted. Does not take the application manager lock.
+     *
+     * @param appType The application type.
+     * @param keyCode The key code to check.
+     * @return The supplied key_code is accepted by the running app's key set.
+     */
+    bool InRunningAppKeySet(const ApplicationType appType, const uint16_t keyCode);
+
     /**
      * Process an AIT section. The table will be processed when it is completed or updated.
      *
@@ -346,6 +357,16 @@ private:
      */
     uint16_t getKeySet(const uint16_t keyCode);
 
+    /**
+     * Publish the running app of a type to InRunningAppKeySet, and wait for any key check against
+     * the previous app to finish so that it can be reset. Must be called with m_lock held. Only
+     * the key checks that started before the call are waited for, so the wait is bounded.
+     *
+     * @param appType The application type.
+     * @param app The running app, or nullptr.
+     */
+    void publishKeySetApp(const ApplicationType appType, BaseApp *app);
+
     std::array<ApplicationSessionCallback*, APP_TYPE_MAX> m_sessionCallback;
 
     Ait m_ait;
@@ -359,6 +380,12 @@ private:
     bool m_isNetworkAvailable = false;
     std::recursive_mutex m_lock;
     Utils::Timeout m_aitTimeout;
+    // The running apps as seen by InRunningAppKeySet. A key check counts itself in the reader
+    // count of the current epoch, and publishKeySetApp starts a new epoch before waiting for the
+    // count of the previous one to drop to zero
+    std::array<std::atomic<BaseApp*>, APP_TYPE_MAX> m_keySetApps{};
+    std::array<std::atomic<int>, 2> m_keySetReaders{};
+    std::atomic<unsigned int> m_keySetEpoch{0};
 };
 
 } // namespace orb
@@ -23,6 +23,7 @@
 
 #include <string>
 #include "OrbConstants.h"
+#include "key_set.h"
 #include <ostream>
 
 namespace orb
@@ -82,7 +83,7 @@ public:
      *
      * @return The key set mask for the application.
      */
-    uint16_t GetKeySetMask() const { return m_keySetMask; }
+    uint16_t GetKeySetMask() const { return m_keySet.GetMask(); }
 
     /**
      * Set the key set mask for an application.
@@ -95,7 +96,7 @@ public:
 
     /**
      * Check the key code is accepted by the current key mask. Activate the app as a result if the
-     * key is accepted.
+     * key is accepted. Does not lock, so may be called while the key set is being set.
      *
      * @param appId The application.
      * @param keyCode The key code to check.
@@ -109,7 +110,7 @@ public:
      * @param appId The application.
      * @return The other keys for the application.
      */
-    std::vector<uint16_t> GetOtherKeyValues() const { return m_otherKeys; }
+    std::vector<uint16_t> GetOtherKeyValues() const { return m_keySet.GetOtherKeys(); }
 
     /**
      * Return the KeySet a key code belongs to.
@@ -117,22 +118,17 @@ public:
      * @param keyCode The key code.
      * @return The key set.
      */
-    static uint16_t GetKeySetMaskForKeyCode(const uint16_t keyCode);
+    static uint16_t GetKeySetMaskForKeyCode(const uint16_t keyCode)
+    {
+        return ClassifyKeyCode(keyCode).keySet;
+    }
 
 protected:
-
-    static bool IsKeyNavigation(const uint16_t code);
-    static bool IsKeyNumeric(const uint16_t code);
-    static bool IsKeyAlpha(const uint16_t code);
-    static bool IsKeyVcr(const uint16_t code);
-    static bool IsKeyScroll(const uint16_t code);
-
     ApplicationSessionCallback *m_sessionCallback;
     E_APP_STATE m_state;
     std::string m_scheme;
 
-    uint16_t m_keySetMask = 0;
-    std::vector<uint16_t> m_otherKeys;
+    KeySet m_keySet;
 
 private:
     const ApplicationType m_type;
@@ -22,7 +22,10 @@
 #include "third_party/orb/logging/include/log.h"
 #include "application_manager.h"
 #include "OrbConstants.h"
+#include "Metrics.h"
+#include "Trace.h"
 
+#include <chrono>
 #include <stdexcept>
 
 namespace orb
@@ -35,16 +38,15 @@ static std::string getUrlParamsFromAppScheme(const std::string &scheme);
 // static
 bool HbbTVApp::IsAllowedOtherKey(const uint16_t keyCode)
 {
-    // FREE-308: TS 102 796 v1.71 Annex A Table A.1.
-    const uint16_t VK_RECORD = 416;
-    return keyCode == VK_RECORD;
+    return (ClassifyKeyCode(keyCode).flags & KeyClass::ALLOWED_OTHER_KEY) != 0;
 }
 
 
 HbbTVApp::HbbTVApp(const std::string &url, ApplicationSessionCallback *sessionCallback)
     : BaseApp(APP_TYPE_HBBTV, url, sessionCallback),
     m_entryUrl(url),
-    m_baseUrl(url)
+    m_baseUrl(url),
+    m_boundaries(url, {})
 {
     m_scheme = getAppSchemeFromUrlParams(url);
 }
@@ -63,13 +65,25 @@ HbbTVApp::HbbTVApp(const Utils::S_DVB_TRIPLET currentService,
 }
 
 int HbbTVApp::Load() {
+    ORB_TRACE_SCOPE("HbbTVApp::Load");
+    // Ends when the browser has loaded the app, or in OnLoadApplicationFailed
+    ORB_TRACE_ASYNC_BEGIN("App load", GetId());
+    static metrics::Histogram &loadTime = metrics::Registry::Instance().GetHistogram(
+        "orb_app_load_microseconds", "Time from requesting an HbbTV app load to the app loading");
+    const auto loadStart = std::chrono::steady_clock::now();
+
     // Load the HbbTV application with graphics constraints
     m_sessionCallback->LoadApplication(
         GetId(),
         GetEntryUrl().c_str(),
         GetAitDescription().graphicsConstraints.size(),
         GetAitDescription().graphicsConstraints,
-        [this]() { SetState(BaseApp::FOREGROUND_STATE); });
+        [this, loadStart]() {
+            ORB_TRACE_ASYNC_END("App load", GetId());
+            loadTime.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - loadStart).count());
+            SetState(BaseApp::FOREGROUND_STATE);
+        });
 
     return GetId();
 }
@@ -80,6 +94,7 @@ void HbbTVApp::SetUrl(const Ait::S_AIT_APP_DESC &desc,
     m_baseUrl = Ait::ExtractBaseURL(desc, m_service, isNetworkAvailable);
     m_entryUrl = Utils::MergeUrlParams(m_baseUrl, desc.location, urlParams);
     SetLoadedUrl(m_entryUrl);
+    m_boundaries = Utils::OriginSet(m_entryUrl, m_aitDesc.boundaries);
 }
 
 bool HbbTVApp::Update(const Ait::S_AIT_APP_DESC &desc, bool isNetworkAvailable)
@@ -97,6 +112,7 @@ bool HbbTVApp::Update(const Ait::S_AIT_APP_DESC &desc, bool isNetworkAvailable)
     }
 
     m_aitDesc = desc;
+    m_boundaries = Utils::OriginSet(m_entryUrl, m_aitDesc.boundaries);
 
     for (uint8_t i = 0; i < desc.appDesc.appProfiles.size(); i++)
     {
@@ -147,12 +163,13 @@ bool HbbTVApp::TransitionToBroadcastRelated()
 
     if (m_protocolId == Ait::PROTOCOL_HTTP)
     {
-        if (!Utils::CheckBoundaries(m_entryUrl, m_baseUrl, m_aitDesc.boundaries))
+        Utils::OriginSet boundaries(m_baseUrl, m_aitDesc.boundaries);
+        if (!boundaries.Contains(m_entryUrl))
         {
             LOG(INFO) << "Cannot transition to broadcast (entry URL is not in boundaries)";
             return false;
         }
-        if (!Utils::CheckBoundaries(GetLoadedUrl(), m_baseUrl, m_aitDesc.boundaries))
+        if (!boundaries.Contains(GetLoadedUrl()))
         {
             LOG(INFO) << "Cannot transition to broadcast (loaded URL is not in boundaries)";
             return false;
@@ -213,10 +230,10 @@ uint16_t HbbTVApp::SetKeySetMask(const uint16_t keySetMask, const std::vector<ui
         }
     }
 
-    m_keySetMask = newKeySetMask;
     if ((newKeySetMask & KEY_SET_OTHER) == KEY_SET_OTHER) {
-        m_otherKeys = otherKeys; // Survived all checks
+        m_keySet.SetOtherKeys(otherKeys); // Survived all checks
     }
+    m_keySet.SetMask(newKeySetMask);
 
     return newKeySetMask;
 }
@@ -226,7 +243,7 @@ bool HbbTVApp::InKeySet(const uint16_t keyCode)
     bool result = BaseApp::InKeySet(keyCode);
     if (result) {
         // We don't care what state m_isActivated is, just set it.
-        m_isActivated = true;
+        m_isActivated.store(true, std::memory_order_relaxed);
     }
 
     return result;
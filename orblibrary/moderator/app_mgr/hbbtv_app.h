@@ -21,6 +21,7 @@
 #ifndef HBBTV_APP_H
 #define HBBTV_APP_H
 
+#include <atomic>
 #include <vector>
 #include <map>
 #include <cstdint>
@@ -102,6 +103,14 @@ public:
 
     Ait::S_AIT_APP_DESC GetAitDescription() const { return m_aitDesc; }
 
+    /**
+     * Return true if the URL has the origin of the entry URL or of one of the app boundaries.
+     *
+     * @param url The URL, e.g. of the document making a request.
+     * @return True if the URL is inside the app boundaries, false otherwise.
+     */
+    bool IsInBoundaries(const std::string &url) const { return m_boundaries.Contains(url); }
+
     uint16_t SetKeySetMask(const uint16_t keySetMask, const std::vector<uint16_t> &otherKeys) override;
 
     bool InKeySet(const uint16_t keyCode) override;
@@ -122,13 +131,15 @@ public:
     Utils::S_DVB_TRIPLET m_service = Utils::MakeInvalidDvbTriplet();
     uint16_t m_protocolId = 0;
 
-    /* Activated by default. Deactivate if they are AUTOSTARTED */
-    bool m_isActivated = true;
+    /* Activated by default. Deactivate if they are AUTOSTARTED. Set by InKeySet, which does not
+     * lock. */
+    std::atomic<bool> m_isActivated{true};
     bool m_isTrusted = false;
     bool m_isBroadcast = false;
 
     Ait::S_AIT_APP_DESC m_aitDesc;
     std::map<uint32_t, std::string> m_names;
+    Utils::OriginSet m_boundaries; // Entry URL and m_aitDesc.boundaries
 
     uint8_t m_versionMinor = 0;
 };
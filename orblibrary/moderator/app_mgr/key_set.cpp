@@ -0,0 +1,145 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Key code classification and app key sets
+ *
+ * Note: This file is part of the platform-agnostic application manager library.
+ */
+
+#include "key_set.h"
+#include "OrbConstants.h"
+
+namespace orb
+{
+namespace
+{
+
+const uint16_t VK_RED = 403;
+const uint16_t VK_GREEN = 404;
+const uint16_t VK_YELLOW = 405;
+const uint16_t VK_BLUE = 406;
+const uint16_t VK_UP = 38;
+const uint16_t VK_DOWN = 40;
+const uint16_t VK_LEFT = 37;
+const uint16_t VK_RIGHT = 39;
+const uint16_t VK_ENTER = 13;
+const uint16_t VK_BACK = 461;
+const uint16_t VK_PLAY = 415;
+const uint16_t VK_STOP = 413;
+const uint16_t VK_PAUSE = 19;
+const uint16_t VK_FAST_FWD = 417;
+const uint16_t VK_REWIND = 412;
+const uint16_t VK_NEXT = 425;
+const uint16_t VK_PREV = 424;
+const uint16_t VK_PLAY_PAUSE = 402;
+const uint16_t VK_RECORD = 416;
+const uint16_t VK_PAGE_UP = 33;
+const uint16_t VK_PAGE_DOWN = 34;
+const uint16_t VK_INFO = 457;
+const uint16_t VK_NUMERIC_START = 48;
+const uint16_t VK_NUMERIC_END = 57;
+const uint16_t VK_ALPHA_START = 65;
+const uint16_t VK_ALPHA_END = 90;
+
+// From TS 103 606 V1.2.1 (2024-03) 10.1.3 Table 17. OpApp keys form three ranges.
+const uint16_t VK_CHANNEL_DOWN = 400;
+const uint16_t VK_CHANNEL_UP   = 401;
+//             VK_INFO         = 457;
+//             VK_GUIDE        = 458;
+//             VK_CHANNELS     = 459;
+const uint16_t VK_MENU         = 460;
+const uint16_t VK_VOLUME_UP    = 462;
+//             VK_VOLUME_DOWN  = 463;
+//             VK_MUTE         = 464;
+//             VK_SUBTITLE     = 465;
+//             VK_AUDIO_TRACK  = 466;
+//             VK_AUDIO_DESC   = 467;
+const uint16_t VK_EXIT         = 468;
+
+constexpr std::array<KeyClass, KEY_CLASS_TABLE_SIZE> MakeKeyClassTable()
+{
+    std::array<KeyClass, KEY_CLASS_TABLE_SIZE> table{};
+    for (uint16_t code : {VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT, VK_ENTER, VK_BACK})
+    {
+        table[code].keySet = KEY_SET_NAVIGATION;
+    }
+    for (uint16_t code = VK_NUMERIC_START; code <= VK_NUMERIC_END; code++)
+    {
+        table[code].keySet = KEY_SET_NUMERIC;
+    }
+    for (uint16_t code = VK_ALPHA_START; code <= VK_ALPHA_END; code++)
+    {
+        table[code].keySet = KEY_SET_ALPHA;
+    }
+    for (uint16_t code : {VK_PLAY, VK_STOP, VK_PAUSE, VK_FAST_FWD, VK_REWIND, VK_NEXT, VK_PREV,
+                          VK_PLAY_PAUSE})
+    {
+        table[code].keySet = KEY_SET_VCR;
+    }
+    table[VK_PAGE_UP].keySet = KEY_SET_SCROLL;
+    table[VK_PAGE_DOWN].keySet = KEY_SET_SCROLL;
+    table[VK_RED].keySet = KEY_SET_RED;
+    table[VK_GREEN].keySet = KEY_SET_GREEN;
+    table[VK_YELLOW].keySet = KEY_SET_YELLOW;
+    table[VK_BLUE].keySet = KEY_SET_BLUE;
+    table[VK_INFO].keySet = KEY_SET_INFO;
+
+    // FREE-308: TS 102 796 v1.71 Annex A Table A.1.
+    table[VK_RECORD].flags |= KeyClass::ALLOWED_OTHER_KEY;
+
+    for (uint16_t code = VK_CHANNEL_DOWN; code <= VK_CHANNEL_UP; code++)
+    {
+        table[code].flags |= KeyClass::OPERATOR_APPLICATION;
+    }
+    for (uint16_t code = VK_INFO; code <= VK_MENU; code++)
+    {
+        table[code].flags |= KeyClass::OPERATOR_APPLICATION;
+    }
+    for (uint16_t code = VK_VOLUME_UP; code <= VK_EXIT; code++)
+    {
+        table[code].flags |= KeyClass::OPERATOR_APPLICATION;
+    }
+    return table;
+}
+
+} // namespace
+
+constexpr std::array<KeyClass, KEY_CLASS_TABLE_SIZE> KEY_CLASS_TABLE = MakeKeyClassTable();
+
+void KeySet::SetOtherKeys(const std::vector<uint16_t> &otherKeys)
+{
+    for (uint16_t code : m_otherKeyCodes)
+    {
+        m_otherKeys[code / 64].store(0, std::memory_order_relaxed);
+    }
+    for (uint16_t code : otherKeys)
+    {
+        m_otherKeys[code / 64].fetch_or(uint64_t(1) << (code % 64), std::memory_order_release);
+    }
+    m_otherKeyCodes = otherKeys;
+}
+
+bool KeySet::Contains(const uint16_t keyCode) const
+{
+    const uint16_t mask = GetMask();
+    if ((mask & ClassifyKeyCode(keyCode).keySet) != 0)
+    {
+        return true;
+    }
+    return (mask & KEY_SET_OTHER) != 0 &&
+        (m_otherKeys[keyCode / 64].load(std::memory_order_acquire) >> (keyCode % 64)) & 1;
+}
+
+} // namespace orb
@@ -0,0 +1,107 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Key code classification and app key sets
+ *
+ * Note: This file is part of the platform-agnostic application manager library.
+ */
+
+#ifndef KEY_SET_H
+#define KEY_SET_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace orb
+{
+
+/**
+ * What the application manager knows about a key code.
+ */
+struct KeyClass
+{
+    // Flags
+    static constexpr uint8_t ALLOWED_OTHER_KEY = 0x1;     // May be requested in KEY_SET_OTHER
+    static constexpr uint8_t OPERATOR_APPLICATION = 0x2;  // TS 103 606 Table 17
+
+    uint16_t keySet = 0;  // The KEY_SET_ bit of the key code, or 0
+    uint8_t flags = 0;
+};
+
+// Every key code that the application manager classifies is below this
+constexpr uint16_t KEY_CLASS_TABLE_SIZE = 512;
+
+extern const std::array<KeyClass, KEY_CLASS_TABLE_SIZE> KEY_CLASS_TABLE;
+
+/**
+ * Classify a key code with a single table load.
+ *
+ * @param keyCode The key code.
+ * @return The classification, empty if the key code is not known.
+ */
+inline KeyClass ClassifyKeyCode(const uint16_t keyCode)
+{
+    return keyCode < KEY_CLASS_TABLE_SIZE ? KEY_CLASS_TABLE[keyCode] : KeyClass();
+}
+
+/**
+ * The keys requested by an app. Setting it must be serialised by the caller, but checking a key
+ * does not lock and may happen at the same time as a set.
+ */
+class KeySet
+{
+public:
+    KeySet() = default;
+    KeySet(const KeySet&) = delete;
+    KeySet& operator=(const KeySet&) = delete;
+
+    uint16_t GetMask() const { return m_mask.load(std::memory_order_acquire); }
+
+    /**
+     * @param mask The key set mask.
+     */
+    void SetMask(const uint16_t mask) { m_mask.store(mask, std::memory_order_release); }
+
+    /**
+     * Replace the other keys, which are accepted while the mask contains KEY_SET_OTHER.
+     *
+     * @param otherKeys The key codes.
+     */
+    void SetOtherKeys(const std::vector<uint16_t> &otherKeys);
+
+    /**
+     * @return The key codes last passed to SetOtherKeys.
+     */
+    const std::vector<uint16_t>& GetOtherKeys() const { return m_otherKeyCodes; }
+
+    /**
+     * @param keyCode The key code.
+     * @return true if the key code is in the key set.
+     */
+    bool Contains(const uint16_t keyCode) const;
+
+private:
+    static constexpr size_t BITMAP_WORDS = (UINT16_MAX + 1) / 64;
+
+    std::atomic<uint16_t> m_mask{0};
+    std::array<std::atomic<uint64_t>, BITMAP_WORDS> m_otherKeys{};
+    std::vector<uint16_t> m_otherKeyCodes; // The bits set in m_otherKeys
+};
+
+} // namespace orb
+
+#endif // KEY_SET_H
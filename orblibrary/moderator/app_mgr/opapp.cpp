@@ -1,29 +1,13 @@
 #include "opapp.h"
 #include "third_party/orb/logging/include/log.h"
 #include "application_manager.h"
+#include "Trace.h"
 
 
 const int DEFAULT_COUNT_DOWN_TIMEOUT = 60000;
 
 namespace orb
 {
-// From TS 103 606 V1.2.1 (2024-03) 10.1.3 Table 17
-// Since we use a range based approach, we don't define all keys here.
-// But putting them here for reference.
-const uint16_t VK_CHANNEL_UP   = 401;
-const uint16_t VK_CHANNEL_DOWN = 400;
-const uint16_t VK_INFO         = 457;
-//             VK_GUIDE        = 458;
-//             VK_CHANNELS     = 459;
-const uint16_t VK_MENU         = 460;
-const uint16_t VK_VOLUME_UP    = 462;
-//             VK_VOLUME_DOWN  = 463;
-//             VK_MUTE         = 464;
-//             VK_SUBTITLE     = 465;
-//             VK_AUDIO_TRACK  = 466;
-//             VK_AUDIO_DESC   = 467;
-const uint16_t VK_EXIT         = 468;
-
 // static
 std::string OpApp::opAppStateToString(const E_APP_STATE &state)
 {
@@ -49,11 +33,7 @@ bool OpApp::IsOperatorApplicationKey(const uint16_t keyCode)
 {
     // See TS 103 606 V1.2.1 (2024-03) 10.1.3 Table 17
     // OpApp keys form three ranges: 400-401, 457-460, 462-468
-    bool isKeyChannelRange = (keyCode >= VK_CHANNEL_DOWN && keyCode <= VK_CHANNEL_UP);
-    bool isKeyInfoRange    = (keyCode >= VK_INFO         && keyCode <= VK_MENU);
-    bool isKeyVolumeRange  = (keyCode >= VK_VOLUME_UP    && keyCode <= VK_EXIT);
-    
-    return isKeyChannelRange || isKeyInfoRange || isKeyVolumeRange;
+    return (ClassifyKeyCode(keyCode).flags & KeyClass::OPERATOR_APPLICATION) != 0;
 }
 
 OpApp::OpApp(const std::string &url, ApplicationSessionCallback *sessionCallback)
@@ -79,8 +59,11 @@ void OpApp::init()
 }
 
 int OpApp::Load() {
+    ORB_TRACE_SCOPE("OpApp::Load");
+    ORB_TRACE_ASYNC_BEGIN("App load", GetId());
     m_sessionCallback->LoadApplication(
         GetId(), GetLoadedUrl().c_str(), [this]() {
+            ORB_TRACE_ASYNC_END("App load", GetId());
 
             SetState(m_state);
         });
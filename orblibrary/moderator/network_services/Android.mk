@@ -28,13 +28,15 @@ else
 endif
 
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/media_synchroniser \
-                    $(LOCAL_PATH)/app2app
+                    $(LOCAL_PATH)/app2app \
+                    $(LOCAL_PATH)/../../metrics
 
 ifeq ($(ORB_HBBTV_VERSION),204)
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/json_rpc_server
 endif
 
 LOCAL_SRC_FILES := \
+   ../../metrics/Metrics.cpp \
    app2app/app2app_local_service.cpp \
    app2app/app2app_remote_service.cpp \
    media_synchroniser/media_synchroniser.cpp \
@@ -43,6 +45,7 @@ LOCAL_SRC_FILES := \
    media_synchroniser/ClockBase.cpp \
    media_synchroniser/SysClock.cpp \
    media_synchroniser/ClockUtilities.cpp \
+   json_codec.cpp \
    service_manager.cpp \
    UdpSocketService.cpp \
    websocket_service.cpp \
@@ -53,6 +56,7 @@ LOCAL_SRC_FILES := \
 
 ifeq ($(ORB_HBBTV_VERSION),204)
 LOCAL_SRC_FILES += \
+    json_rpc/IPPlaybackStateAggregator.cpp \
     json_rpc/JsonRpcService.cpp
 endif
 
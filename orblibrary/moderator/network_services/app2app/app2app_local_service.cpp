@@ -72,7 +72,7 @@ bool App2AppLocalService::OnConnection(WebSocketConnection *connection)
 }
 
 void App2AppLocalService::OnFragmentReceived(WebSocketConnection *connection,
-    std::vector<uint8_t> &&data, bool is_first, bool is_final, bool is_binary)
+    const uint8_t *data, size_t length, bool is_first, bool is_final, bool is_binary)
 {
     mutex_.lock();
     if (service_stopped_ || remote_service_stopped_)
@@ -82,8 +82,8 @@ void App2AppLocalService::OnFragmentReceived(WebSocketConnection *connection,
     }
     if (connection->paired_connection_ != nullptr)
     {
-        connection->paired_connection_->SendFragment(std::move(data), is_first, is_final,
-            is_binary);
+        connection->paired_connection_->SendFragment(std::vector<uint8_t>(data, data + length),
+            is_first, is_final, is_binary);
     }
     mutex_.unlock();
 }
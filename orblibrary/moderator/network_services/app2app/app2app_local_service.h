@@ -30,8 +30,8 @@ class App2AppLocalService : public WebSocketService {
 public:
     App2AppLocalService(ServiceManager *manager, int local_port, int remote_port);
     bool OnConnection(WebSocketConnection *connection) override;
-    void OnFragmentReceived(WebSocketConnection *connection, std::vector<uint8_t> &&data,
-        bool is_first, bool is_final, bool is_binary) override;
+    void OnFragmentReceived(WebSocketConnection *connection, const uint8_t *data,
+        size_t length, bool is_first, bool is_final, bool is_binary) override;
     void OnDisconnected(WebSocketConnection *connection) override;
     bool OnRemoteConnection(WebSocketConnection *connection);
     void OnRemoteFragmentReceived(WebSocketConnection *connection, std::vector<uint8_t> &&data,
@@ -35,11 +35,11 @@ bool App2AppRemoteService::OnConnection(WebSocketConnection *connection)
 }
 
 void App2AppRemoteService::OnFragmentReceived(WebSocketConnection *connection,
-    std::vector<uint8_t> &&data,
+    const uint8_t *data, size_t length,
     bool is_first, bool is_final, bool is_binary)
 {
-    local_service_->OnRemoteFragmentReceived(connection, std::move(data), is_first, is_final,
-        is_binary);
+    local_service_->OnRemoteFragmentReceived(connection, std::vector<uint8_t>(data, data + length),
+        is_first, is_final, is_binary);
 }
 
 void App2AppRemoteService::OnDisconnected(WebSocketConnection *connection)
@@ -28,8 +28,8 @@ class App2AppRemoteService : public WebSocketService {
 public:
     App2AppRemoteService(App2AppLocalService *local_service, int port);
     bool OnConnection(WebSocketConnection *connection) override;
-    void OnFragmentReceived(WebSocketConnection *connection, std::vector<uint8_t> &&data,
-        bool is_first, bool is_final, bool is_binary) override;
+    void OnFragmentReceived(WebSocketConnection *connection, const uint8_t *data,
+        size_t length, bool is_first, bool is_final, bool is_binary) override;
     void OnDisconnected(WebSocketConnection *connection) override;
     void OnServiceStopped() override;
 
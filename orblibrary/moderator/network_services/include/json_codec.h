@@ -0,0 +1,101 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBS_NS_JSON_CODEC_H
+#define OBS_NS_JSON_CODEC_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <json/json.h>
+
+namespace orb {
+namespace networkServices {
+
+/**
+ * JSON encoding and decoding shared by the network services.
+ *
+ * The jsoncpp reader and writer are created once per thread and reused for every message, rather
+ * than being constructed for each message received or sent.
+ */
+class JsonCodec {
+public:
+    /**
+     * The members of a JSON-RPC request or notification, as found by ScanRequestEnvelope.
+     * The id and params members are left as unparsed JSON text within the scanned message.
+     */
+    struct RequestEnvelope
+    {
+        bool hasVersion = false;
+        std::string version;
+        bool hasMethod = false;
+        std::string method;
+        const char *id = nullptr;
+        size_t idLength = 0;
+        const char *params = nullptr;
+        size_t paramsLength = 0;
+    };
+
+    /**
+     * Parse JSON text.
+     *
+     * @param begin The start of the text.
+     * @param end The end of the text.
+     * @param value Set to the parsed value.
+     * @param errors If not null, set to a description of any errors.
+     * @return true if the text was parsed, otherwise false.
+     */
+    static bool Parse(const char *begin, const char *end, Json::Value &value,
+        std::string *errors = nullptr);
+
+    /**
+     * Parse JSON text.
+     *
+     * @param text The text.
+     * @param value Set to the parsed value.
+     * @param errors If not null, set to a description of any errors.
+     * @return true if the text was parsed, otherwise false.
+     */
+    static bool Parse(const std::string &text, Json::Value &value, std::string *errors = nullptr);
+
+    /**
+     * Write a JSON value as compact text, without indentation or comments.
+     *
+     * @param value The value.
+     * @return The JSON text.
+     */
+    static std::string Write(const Json::Value &value);
+
+    /**
+     * Find the members of a JSON-RPC request or notification without building a Json::Value for
+     * the message.
+     *
+     * Only the common form of message is accepted: an object with no members other than
+     * jsonrpc, id, method and params, where jsonrpc and method are strings without escapes, id is
+     * a string without escapes, a number or null, and params is an object or array. For any
+     * other message false is returned and the message should be parsed with Parse instead. The
+     * params text is not validated.
+     *
+     * @param text The message. Must outlive the envelope.
+     * @param envelope Set to the members of the message.
+     * @return true if the envelope was found, otherwise false.
+     */
+    static bool ScanRequestEnvelope(std::string_view text, RequestEnvelope &envelope);
+};
+} // namespace networkServices
+} // namespace orb
+
+#endif // OBS_NS_JSON_CODEC_H
@@ -19,8 +19,11 @@
 
 #include "service_manager.h"
 
+#include <chrono>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include <queue>
 #include <mutex>
@@ -36,6 +39,13 @@ const std::string SSL_PRIVATE_KEY_FILEPATH = "todo.key";
 constexpr int SECS_SINCE_VALID_PING = 3;
 constexpr int SECS_SINCE_VALID_HANGUP = 10;
 constexpr int RX_BUFFER_SIZE = 4096;
+constexpr size_t DEFAULT_MAX_MESSAGE_SIZE = 1024 * 1024;
+// Reassembly buffers are sized in powers of two from this size, and up to this many are pooled
+constexpr size_t MIN_MESSAGE_BUFFER_SIZE = RX_BUFFER_SIZE;
+constexpr size_t MAX_POOLED_MESSAGE_BUFFERS = 8;
+// A connection releases its buffer after a message larger than this. Larger buffers are freed
+// instead of pooled, so the pool never holds more than 8 x 64 KiB
+constexpr size_t MAX_KEPT_MESSAGE_BUFFER_SIZE = 64 * 1024;
 
 class WebSocketService : public ServiceManager::Service {
 public:
@@ -58,10 +68,10 @@ public:
             return mId;
         }
 
-        void SendMessage(const std::string &text);
+        virtual void SendMessage(const std::string &text);
         void SendFragment(std::vector<uint8_t> &&data, bool is_first, bool is_final, bool
             is_binary);
-        void Close();
+        void Close(enum lws_close_status status = LWS_CLOSE_STATUS_GOINGAWAY);
         int GetQueueSize() const;
      
 protected:
@@ -70,6 +80,8 @@ protected:
             lws_write_protocol write_protocol;
             std::vector<uint8_t> data;
             bool close;
+            enum lws_close_status close_status;
+            std::chrono::steady_clock::time_point queued;
         };
         // Disallow copy and assign
         WebSocketConnection(const WebSocketConnection&) = delete;
@@ -78,7 +90,8 @@ protected:
  private:
         struct lws* mWsi;
         std::string mUri;
-        std::string mTextBuffer;
+        std::string mMessageBuffer;
+        bool mDiscardMessage;
         std::queue<struct FragmentWriteInfo> mWriteQueue;
         int mId;
        
@@ -89,11 +102,25 @@ protected:
     virtual ~WebSocketService();
     virtual bool Start();
     virtual void Stop();
+    /**
+     * Set the largest message the default OnFragmentReceived reassembles. A connection that
+     * sends a larger message is closed. Default value is DEFAULT_MAX_MESSAGE_SIZE.
+     */
+    void SetMaxMessageSize(size_t size);
+    /**
+     * Offer RFC 7692 permessage-deflate to clients, with context takeover, so that repetitive
+     * messages compress to a few bytes. Call before Start.
+     *
+     * @return false if libwebsockets was built without extensions
+     */
+    bool EnablePermessageDeflate();
     virtual bool OnConnection(WebSocketConnection *connection) = 0;
     virtual void OnDisconnected(WebSocketConnection *connection) = 0;
-    virtual void OnFragmentReceived(WebSocketConnection *connection, std::vector<uint8_t> &&data,
-        bool is_first, bool is_final, bool is_binary);
-    virtual void OnMessageReceived(WebSocketConnection *connection, const std::string &text);
+    // The fragment data is only valid for the duration of the call
+    virtual void OnFragmentReceived(WebSocketConnection *connection, const uint8_t *data,
+        size_t length, bool is_first, bool is_final, bool is_binary);
+    // The text is only valid for the duration of the call
+    virtual void OnMessageReceived(WebSocketConnection *connection, std::string_view text);
 
 protected:
     std::recursive_mutex mConnectionsMutex;
@@ -110,6 +137,8 @@ private:
         len);
     struct lws_protocols Protocol(const char *protocol_name);
     std::string Header(struct lws *wsi, enum lws_token_indexes header);
+    void ReserveMessageBuffer(std::string &buffer, size_t size);
+    void ReleaseMessageBuffer(std::string &buffer);
 
     bool mStop;
     std::string mProtocolName;
@@ -119,6 +148,12 @@ private:
     lws_retry_bo_t retry_;
  #endif   
     struct lws_protocols mProtocols[2];
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+    struct lws_extension mExtensions[2];
+#endif
+    size_t mMaxMessageSize;
+    // Reassembly buffers released by connections, only used on the service thread
+    std::vector<std::string> mMessageBufferPool;
     struct lws_context_creation_info mContextInfo;
     struct lws_context *mContext;
     std::unique_ptr<std::thread> mMainThread;
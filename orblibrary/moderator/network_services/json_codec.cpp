@@ -0,0 +1,344 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "json_codec.h"
+
+#include <memory>
+#include <sstream>
+
+namespace orb {
+namespace networkServices {
+
+static const char* SkipWhitespace(const char *p, const char *end)
+{
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+    {
+        p++;
+    }
+    return p;
+}
+
+static bool IsDigit(const char *p, const char *end)
+{
+    return p != end && *p >= '0' && *p <= '9';
+}
+
+// Scan a string without escapes, starting at the opening quote
+static bool ScanPlainString(const char *&p, const char *end, std::string *out)
+{
+    const char *begin = ++p;
+    while (p != end && *p != '"')
+    {
+        if (*p == '\\' || static_cast<unsigned char>(*p) < 0x20)
+        {
+            return false;
+        }
+        p++;
+    }
+    if (p == end)
+    {
+        return false;
+    }
+    if (out != nullptr)
+    {
+        out->assign(begin, p);
+    }
+    p++;
+    return true;
+}
+
+// Scan a number, as defined by the JSON grammar
+static bool ScanNumber(const char *&p, const char *end)
+{
+    if (p != end && *p == '-')
+    {
+        p++;
+    }
+    if (!IsDigit(p, end))
+    {
+        return false;
+    }
+    if (*p++ != '0')
+    {
+        while (IsDigit(p, end))
+        {
+            p++;
+        }
+    }
+    if (p != end && *p == '.')
+    {
+        if (!IsDigit(++p, end))
+        {
+            return false;
+        }
+        while (IsDigit(p, end))
+        {
+            p++;
+        }
+    }
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        if (p != end && (*p == '+' || *p == '-'))
+        {
+            p++;
+        }
+        if (!IsDigit(p, end))
+        {
+            return false;
+        }
+        while (IsDigit(p, end))
+        {
+            p++;
+        }
+    }
+    return true;
+}
+
+// Skip an object or array, starting at the opening bracket. Brackets are counted, not matched,
+// as the skipped text is validated when it is parsed.
+static bool SkipNested(const char *&p, const char *end)
+{
+    int depth = 0;
+    while (p != end)
+    {
+        switch (*p++)
+        {
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0)
+                {
+                    return true;
+                }
+                break;
+            case '"':
+                while (p != end && *p != '"')
+                {
+                    if (*p == '\\' && ++p == end)
+                    {
+                        return false;
+                    }
+                    p++;
+                }
+                if (p == end)
+                {
+                    return false;
+                }
+                p++;
+                break;
+            case '/':
+                // Comments may contain brackets
+                return false;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+#if JSONCPP_VERSION_HEXA > 0x01080200
+static std::unique_ptr<Json::CharReader> NewReader()
+{
+    Json::CharReaderBuilder builder;
+    builder["collectComments"] = false;
+    return std::unique_ptr<Json::CharReader>(builder.newCharReader());
+}
+
+static std::unique_ptr<Json::StreamWriter> NewWriter()
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    builder["commentStyle"] = "None";
+    return std::unique_ptr<Json::StreamWriter>(builder.newStreamWriter());
+}
+#endif
+
+/**
+ * Parse JSON text.
+ *
+ * @param begin The start of the text.
+ * @param end The end of the text.
+ * @param value Set to the parsed value.
+ * @param errors If not null, set to a description of any errors.
+ * @return true if the text was parsed, otherwise false.
+ */
+bool JsonCodec::Parse(const char *begin, const char *end, Json::Value &value,
+    std::string *errors)
+{
+// Use version define in jsoncpp header 'json/version.h'
+#if JSONCPP_VERSION_HEXA > 0x01080200
+    static thread_local std::unique_ptr<Json::CharReader> reader = NewReader();
+    return reader->parse(begin, end, &value, errors);
+#else
+    static thread_local Json::Reader reader;
+    if (!reader.parse(begin, end, value, false /* Discard comments */))
+    {
+        if (errors != nullptr)
+        {
+            *errors = reader.getFormattedErrorMessages();
+        }
+        return false;
+    }
+    return true;
+#endif
+}
+
+/**
+ * Parse JSON text.
+ *
+ * @param text The text.
+ * @param value Set to the parsed value.
+ * @param errors If not null, set to a description of any errors.
+ * @return true if the text was parsed, otherwise false.
+ */
+bool JsonCodec::Parse(const std::string &text, Json::Value &value, std::string *errors)
+{
+    return Parse(text.data(), text.data() + text.size(), value, errors);
+}
+
+/**
+ * Write a JSON value as compact text, without indentation or comments.
+ *
+ * @param value The value.
+ * @return The JSON text.
+ */
+std::string JsonCodec::Write(const Json::Value &value)
+{
+#if JSONCPP_VERSION_HEXA > 0x01080200
+    static thread_local std::unique_ptr<Json::StreamWriter> writer = NewWriter();
+    static thread_local std::ostringstream stream;
+    stream.str(std::string());
+    stream.clear();
+    writer->write(value, &stream);
+    return stream.str();
+#else
+    static thread_local Json::FastWriter writer;
+    return writer.write(value);
+#endif
+}
+
+/**
+ * Find the members of a JSON-RPC request or notification without building a Json::Value for
+ * the message.
+ *
+ * @param text The message. Must outlive the envelope.
+ * @param envelope Set to the members of the message.
+ * @return true if the envelope was found, otherwise false.
+ */
+bool JsonCodec::ScanRequestEnvelope(std::string_view text, RequestEnvelope &envelope)
+{
+    const char *end = text.data() + text.size();
+    const char *p = SkipWhitespace(text.data(), end);
+    envelope = RequestEnvelope();
+    if (p == end || *p != '{')
+    {
+        return false;
+    }
+    p = SkipWhitespace(p + 1, end);
+    if (p != end && *p == '}')
+    {
+        return SkipWhitespace(p + 1, end) == end;
+    }
+    std::string key;
+    while (true)
+    {
+        if (p == end || *p != '"' || !ScanPlainString(p, end, &key))
+        {
+            return false;
+        }
+        p = SkipWhitespace(p, end);
+        if (p == end || *p != ':')
+        {
+            return false;
+        }
+        p = SkipWhitespace(p + 1, end);
+        if (p == end)
+        {
+            return false;
+        }
+        const char *value = p;
+        if (key == "jsonrpc" && !envelope.hasVersion)
+        {
+            if (*p != '"' || !ScanPlainString(p, end, &envelope.version))
+            {
+                return false;
+            }
+            envelope.hasVersion = true;
+        }
+        else if (key == "method" && !envelope.hasMethod)
+        {
+            if (*p != '"' || !ScanPlainString(p, end, &envelope.method))
+            {
+                return false;
+            }
+            envelope.hasMethod = true;
+        }
+        else if (key == "id" && envelope.id == nullptr)
+        {
+            if (*p == '"')
+            {
+                if (!ScanPlainString(p, end, nullptr))
+                {
+                    return false;
+                }
+            }
+            else if (text.compare(p - text.data(), 4, "null") == 0)
+            {
+                p += 4;
+            }
+            else if (!ScanNumber(p, end))
+            {
+                return false;
+            }
+            envelope.id = value;
+            envelope.idLength = p - value;
+        }
+        else if (key == "params" && envelope.params == nullptr)
+        {
+            if ((*p != '{' && *p != '[') || !SkipNested(p, end))
+            {
+                return false;
+            }
+            envelope.params = value;
+            envelope.paramsLength = p - value;
+        }
+        else
+        {
+            // Other members, such as result and error, and duplicate members
+            return false;
+        }
+        p = SkipWhitespace(p, end);
+        if (p == end)
+        {
+            return false;
+        }
+        if (*p == '}')
+        {
+            return SkipWhitespace(p + 1, end) == end;
+        }
+        if (*p != ',')
+        {
+            return false;
+        }
+        p = SkipWhitespace(p + 1, end);
+    }
+}
+} // namespace networkServices
+} // namespace orb
@@ -0,0 +1,258 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * ORB IPPlaybackStateAggregator
+ *
+ */
+
+#include "IPPlaybackStateAggregator.h"
+#include "JsonRpcServiceUtil.h"
+
+namespace orb
+{
+namespace networkServices
+{
+// Values of the status param of org.hbbtv.ipplayback.statusUpdate
+const int IP_PLAYBACK_STATUS_PRESENTING = 2;
+const int IP_PLAYBACK_STATUS_STOPPED = 3;
+const std::string JSONRPC_STATUS_KEY = "status";
+
+static int GetSessionId(const Json::Value &params)
+{
+    if (params.isObject() && params[JSONRPC_SESSION_ID_KEY].isInt())
+    {
+        return params[JSONRPC_SESSION_ID_KEY].asInt();
+    }
+    return 0;
+}
+
+static bool IsStopped(IPPlaybackStateAggregator::UpdateType type, const Json::Value &params)
+{
+    return type == IPPlaybackStateAggregator::UpdateType::Status && params.isObject() &&
+           params[JSONRPC_STATUS_KEY].isInt() &&
+           params[JSONRPC_STATUS_KEY].asInt() == IP_PLAYBACK_STATUS_STOPPED;
+}
+
+IPPlaybackStateAggregator::IPPlaybackStateAggregator(ForwardCallback forward) :
+    m_forward(std::move(forward)),
+    m_interval(0),
+    m_stop(false)
+{
+}
+
+IPPlaybackStateAggregator::~IPPlaybackStateAggregator()
+{
+    Stop();
+}
+
+/**
+ * Set the minimum interval between forwards of the changes for a session.
+ *
+ * @param interval The interval, or 0 to forward every update as it arrives.
+ */
+void IPPlaybackStateAggregator::SetInterval(std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_interval = interval;
+    m_condition.notify_all();
+}
+
+/**
+ * Post an update from the IP player.
+ *
+ * @param type The kind of update.
+ * @param params The params of the update request.
+ */
+void IPPlaybackStateAggregator::Update(UpdateType type, const Json::Value &params)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_interval.count() <= 0 && m_sessions.empty())
+    {
+        m_forward(type, params);
+        return;
+    }
+
+    int sessionId = GetSessionId(params);
+    SessionState &state = m_sessions[sessionId];
+    int index = static_cast<int>(type);
+    if (params == state.forwarded[index])
+    {
+        // Back to the state last forwarded, so there is nothing to forward
+        state.hasPending[index] = false;
+    }
+    else
+    {
+        state.pending[index] = params;
+        state.hasPending[index] = true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (IsDiscreteTransition(type, params))
+    {
+        ForwardPending(state, now);
+        if (IsStopped(type, params))
+        {
+            m_sessions.erase(sessionId);
+        }
+    }
+    else if (now - state.lastForward >= m_interval)
+    {
+        ForwardPending(state, now);
+    }
+    else if (!state.flushScheduled)
+    {
+        state.flushScheduled = true;
+        if (!m_flush_thread.joinable())
+        {
+            m_flush_thread = std::thread(&IPPlaybackStateAggregator::FlushLoop, this);
+        }
+        m_condition.notify_all();
+    }
+    EvictIdleSessions(now);
+}
+
+/**
+ * Forward the changes held for every session and stop the flush thread.
+ */
+void IPPlaybackStateAggregator::Stop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_flush_thread.joinable())
+    {
+        m_stop = true;
+        m_condition.notify_all();
+        std::thread thread = std::move(m_flush_thread);
+        lock.unlock();
+        thread.join();
+        lock.lock();
+        m_stop = false;
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (auto &session : m_sessions)
+    {
+        ForwardPending(session.second, now);
+    }
+    m_sessions.clear();
+}
+
+/**
+ * Get the number of sessions whose state is kept.
+ */
+size_t IPPlaybackStateAggregator::GetSessionCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sessions.size();
+}
+
+bool IPPlaybackStateAggregator::IsDiscreteTransition(UpdateType type, const Json::Value &params)
+{
+    if (type != UpdateType::Status || !params.isObject())
+    {
+        return false;
+    }
+    if (params.isMember(JSONRPC_ERROR_KEY))
+    {
+        return true;
+    }
+    if (!params[JSONRPC_STATUS_KEY].isInt())
+    {
+        return false;
+    }
+    int status = params[JSONRPC_STATUS_KEY].asInt();
+    return status == IP_PLAYBACK_STATUS_PRESENTING || status == IP_PLAYBACK_STATUS_STOPPED;
+}
+
+// Forward the changes held for a session, components and media position before status so that a
+// status transition follows the state it applies to. Called with m_mutex locked.
+void IPPlaybackStateAggregator::ForwardPending(SessionState &state,
+    std::chrono::steady_clock::time_point now)
+{
+    static const UpdateType order[] = {
+        UpdateType::Components, UpdateType::MediaPosition, UpdateType::Status
+    };
+    for (UpdateType type : order)
+    {
+        int index = static_cast<int>(type);
+        if (state.hasPending[index])
+        {
+            state.forwarded[index] = std::move(state.pending[index]);
+            state.pending[index] = Json::Value();
+            state.hasPending[index] = false;
+            m_forward(type, state.forwarded[index]);
+        }
+    }
+    state.lastForward = now;
+    state.flushScheduled = false;
+}
+
+// Forget the sessions with nothing held that were last forwarded more than the interval ago, at
+// most once per interval. Changes are only held while a flush is scheduled. Called with m_mutex
+// locked.
+void IPPlaybackStateAggregator::EvictIdleSessions(std::chrono::steady_clock::time_point now)
+{
+    if (now - m_last_eviction < m_interval)
+    {
+        return;
+    }
+    m_last_eviction = now;
+    for (auto it = m_sessions.begin(); it != m_sessions.end();)
+    {
+        if (!it->second.flushScheduled && now - it->second.lastForward >= m_interval)
+        {
+            it = m_sessions.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void IPPlaybackStateAggregator::FlushLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto next = std::chrono::steady_clock::time_point::max();
+        for (auto &session : m_sessions)
+        {
+            SessionState &state = session.second;
+            if (!state.flushScheduled)
+            {
+                continue;
+            }
+            auto due = state.lastForward + m_interval;
+            if (due <= now)
+            {
+                ForwardPending(state, now);
+            }
+            else if (due < next)
+            {
+                next = due;
+            }
+        }
+        if (next == std::chrono::steady_clock::time_point::max())
+        {
+            m_condition.wait(lock);
+        }
+        else
+        {
+            m_condition.wait_until(lock, next);
+        }
+    }
+}
+} // namespace networkServices
+} // namespace orb
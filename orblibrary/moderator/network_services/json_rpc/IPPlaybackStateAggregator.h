@@ -0,0 +1,114 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBS_NS_IP_PLAYBACK_STATE_AGGREGATOR_H
+#define OBS_NS_IP_PLAYBACK_STATE_AGGREGATOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <json/json.h>
+
+namespace orb {
+namespace networkServices {
+
+/**
+ * Coalesces the status, media position and components updates posted by an IP player, so that
+ * they are forwarded for each session at most once per interval.
+ *
+ * The latest update of each kind is kept for each session. Updates that do not change the state
+ * are dropped, and changes are forwarded when the interval since the last forward has passed,
+ * either as they arrive or from a flush thread. A status update to PRESENTING or STOPPED, or
+ * reporting an error, is forwarded immediately, after any changes still held for the session.
+ * A session is forgotten when it stops, or when nothing is held for it and it was last forwarded
+ * more than the interval ago, after which its next update is forwarded as for a new session.
+ */
+class IPPlaybackStateAggregator {
+public:
+    enum class UpdateType
+    {
+        Status,
+        MediaPosition,
+        Components
+    };
+
+    static constexpr int UPDATE_TYPE_COUNT = 3;
+
+    typedef std::function<void(UpdateType type, const Json::Value &params)> ForwardCallback;
+
+    /**
+     * @param forward Called with each update to forward. Called with the aggregator locked, from
+     * the thread posting an update or from the flush thread, so must not call the aggregator.
+     */
+    explicit IPPlaybackStateAggregator(ForwardCallback forward);
+
+    ~IPPlaybackStateAggregator();
+
+    /**
+     * Set the minimum interval between forwards of the changes for a session. Default value is
+     * 0, every update is forwarded as it arrives.
+     */
+    void SetInterval(std::chrono::milliseconds interval);
+
+    /**
+     * Post an update from the IP player.
+     *
+     * @param type The kind of update.
+     * @param params The params of the update request.
+     */
+    void Update(UpdateType type, const Json::Value &params);
+
+    /**
+     * Forward the changes held for every session and stop the flush thread.
+     */
+    void Stop();
+
+    /**
+     * Get the number of sessions whose state is kept.
+     */
+    size_t GetSessionCount();
+
+private:
+    struct SessionState
+    {
+        Json::Value forwarded[UPDATE_TYPE_COUNT];
+        Json::Value pending[UPDATE_TYPE_COUNT];
+        bool hasPending[UPDATE_TYPE_COUNT] = {};
+        std::chrono::steady_clock::time_point lastForward;
+        bool flushScheduled = false;
+    };
+
+    static bool IsDiscreteTransition(UpdateType type, const Json::Value &params);
+    void ForwardPending(SessionState &state, std::chrono::steady_clock::time_point now);
+    void EvictIdleSessions(std::chrono::steady_clock::time_point now);
+    void FlushLoop();
+
+    ForwardCallback m_forward;
+    std::chrono::milliseconds m_interval;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::unordered_map<int, SessionState> m_sessions;
+    std::chrono::steady_clock::time_point m_last_eviction;
+    std::thread m_flush_thread;
+    bool m_stop;
+};
+} // namespace networkServices
+} // namespace orb
+
+#endif // OBS_NS_IP_PLAYBACK_STATE_AGGREGATOR_H
@@ -9,7 +9,10 @@
 #include "third_party/orb/logging/include/log.h"
 #include "JsonRpcService.h"
 #include "JsonUtil.h"
+#include "json_codec.h"
+#include "Metrics.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -18,6 +21,8 @@ namespace networkServices {
 
 const int sizeOfAccessibilityFeature = ACCESSIBILITY_FEATURE_IDS.size();
 
+thread_local JsonRpcService::PendingBatch *JsonRpcService::m_handling_batch = nullptr;
+
 JsonRpcService::JsonRpcService(
     int port,
     const std::string &endpoint,
@@ -25,13 +30,28 @@ JsonRpcService::JsonRpcService(
     WebSocketService("JsonRpcService", port, false, "lo"),
     m_endpoint(endpoint),
     m_sessionCallback(std::move(sessionCallback)),
-    m_opAppEnabled(true)
+    m_worker_thread_count(0),
+    m_stop_workers(false),
+    m_method_concurrency_limits(),
+    m_method_latency(),
+    m_opAppEnabled(true),
+    m_ip_playback_state([this](IPPlaybackStateAggregator::UpdateType type,
+        const Json::Value &params) {
+        ForwardIPPlaybackUpdate(type, params);
+    })
 {
     LOGI("JsonRpcService::JsonRpcService: endpoint=" << m_endpoint << ", port=" << port);
+    m_ip_playback_state.SetInterval(
+        std::chrono::milliseconds(DEFAULT_IP_PLAYBACK_UPDATE_INTERVAL_MS));
     RegisterJsonRPCMethods();
     RegisterSupportedMethods();
 }
 
+JsonRpcService::~JsonRpcService()
+{
+    StopWorkerThreads();
+}
+
 void JsonRpcService::SetOpAppEnabled(bool enabled) {
     LOGI("Set Operator Application enabled: " << enabled);
     m_opAppEnabled = enabled;
@@ -50,25 +70,139 @@ bool JsonRpcService::OnConnection(WebSocketConnection *connection)
     return true;
 }
 
-void JsonRpcService::OnMessageReceived(WebSocketConnection *connection, const std::string &text)
+void JsonRpcService::OnMessageReceived(WebSocketConnection *connection, std::string_view text)
 {
     int connectionId = connection->Id();
+    std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now();
     LOGD("Message received: connection=" << connectionId << ", text=" << text);
     // Parse request
     Json::Value obj;
-    Json::Reader reader;
+    JsonCodec::RequestEnvelope envelope;
     JsonRpcStatus status = JsonRpcStatus::UNKNOWN;
 
-    if (!reader.parse(text, obj))
+    if (JsonCodec::ScanRequestEnvelope(text, envelope))
+    {
+        // Common case: build the request from its members. The params of a method that cannot
+        // be called are not parsed, as the request is rejected below.
+        if (envelope.hasVersion)
+        {
+            obj[JSONRPC_VERSION_KEY] = envelope.version;
+        }
+        if (envelope.id != nullptr &&
+            !JsonCodec::Parse(envelope.id, envelope.id + envelope.idLength, obj[JSONRPC_ID_KEY]))
+        {
+            status = JsonRpcStatus::PARSE_ERROR;
+            return handleError(connectionId, status, obj);
+        }
+        if (envelope.hasMethod)
+        {
+            obj[JSONRPC_METHOD_KEY] = envelope.method;
+            if (envelope.params != nullptr &&
+                IsMethodNegotiated(connectionId, GetMethodId(envelope.method), true) &&
+                !JsonCodec::Parse(envelope.params, envelope.params + envelope.paramsLength,
+                    obj[JSONRPC_PARAMS_KEY]))
+            {
+                status = JsonRpcStatus::PARSE_ERROR;
+                return handleError(connectionId, status, obj);
+            }
+        }
+    }
+    else if (!JsonCodec::Parse(text.data(), text.data() + text.size(), obj))
     {
         status = JsonRpcStatus::PARSE_ERROR;
         return handleError(connectionId, status, obj);
     }
 
+    if (obj.isArray())
+    {
+        // Batch: the requests are handled on their own, and their responses sent in one array
+        if (obj.empty())
+        {
+            status = JsonRpcStatus::INVALID_REQUEST;
+            return handleError(connectionId, status, obj);
+        }
+        auto batch = std::make_shared<PendingBatch>();
+        batch->connectionId = connectionId;
+        batch->responses = Json::Value(Json::arrayValue);
+        batch->remaining = 1;
+        m_handling_batch = batch.get();
+        for (Json::Value::ArrayIndex i = 0; i < obj.size(); i++)
+        {
+            HandleRequest(connectionId, std::move(obj[i]), received, batch);
+        }
+        m_handling_batch = nullptr;
+        FinishBatchRequest(batch, "", false);
+        return;
+    }
+    HandleRequest(connectionId, std::move(obj), received);
+}
+
+void JsonRpcService::HandleRequest(int connectionId, Json::Value &&obj,
+    std::chrono::steady_clock::time_point received, const std::shared_ptr<PendingBatch> &batch)
+{
+    std::string batchId = batch ? AddBatchRequest(obj, batch) : "";
+    int methodId = -1;
+    const MethodHandler *handler = FindHandler(connectionId, obj, methodId);
+    if (handler == nullptr)
+    {
+        return FinishBatchRequest(batch, batchId, false);
+    }
+
+    if (m_worker_thread_count > 0 && methodId >= 0 && !m_inline_methods.test(methodId))
+    {
+        if (m_worker_threads.empty())
+        {
+            StartWorkerThreads();
+        }
+        std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+        m_pending_requests.push_back({connectionId, methodId, handler, std::move(obj), received,
+                                      batch, batchId});
+        m_dispatch_condition.notify_one();
+        return;
+    }
+
+    if (methodId >= 0)
+    {
+        std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+        m_method_stats[methodId].inFlight++;
+    }
+    JsonRpcStatus status = (*handler)(connectionId, obj);
+    if (methodId >= 0)
+    {
+        std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+        RecordMethodCompleted(methodId, received);
+    }
+    ReportStatus(connectionId, status, obj);
+    FinishBatchRequest(batch, batchId,
+        status == JsonRpcStatus::SUCCESS && methodId >= 0 && m_deferred_methods.test(methodId));
+}
+
+/**
+ * Validate the request and find the handler of its method, or respond with an error.
+ *
+ * @param connectionId The connection ID.
+ * @param obj The request.
+ * @param methodId Set to the ID of the method, or -1 if the terminal does not support it.
+ *
+ * @return The handler, or nullptr if the request was answered with an error.
+ */
+const JsonRpcService::MethodHandler *JsonRpcService::FindHandler(int connectionId,
+    const Json::Value &obj, int &methodId)
+{
+    JsonRpcStatus status = JsonRpcStatus::UNKNOWN;
+
+    if (!obj.isObject())
+    {
+        status = JsonRpcStatus::INVALID_REQUEST;
+        handleError(connectionId, status, obj);
+        return nullptr;
+    }
+
     if (!JsonUtil::HasParam(obj, JSONRPC_VERSION_KEY, Json::stringValue) || obj[JSONRPC_VERSION_KEY] != "2.0")
     {
         status = JsonRpcStatus::INVALID_REQUEST;
-        return handleError(connectionId, status, obj);
+        handleError(connectionId, status, obj);
+        return nullptr;
     }
 
     //case of error message
@@ -77,7 +211,8 @@ void JsonRpcService::OnMessageReceived(WebSocketConnection *connection, const st
         status = JsonRpcService::ReceiveError(connectionId, obj);
         if (status != JsonRpcStatus::SUCCESS)
         {
-            return handleError(connectionId, status, obj);
+            handleError(connectionId, status, obj);
+            return nullptr;
         }
     }
 
@@ -86,16 +221,11 @@ void JsonRpcService::OnMessageReceived(WebSocketConnection *connection, const st
     if (JsonUtil::HasParam(obj, JSONRPC_METHOD_KEY, Json::stringValue))
     {
         method = obj[JSONRPC_METHOD_KEY].asString();
-        Json::Value negotiateMethods = GetConnectionData(connectionId,
-            ConnectionDataType::NegotiateMethodsAppToTerminal);
-        if (!negotiateMethods.isArray())
-        {
-            LOGE("Warning, connection data lost, parameter has wrong type.");
-        }
-        if (!JsonUtil::IsMethodInJsonArray(negotiateMethods, method))
+        if (!IsMethodNegotiated(connectionId, GetMethodId(method), true))
         {
             status = JsonRpcStatus::METHOD_NOT_FOUND;
-            return handleError(connectionId, status, obj);
+            handleError(connectionId, status, obj);
+            return nullptr;
         }
     } else {
         if (JsonUtil::HasJsonParam(obj, JSONRPC_RESULT_KEY) &&
@@ -109,20 +239,137 @@ void JsonRpcService::OnMessageReceived(WebSocketConnection *connection, const st
             //cannot find method in result parameter
             LOGE("method not found in result parameter: " << method);
             status = JsonRpcStatus::INVALID_REQUEST;
-            return handleError(connectionId, status, obj);
+            handleError(connectionId, status, obj);
+            return nullptr;
         }
     }
 
     auto it = m_json_rpc_methods.find(method);
-    if (it != m_json_rpc_methods.end())
+    if (it == m_json_rpc_methods.end())
     {
-        status = it->second(connectionId, obj);
+        status = JsonRpcStatus::METHOD_NOT_FOUND;
+        ReportStatus(connectionId, status, obj);
+        return nullptr;
     }
-    else
+    methodId = GetMethodId(method);
+    return &it->second;
+}
+
+/**
+ * Add a request to a batch. The batch waits until the request has been handled and, if it has an
+ * ID, for its response.
+ *
+ * @param obj The request.
+ * @param batch The batch.
+ *
+ * @return The encoded ID whose response the batch waits for, or "" if it does not wait for one.
+ */
+std::string JsonRpcService::AddBatchRequest(const Json::Value &obj,
+    const std::shared_ptr<PendingBatch> &batch)
+{
+    std::string id;
+    if (obj.isObject() && obj.isMember(JSONRPC_METHOD_KEY))
     {
-        status = JsonRpcStatus::METHOD_NOT_FOUND;
+        id = JsonRpcServiceUtil::GetId(obj);
+    }
+    std::lock_guard<std::mutex> lock(m_batch_mutex);
+    batch->remaining++;
+    if (!id.empty() && m_batch_requests.emplace(std::make_pair(batch->connectionId, id),
+        batch).second)
+    {
+        batch->remaining++;
+        return id;
+    }
+    return "";
+}
+
+/**
+ * Called once a request of a batch has been handled, and once the batch has been received. The
+ * batch is sent when nothing remains.
+ *
+ * @param batch The batch, or nullptr if the request was not in a batch.
+ * @param id The ID returned by AddBatchRequest.
+ * @param awaitResponse Whether the response is still to come from the session callback.
+ */
+void JsonRpcService::FinishBatchRequest(const std::shared_ptr<PendingBatch> &batch,
+    const std::string &id, bool awaitResponse)
+{
+    if (!batch)
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_batch_mutex);
+    if (!id.empty() && !awaitResponse)
+    {
+        // No response is coming, for example the request was a notification with an ID
+        auto it = m_batch_requests.find(std::make_pair(batch->connectionId, id));
+        if (it != m_batch_requests.end() && it->second == batch)
+        {
+            m_batch_requests.erase(it);
+            batch->remaining--;
+        }
+    }
+    if (--batch->remaining == 0)
+    {
+        SendBatch(*batch, lock);
+    }
+}
+
+/**
+ * Add the response to the batch that is waiting for it, if any.
+ *
+ * @param connectionId The connection ID.
+ * @param response The response.
+ *
+ * @return true if the response was added to a batch, otherwise it is sent on its own.
+ */
+bool JsonRpcService::AddBatchResponse(int connectionId, const Json::Value &response)
+{
+    if (!response.isMember(JSONRPC_RESULT_KEY) && !response.isMember(JSONRPC_ERROR_KEY))
+    {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(m_batch_mutex);
+    auto it = m_batch_requests.find(std::make_pair(connectionId,
+        JsonRpcServiceUtil::EncodeJsonId(response[JSONRPC_ID_KEY])));
+    if (it != m_batch_requests.end())
+    {
+        std::shared_ptr<PendingBatch> batch = std::move(it->second);
+        m_batch_requests.erase(it);
+        batch->responses.append(response);
+        if (--batch->remaining == 0)
+        {
+            SendBatch(*batch, lock);
+        }
+        return true;
+    }
+    // Errors without an ID, sent while a request of the batch is being handled
+    if (m_handling_batch != nullptr && m_handling_batch->connectionId == connectionId)
+    {
+        m_handling_batch->responses.append(response);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Send the responses of a finished batch. A batch of notifications has no response.
+ *
+ * @param batch The batch.
+ * @param lock The lock on m_batch_mutex, released before sending.
+ */
+void JsonRpcService::SendBatch(PendingBatch &batch, std::unique_lock<std::mutex> &lock)
+{
+    Json::Value responses = std::move(batch.responses);
+    lock.unlock();
+    if (!responses.empty())
+    {
+        SendTextToClient(batch.connectionId, JsonCodec::Write(responses));
     }
+}
 
+void JsonRpcService::ReportStatus(int connectionId, JsonRpcStatus status, const Json::Value& obj)
+{
     if (status == JsonRpcStatus::NOTIFICATION_ERROR)
     {
         LOGE("Error in notification message");
@@ -150,56 +397,230 @@ void JsonRpcService::OnDisconnected(WebSocketConnection *connection)
 {
     std::lock_guard<std::recursive_mutex> lock(mConnectionsMutex);
     m_connectionData.erase(connection->Id());
+    UpdateNotifySubscribers();
+
+    // Drop the batches waiting for responses
+    {
+        std::lock_guard<std::mutex> batchLock(m_batch_mutex);
+        auto first = m_batch_requests.lower_bound(std::make_pair(connection->Id(), std::string()));
+        auto last = first;
+        while (last != m_batch_requests.end() && last->first.first == connection->Id())
+        {
+            ++last;
+        }
+        m_batch_requests.erase(first, last);
+    }
+
+    // Drop requests from the connection that are waiting for a worker thread
+    std::lock_guard<std::mutex> dispatchLock(m_dispatch_mutex);
+    m_pending_requests.erase(std::remove_if(m_pending_requests.begin(), m_pending_requests.end(),
+        [connection](const PendingRequest &request) {
+            return request.connectionId == connection->Id();
+        }), m_pending_requests.end());
 }
 
 void JsonRpcService::OnServiceStopped()
 {
+    StopWorkerThreads();
+    m_ip_playback_state.Stop();
+}
+
+void JsonRpcService::SetWorkerThreadCount(int count)
+{
+    LOGI("Set worker thread count: " << count);
+    m_worker_thread_count = count;
+}
+
+void JsonRpcService::SetIPPlaybackUpdateInterval(int intervalMs)
+{
+    LOGI("Set IP playback update interval: " << intervalMs << "ms");
+    m_ip_playback_state.SetInterval(std::chrono::milliseconds(intervalMs));
+}
+
+void JsonRpcService::SetMethodConcurrencyLimit(const std::string &method, int limit)
+{
+    int methodId = GetMethodId(method);
+    if (methodId < 0)
+    {
+        LOGE("Unknown method, cannot set concurrency limit: " << method);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+    m_method_concurrency_limits[methodId] = limit;
+}
+
+JsonRpcService::MethodStats JsonRpcService::GetMethodStats(const std::string &method)
+{
+    int methodId = GetMethodId(method);
+    if (methodId < 0)
+    {
+        return MethodStats();
+    }
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+    return m_method_stats[methodId];
+}
+
+void JsonRpcService::StartWorkerThreads()
+{
+    for (int i = 0; i < m_worker_thread_count; i++)
+    {
+        m_worker_threads.emplace_back(&JsonRpcService::WorkerLoop, this);
+    }
+}
+
+void JsonRpcService::StopWorkerThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+        m_stop_workers = true;
+        m_pending_requests.clear();
+    }
+    m_dispatch_condition.notify_all();
+    for (std::thread &thread : m_worker_threads)
+    {
+        thread.join();
+    }
+    m_worker_threads.clear();
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+    m_stop_workers = false;
+}
+
+/**
+ * Handle queued requests until the worker threads are stopped. The first queued request whose
+ * method is below its concurrency limit is handled next, so responses may be sent in any order.
+ */
+void JsonRpcService::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_dispatch_mutex);
+    while (true)
+    {
+        auto next = m_pending_requests.end();
+        m_dispatch_condition.wait(lock, [this, &next] {
+            if (m_stop_workers)
+            {
+                return true;
+            }
+            next = std::find_if(m_pending_requests.begin(), m_pending_requests.end(),
+                [this](const PendingRequest &request) {
+                    int limit = m_method_concurrency_limits[request.methodId];
+                    return limit <= 0 || m_method_stats[request.methodId].inFlight < limit;
+                });
+            return next != m_pending_requests.end();
+        });
+        if (m_stop_workers)
+        {
+            return;
+        }
+        PendingRequest request = std::move(*next);
+        m_pending_requests.erase(next);
+        m_method_stats[request.methodId].inFlight++;
+        lock.unlock();
+
+        m_handling_batch = request.batch.get();
+        JsonRpcStatus status = (*request.handler)(request.connectionId, request.obj);
+        ReportStatus(request.connectionId, status, request.obj);
+        m_handling_batch = nullptr;
+        FinishBatchRequest(request.batch, request.batchId,
+            status == JsonRpcStatus::SUCCESS && m_deferred_methods.test(request.methodId));
+
+        lock.lock();
+        RecordMethodCompleted(request.methodId, request.received);
+    }
+}
+
+/**
+ * Must be called with m_dispatch_mutex held.
+ *
+ * @param methodId The ID of the method whose handler returned.
+ * @param received When the request was received.
+ */
+void JsonRpcService::RecordMethodCompleted(int methodId,
+    std::chrono::steady_clock::time_point received)
+{
+    MethodStats &stats = m_method_stats[methodId];
+    stats.inFlight--;
+    stats.calls++;
+    if (m_method_latency[methodId] == nullptr)
+    {
+        m_method_latency[methodId] = &metrics::Registry::Instance().GetHistogram(
+            GetLatencyMetricName(m_method_names[methodId]),
+            "Time from receiving a " + m_method_names[methodId] +
+            " request to its handler returning");
+    }
+    m_method_latency[methodId]->Record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - received).count());
+}
+
+/**
+ * @param method The method name, e.g. org.hbbtv.af.featureSupportInfo.
+ *
+ * @return The metric name, e.g. orb_jsonrpc_org_hbbtv_af_featureSupportInfo_microseconds.
+ */
+std::string JsonRpcService::GetLatencyMetricName(const std::string &method)
+{
+    std::string name = "orb_jsonrpc_" + method + "_microseconds";
+    std::replace(name.begin(), name.end(), '.', '_');
+    return name;
 }
 
 void JsonRpcService::RegisterSupportedMethods()
 {
-    m_supported_methods_app_to_terminal.insert(MD_NEGOTIATE_METHODS);
-    m_supported_methods_app_to_terminal.insert(MD_SUBSCRIBE);
-    m_supported_methods_app_to_terminal.insert(MD_UNSUBSCRIBE);
-    m_supported_methods_app_to_terminal.insert(MD_AF_FEATURE_SUPPORT_INFO);
-    m_supported_methods_app_to_terminal.insert(MD_AF_FEATURE_SETTINGS_QUERY);
-    m_supported_methods_app_to_terminal.insert(MD_AF_FEATURE_SUPPRESS);
-    m_supported_methods_app_to_terminal.insert(MD_AF_DIALOGUE_ENHANCEMENT_OVERRIDE);
-    m_supported_methods_app_to_terminal.insert(MD_AF_TRIGGER_RESPONSE_TO_USER_ACTION);
-    m_supported_methods_app_to_terminal.insert(MD_VOICE_READY);
-    m_supported_methods_app_to_terminal.insert(MD_STATE_MEDIA);
-
-    m_supported_methods_terminal_to_app.insert(MD_NOTIFY);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_PAUSE);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_PLAY);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_FAST_FORWARD);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_FAST_REVERSE);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_STOP);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_SEEK_CONTENT);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_SEEK_RELATIVE);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_SEEK_LIVE);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_MEDIA_SEEK_WALLCLOCK);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_SEARCH);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_DISPLAY);
-    m_supported_methods_terminal_to_app.insert(MD_INTENT_PLAYBACK);
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_NEGOTIATE_METHODS));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_SUBSCRIBE));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_UNSUBSCRIBE));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_AF_FEATURE_SUPPORT_INFO));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_AF_FEATURE_SETTINGS_QUERY));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_AF_FEATURE_SUPPRESS));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_AF_DIALOGUE_ENHANCEMENT_OVERRIDE));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_AF_TRIGGER_RESPONSE_TO_USER_ACTION));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_VOICE_READY));
+    m_supported_methods_app_to_terminal.set(InternMethod(MD_STATE_MEDIA));
+
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_NOTIFY));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_PAUSE));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_PLAY));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_FAST_FORWARD));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_FAST_REVERSE));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_STOP));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_SEEK_CONTENT));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_SEEK_RELATIVE));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_SEEK_LIVE));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_MEDIA_SEEK_WALLCLOCK));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_SEARCH));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_DISPLAY));
+    m_supported_methods_terminal_to_app.set(InternMethod(MD_INTENT_PLAYBACK));
 
     // OPAPP ==> TERMINAL
-    m_supported_methods_opapp_to_terminal.insert(MD_IPPLAYBACK_STATUS_UPDATE);
-    m_supported_methods_opapp_to_terminal.insert(MD_IPPLAYBACK_MEDIA_POSITION_UPDATE);
-    m_supported_methods_opapp_to_terminal.insert(MD_IPPLAYBACK_SET_COMPONENTS);
-    m_supported_methods_opapp_to_terminal.insert(MD_IPPLAYBACK_SET_TIMELINE_MAPPING);
-    m_supported_methods_opapp_to_terminal.insert(MD_IPPLAYBACK_SET_PRESENT_FOLLOWING);
+    m_supported_methods_opapp_to_terminal.set(InternMethod(MD_IPPLAYBACK_STATUS_UPDATE));
+    m_supported_methods_opapp_to_terminal.set(InternMethod(MD_IPPLAYBACK_MEDIA_POSITION_UPDATE));
+    m_supported_methods_opapp_to_terminal.set(InternMethod(MD_IPPLAYBACK_SET_COMPONENTS));
+    m_supported_methods_opapp_to_terminal.set(InternMethod(MD_IPPLAYBACK_SET_TIMELINE_MAPPING));
+    m_supported_methods_opapp_to_terminal.set(InternMethod(MD_IPPLAYBACK_SET_PRESENT_FOLLOWING));
     // TERMINAL ==> OPAPP
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_SELECT_CHANNEL);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_STOP);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_PLAY);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_SET_VIDEO_WINDOW);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_SET_RELATIVE_VOLUME);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_PAUSE);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_RESUME);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_SEEK);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_SELECT_COMPONENTS);
-    m_supported_methods_terminal_to_opapp.insert(MD_IPPLAYER_RESOLVE_TIMELINE);
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_SELECT_CHANNEL));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_STOP));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_PLAY));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_SET_VIDEO_WINDOW));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_SET_RELATIVE_VOLUME));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_PAUSE));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_RESUME));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_SEEK));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_SELECT_COMPONENTS));
+    m_supported_methods_terminal_to_opapp.set(InternMethod(MD_IPPLAYER_RESOLVE_TIMELINE));
+
+    m_notify_method_id = GetMethodId(MD_NOTIFY);
+
+    // These change which methods a connection may call next, so they are handled in order
+    m_inline_methods.set(GetMethodId(MD_NEGOTIATE_METHODS));
+    m_inline_methods.set(GetMethodId(MD_SUBSCRIBE));
+    m_inline_methods.set(GetMethodId(MD_UNSUBSCRIBE));
+
+    // These are answered later, through the session callback
+    m_deferred_methods.set(GetMethodId(MD_AF_FEATURE_SUPPORT_INFO));
+    m_deferred_methods.set(GetMethodId(MD_AF_FEATURE_SETTINGS_QUERY));
+    m_deferred_methods.set(GetMethodId(MD_AF_FEATURE_SUPPRESS));
+    m_deferred_methods.set(GetMethodId(MD_AF_DIALOGUE_ENHANCEMENT_OVERRIDE));
+    m_deferred_methods.set(GetMethodId(MD_AF_TRIGGER_RESPONSE_TO_USER_ACTION));
 }
 
 void JsonRpcService::RegisterJsonRPCMethods()
@@ -1264,25 +1685,42 @@ std::string JsonRpcService::GenerateId(int connectionId)
 void JsonRpcService::GetNotifyConnectionIds(std::vector<int> &result,
     const int msgTypeIndex)
 {
-    std::string suffix = "PrefChange";
-    std::string msgType = ACCESSIBILITY_FEATURE_NAMES.at(msgTypeIndex) + suffix;
-    std::vector<int> connectionIds = GetAllConnectionIds();
-    for (int i : connectionIds)
+    if (msgTypeIndex < 0 || msgTypeIndex >= static_cast<int>(MAX_ACCESSIBILITY_FEATURES))
+    {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(mConnectionsMutex);
+    result = m_notify_subscribers[msgTypeIndex];
+}
+
+/**
+ * Rebuild the lists of connections to notify of each accessibility feature preference change.
+ * Called with mConnectionsMutex held whenever the subscriptions or negotiated methods of a
+ * connection change.
+ */
+void JsonRpcService::UpdateNotifySubscribers()
+{
+    for (size_t feature = 0; feature < MAX_ACCESSIBILITY_FEATURES; feature++)
+    {
+        m_notify_subscribers[feature].clear();
+    }
+    if (m_notify_method_id < 0)
+    {
+        return;
+    }
+    for (const auto& entry : m_connectionData)
     {
-        Json::Value subscribedMethods = GetConnectionData(i,
-            ConnectionDataType::SubscribedMethods);
-        Json::Value negotiateMethods = GetConnectionData(i,
-            ConnectionDataType::NegotiateMethodsTerminalToApp);
-        if (!subscribedMethods.isArray() || !negotiateMethods.isArray())
+        const ConnectionData& connectionData = entry.second;
+        if (!connectionData.negotiateMethodsTerminalToApp.test(m_notify_method_id))
         {
-            LOGE("Warning, connection data lost, parameter has wrong type.");
             continue;
         }
-
-        if (JsonUtil::IsMethodInJsonArray(subscribedMethods, msgType) &&
-            JsonUtil::IsMethodInJsonArray(negotiateMethods, MD_NOTIFY))
+        for (size_t feature = 0; feature < MAX_ACCESSIBILITY_FEATURES; feature++)
         {
-            result.push_back(i);
+            if (connectionData.subscribedFeatures.test(feature))
+            {
+                m_notify_subscribers[feature].push_back(entry.first);
+            }
         }
     }
 }
@@ -1301,6 +1739,86 @@ void JsonRpcService::RegisterMethod(const std::string &name, JsonRpcMethod metho
         std::placeholders::_2);
 }
 
+/**
+ * Assign the next method ID to the method name, if it does not already have one.
+ *
+ * @param name The method name.
+ *
+ * @return The ID of the method.
+ */
+int JsonRpcService::InternMethod(const std::string& name)
+{
+    auto it = m_method_ids.find(name);
+    if (it != m_method_ids.end())
+    {
+        return it->second;
+    }
+    int methodId = static_cast<int>(m_method_names.size());
+    if (methodId >= static_cast<int>(MAX_METHODS))
+    {
+        LOGE("Too many methods, cannot register: " << name);
+        return -1;
+    }
+    m_method_ids[name] = methodId;
+    m_method_names.push_back(name);
+    return methodId;
+}
+
+/**
+ * @param name The method name.
+ *
+ * @return The ID of the method, or -1 if the terminal does not support the method.
+ */
+int JsonRpcService::GetMethodId(const std::string& name) const
+{
+    auto it = m_method_ids.find(name);
+    return it != m_method_ids.end() ? it->second : -1;
+}
+
+/**
+ * @param methods The set of method IDs.
+ *
+ * @return The Json::arrayValue of the names of the methods.
+ */
+Json::Value JsonRpcService::GetMethodsInJsonArray(const MethodSet& methods) const
+{
+    Json::Value array(Json::arrayValue);
+    for (size_t methodId = 0; methodId < m_method_names.size(); methodId++)
+    {
+        if (methods.test(methodId))
+        {
+            array.append(m_method_names[methodId]);
+        }
+    }
+    return array;
+}
+
+/**
+ * Check whether the connection has negotiated the method in the given direction.
+ *
+ * @param connectionId The connection ID.
+ * @param methodId The method ID, or -1 for an unsupported method.
+ * @param isAppToTerminal The bool shows appToTerminal or terminalToApp.
+ *
+ * @return true if the method may be used, otherwise false.
+ */
+bool JsonRpcService::IsMethodNegotiated(int connectionId, int methodId, bool isAppToTerminal)
+{
+    if (methodId < 0)
+    {
+        return false;
+    }
+    std::lock_guard<std::recursive_mutex> lock(mConnectionsMutex);
+    auto it = m_connectionData.find(connectionId);
+    if (it == m_connectionData.end())
+    {
+        LOGE("Warning, connection id not found. connectionId: " << connectionId);
+        return false;
+    }
+    return isAppToTerminal ? it->second.negotiateMethodsAppToTerminal.test(methodId) :
+           it->second.negotiateMethodsTerminalToApp.test(methodId);
+}
+
 /**
  * This method takes a connection ID and a JSON response, sends the formatted
  * response message to the client with the specified connection ID.
@@ -1312,15 +1830,24 @@ void JsonRpcService::RegisterMethod(const std::string &name, JsonRpcMethod metho
 void JsonRpcService::SendJsonMessageToClient(int connectionId,
     const Json::Value &jsonResponse)
 {
-    Json::FastWriter writer;
-    std::string message = writer.write(jsonResponse);
+    if (AddBatchResponse(connectionId, jsonResponse))
+    {
+        return;
+    }
+    SendTextToClient(connectionId, JsonCodec::Write(jsonResponse));
+}
+
+/**
+ * @param connectionId The unique identifier of the client connection.
+ * @param message The serialised JSON message.
+ */
+void JsonRpcService::SendTextToClient(int connectionId, const std::string &message)
+{
     std::lock_guard<std::recursive_mutex> lock(mConnectionsMutex);
     WebSocketConnection *connection = GetConnection(connectionId);
     if (connection != nullptr)
     {
-        std::ostringstream oss;
-        oss << message;
-        connection->SendMessage(oss.str());
+        connection->SendMessage(message);
     }
 }
 
@@ -1436,9 +1963,14 @@ Json::Value JsonRpcService::FilterMethods(int connectionId,
     for (const auto& method : methodsList)
     {
         std::string methodName = method.asString();
+        int methodId = GetMethodId(methodName);
+        if (methodId < 0)
+        {
+            continue;
+        }
         if (isAppToTerminal &&
-            (JsonUtil::IsMethodInSet(m_supported_methods_app_to_terminal, methodName)
-            || (m_opAppEnabled && JsonUtil::IsMethodInSet(m_supported_methods_opapp_to_terminal, methodName))))
+            (m_supported_methods_app_to_terminal.test(methodId)
+            || (m_opAppEnabled && m_supported_methods_opapp_to_terminal.test(methodId))))
         {
             SetConnectionData(connectionId,
                 ConnectionDataType::NegotiateMethodsAppToTerminal,
@@ -1446,8 +1978,8 @@ Json::Value JsonRpcService::FilterMethods(int connectionId,
             newMethodsList.append(method);
         }
         else if (!isAppToTerminal &&
-            (JsonUtil::IsMethodInSet(m_supported_methods_terminal_to_app, methodName)
-            || (m_opAppEnabled && JsonUtil::IsMethodInSet(m_supported_methods_terminal_to_opapp, methodName))))
+            (m_supported_methods_terminal_to_app.test(methodId)
+            || (m_opAppEnabled && m_supported_methods_terminal_to_opapp.test(methodId))))
         {
             SetConnectionData(connectionId,
                 ConnectionDataType::NegotiateMethodsTerminalToApp,
@@ -1468,19 +2000,18 @@ Json::Value JsonRpcService::FilterMethods(int connectionId,
  */
 void JsonRpcService::CheckIntentMethod(std::vector<int> &result, const std::string& method)
 {
+    int methodId = GetMethodId(method);
     std::vector<int> connectionIds = GetAllConnectionIds();
     for (int i : connectionIds)
     {
         Json::Value voiceReadyJson = GetConnectionData(i, ConnectionDataType::VoiceReady);
-        Json::Value negotiateMethodsJson = GetConnectionData(i,
-            ConnectionDataType::NegotiateMethodsTerminalToApp);
 
-        if (!voiceReadyJson.isBool() || !negotiateMethodsJson.isArray())
+        if (!voiceReadyJson.isBool())
         {
             LOGE("Warning, connection data lost, parameter has wrong type.");
             continue;
         }
-        if (!voiceReadyJson.asBool() || !JsonUtil::IsMethodInJsonArray(negotiateMethodsJson, method))
+        if (!voiceReadyJson.asBool() || !IsMethodNegotiated(i, methodId, false))
         {
             continue;
         }
@@ -1580,7 +2111,8 @@ void JsonRpcService::InitialConnectionData(int connectionId)
 {
     std::lock_guard<std::recursive_mutex> lock(mConnectionsMutex);
     m_connectionData[connectionId].idCount = 0;
-    m_connectionData[connectionId].negotiateMethodsAppToTerminal.insert(MD_NEGOTIATE_METHODS);
+    m_connectionData[connectionId].negotiateMethodsAppToTerminal.set(
+        GetMethodId(MD_NEGOTIATE_METHODS));
 }
 
 /**
@@ -1603,17 +2135,42 @@ void JsonRpcService::SetConnectionData(int connectionId, ConnectionDataType type
     switch (type)
     {
         case ConnectionDataType::NegotiateMethodsAppToTerminal:
-            connectionData.negotiateMethodsAppToTerminal.insert(value.asString());
-            break;
         case ConnectionDataType::NegotiateMethodsTerminalToApp:
-            connectionData.negotiateMethodsTerminalToApp.insert(value.asString());
+        {
+            int methodId = GetMethodId(value.asString());
+            if (methodId < 0)
+            {
+                LOGE("Unsupported method: " << value.asString());
+                break;
+            }
+            if (type == ConnectionDataType::NegotiateMethodsAppToTerminal)
+            {
+                connectionData.negotiateMethodsAppToTerminal.set(methodId);
+            }
+            else
+            {
+                connectionData.negotiateMethodsTerminalToApp.set(methodId);
+                UpdateNotifySubscribers();
+            }
             break;
+        }
         case ConnectionDataType::SubscribedMethods:
-            connectionData.subscribedMethods.insert(value.asString());
-            break;
         case ConnectionDataType::UnsubscribedMethods:
-            connectionData.subscribedMethods.erase(value.asString());
+        {
+            // msgType values are the feature name followed by PrefChange
+            std::string msgType = value.asString();
+            int featureId = JsonRpcServiceUtil::GetAccessibilityFeatureId(
+                msgType.substr(0, msgType.length() - 10));
+            if (featureId < 0 || featureId >= static_cast<int>(MAX_ACCESSIBILITY_FEATURES))
+            {
+                LOGE("Unknown message type: " << msgType);
+                break;
+            }
+            connectionData.subscribedFeatures.set(featureId,
+                type == ConnectionDataType::SubscribedMethods);
+            UpdateNotifySubscribers();
             break;
+        }
         case ConnectionDataType::IdCount:
             connectionData.idCount = value.asInt();
             break;
@@ -1690,17 +2247,25 @@ Json::Value JsonRpcService::GetConnectionData(int connectionId, ConnectionDataTy
         {
             case ConnectionDataType::NegotiateMethodsAppToTerminal:
             {
-                value = JsonUtil::GetMethodsInJsonArray(connectionData.negotiateMethodsAppToTerminal);
+                value = GetMethodsInJsonArray(connectionData.negotiateMethodsAppToTerminal);
                 break;
             }
             case ConnectionDataType::NegotiateMethodsTerminalToApp:
             {
-                value = JsonUtil::GetMethodsInJsonArray(connectionData.negotiateMethodsTerminalToApp);
+                value = GetMethodsInJsonArray(connectionData.negotiateMethodsTerminalToApp);
                 break;
             }
             case ConnectionDataType::SubscribedMethods:
             {
-                value = JsonUtil::GetMethodsInJsonArray(connectionData.subscribedMethods);
+                value = Json::Value(Json::arrayValue);
+                for (size_t feature = 0; feature < MAX_ACCESSIBILITY_FEATURES; feature++)
+                {
+                    if (connectionData.subscribedFeatures.test(feature))
+                    {
+                        value.append(JsonRpcServiceUtil::GetAccessibilityFeatureName(feature) +
+                            "PrefChange");
+                    }
+                }
                 break;
             }
             case ConnectionDataType::UnsubscribedMethods:
@@ -1818,16 +2383,14 @@ JsonRpcService::JsonRpcStatus JsonRpcService::HandleIPPlaybackRequest(int connec
         return JsonRpcStatus::INVALID_PARAMS;
     }
 
-    Json::Value params = obj[JSONRPC_PARAMS_KEY];
+    const Json::Value &params = obj[JSONRPC_PARAMS_KEY];
     if (method == MD_IPPLAYBACK_STATUS_UPDATE) {
-        // Handle the IP playback status update request
-        m_sessionCallback->RequestIPPlaybackStatusUpdate(params);
+        // Status, media position and components updates are coalesced for each session
+        m_ip_playback_state.Update(IPPlaybackStateAggregator::UpdateType::Status, params);
     } else if (method == MD_IPPLAYBACK_MEDIA_POSITION_UPDATE) {
-       // Handle the IP playback media position update request
-        m_sessionCallback->RequestIPPlaybackMediaPositionUpdate(params);
+        m_ip_playback_state.Update(IPPlaybackStateAggregator::UpdateType::MediaPosition, params);
     } else if (method == MD_IPPLAYBACK_SET_COMPONENTS) {
-        // Handle the IP playback set components request
-        m_sessionCallback->RequestIPPlaybackSetComponents(params);
+        m_ip_playback_state.Update(IPPlaybackStateAggregator::UpdateType::Components, params);
     } else if (method == MD_IPPLAYBACK_SET_TIMELINE_MAPPING) {
         // Handle the IP playback set timeline mapping request
         m_sessionCallback->RequestIPPlaybackSetTimelineMapping(params);
@@ -1838,6 +2401,23 @@ JsonRpcService::JsonRpcStatus JsonRpcService::HandleIPPlaybackRequest(int connec
     return ResponseIPPlaybackRequest(connectionId, id, method);
 }
 
+void JsonRpcService::ForwardIPPlaybackUpdate(IPPlaybackStateAggregator::UpdateType type,
+    const Json::Value &params)
+{
+    switch (type)
+    {
+        case IPPlaybackStateAggregator::UpdateType::Status:
+            m_sessionCallback->RequestIPPlaybackStatusUpdate(params);
+            break;
+        case IPPlaybackStateAggregator::UpdateType::MediaPosition:
+            m_sessionCallback->RequestIPPlaybackMediaPositionUpdate(params);
+            break;
+        case IPPlaybackStateAggregator::UpdateType::Components:
+            m_sessionCallback->RequestIPPlaybackSetComponents(params);
+            break;
+    }
+}
+
 void JsonRpcService::SendIPPlayerSelectChannel(int channelType, int idType, const std::string& ipBroadcastId)
 {
     Json::Value params;
@@ -1920,19 +2500,13 @@ void JsonRpcService::SendIPPlayerResolveTimeline(int sessionId, const std::strin
 
 void JsonRpcService::GetIPPlayerConnectionIdsForMethod(std::vector<int> &availableIds, const std::string& method)
 {
+    int methodId = GetMethodId(method);
     std::vector<int> connectionIds = GetAllConnectionIds();
     for (int connectionId : connectionIds)
     {
-        Json::Value negotiateMethodsJson = GetConnectionData(connectionId,
-            ConnectionDataType::NegotiateMethodsTerminalToApp);
-
-        if (negotiateMethodsJson.isArray()
-            && JsonUtil::IsMethodInJsonArray(negotiateMethodsJson, method))
+        if (IsMethodNegotiated(connectionId, methodId, false))
         {
             availableIds.push_back(connectionId);
-        } else
-        {
-            LOGE("Warning, connection data lost, parameter has wrong type.");
         }
     }
 }
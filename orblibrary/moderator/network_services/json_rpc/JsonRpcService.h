@@ -9,7 +9,15 @@
 #define OBS_NS_JSON_RPC_SERVICE_H
 
 #include "websocket_service.h"
-
+#include "IPPlaybackStateAggregator.h"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -18,11 +26,25 @@
 #include <memory>
 #include <json/json.h>
 #include <functional>
+#include <thread>
 
 namespace orb {
+namespace metrics {
+class Histogram;
+}
 namespace networkServices {
 class JsonRpcService : public WebSocketService {
 public:
+    // Upper bounds of the method and accessibility feature IDs interned at construction
+    static constexpr size_t MAX_METHODS = 64;
+    static constexpr size_t MAX_ACCESSIBILITY_FEATURES = 8;
+
+    // Default minimum interval between the IP playback updates forwarded for a session
+    static constexpr int DEFAULT_IP_PLAYBACK_UPDATE_INTERVAL_MS = 250;
+
+    typedef std::bitset<MAX_METHODS> MethodSet;
+    typedef std::bitset<MAX_ACCESSIBILITY_FEATURES> FeatureSet;
+
     enum class ConnectionDataType
     {
         ActionPause,
@@ -69,9 +91,9 @@ public:
         int startTime = -1;
         int endTime = -1;
         std::string state = "";
-        std::unordered_set<std::string> negotiateMethodsAppToTerminal;
-        std::unordered_set<std::string> negotiateMethodsTerminalToApp;
-        std::unordered_set<std::string> subscribedMethods;
+        MethodSet negotiateMethodsAppToTerminal;
+        MethodSet negotiateMethodsTerminalToApp;
+        FeatureSet subscribedFeatures;
         int idCount;
         bool voiceReady = false;
     };
@@ -89,6 +111,15 @@ public:
 
     typedef JsonRpcStatus (JsonRpcService::*JsonRpcMethod)(int, const Json::Value&);
 
+    typedef std::function<JsonRpcStatus(int connectionId, const Json::Value&)> MethodHandler;
+
+    // The latency of each method is recorded in the metrics registry, see GetLatencyMetricName
+    struct MethodStats
+    {
+        uint64_t calls = 0;
+        int inFlight = 0;
+    };
+
     struct SubscribeOptions
     {
         bool subtitles = false;
@@ -101,6 +132,9 @@ public:
         bool inVisionSigning = false;
     };
 
+    // The methods may be called concurrently: from the service thread, from the worker threads
+    // (see SetWorkerThreadCount) and from the IP playback update thread. Implementations must
+    // be thread-safe.
     class ISessionCallback {
 public:
         virtual void RequestNegotiateMethods() = 0;
@@ -184,15 +218,50 @@ public:
 
     JsonRpcService(int port, const std::string &endpoint,
         std::unique_ptr<ISessionCallback> sessionCallback);
+
+    ~JsonRpcService() override;
+
     /**
      *  Set Operator Application flag.
      *  Default value is true.
      */
     void SetOpAppEnabled(bool enabled);
 
+    /**
+     *  Handle requests on a pool of worker threads instead of the service thread, so that a slow
+     *  request does not hold up other clients. Responses are sent as they become ready, in any
+     *  order, except that the responses to a batch are sent together. negotiateMethods,
+     *  subscribe and unsubscribe are still handled in order on the service thread. The session
+     *  callback is then called from several threads at once. Default value is 0, no worker
+     *  threads. Set before the service starts.
+     */
+    void SetWorkerThreadCount(int count);
+
+    /**
+     *  Limit how many requests for a method the worker threads handle at once.
+     *  Default value is 0, no limit.
+     */
+    void SetMethodConcurrencyLimit(const std::string &method, int limit);
+
+    MethodStats GetMethodStats(const std::string &method);
+
+    /**
+     *  Get the name of the metrics registry histogram of the time from receiving each request for
+     *  a method to its handler returning, in microseconds.
+     */
+    static std::string GetLatencyMetricName(const std::string &method);
+
+    /**
+     *  Forward the IP playback status, media position and components updates for each session
+     *  at most once per interval, keeping only the latest of each. A status update to PRESENTING
+     *  or STOPPED, or reporting an error, is always forwarded immediately. Set to 0 to forward
+     *  every update as it arrives. Default value is DEFAULT_IP_PLAYBACK_UPDATE_INTERVAL_MS.
+     */
+    void SetIPPlaybackUpdateInterval(int intervalMs);
+
     bool OnConnection(WebSocketConnection *connection) override;
 
-    void OnMessageReceived(WebSocketConnection *connection, const std::string &text) override;
+    void OnMessageReceived(WebSocketConnection *connection, std::string_view text) override;
 
     void OnDisconnected(WebSocketConnection *connection) override;
 
@@ -356,13 +425,70 @@ private:
     void SetStateMediaToConnectionData(int connectionId, const ConnectionData& mediaData);
     Json::Value GetConnectionData(int connectionId, ConnectionDataType type);
 
+    // The responses to a batch of requests, sent in one array once every request is answered
+    struct PendingBatch
+    {
+        int connectionId;
+        Json::Value responses;
+        int remaining; // Requests being handled or awaiting a response, plus one while receiving
+    };
+
+    struct PendingRequest
+    {
+        int connectionId;
+        int methodId;
+        const MethodHandler *handler;
+        Json::Value obj;
+        std::chrono::steady_clock::time_point received;
+        std::shared_ptr<PendingBatch> batch;
+        std::string batchId;
+    };
+
+    // Request dispatch
+    void HandleRequest(int connectionId, Json::Value &&obj,
+        std::chrono::steady_clock::time_point received,
+        const std::shared_ptr<PendingBatch> &batch = nullptr);
+
+    const MethodHandler *FindHandler(int connectionId, const Json::Value &obj, int &methodId);
+
+    std::string AddBatchRequest(const Json::Value &obj, const std::shared_ptr<PendingBatch> &batch);
+
+    void FinishBatchRequest(const std::shared_ptr<PendingBatch> &batch, const std::string &id,
+        bool awaitResponse);
+
+    bool AddBatchResponse(int connectionId, const Json::Value &response);
+
+    void SendBatch(PendingBatch &batch, std::unique_lock<std::mutex> &lock);
+
+    void ReportStatus(int connectionId, JsonRpcStatus status, const Json::Value& obj);
+
+    void StartWorkerThreads();
+
+    void StopWorkerThreads();
+
+    void WorkerLoop();
+
+    void RecordMethodCompleted(int methodId, std::chrono::steady_clock::time_point received);
+
     // Helper functions
     std::vector<int> GetAllConnectionIds();
 
     void RegisterMethod(const std::string& name, JsonRpcMethod method);
 
+    int InternMethod(const std::string& name);
+
+    int GetMethodId(const std::string& name) const;
+
+    Json::Value GetMethodsInJsonArray(const MethodSet& methods) const;
+
+    bool IsMethodNegotiated(int connectionId, int methodId, bool isAppToTerminal);
+
+    void UpdateNotifySubscribers();
+
     void SendJsonMessageToClient(int connectionId, const Json::Value &jsonResponse);
 
+    void SendTextToClient(int connectionId, const std::string &message);
+
     void GetNotifyConnectionIds(std::vector<int> &availableConnectionIds, const int msgType);
 
     void RegisterSupportedMethods();
@@ -395,6 +521,9 @@ private:
 
     JsonRpcStatus ResponseIPPlaybackRequest(int connectionId, const std::string &id, const std::string &method);
 
+    void ForwardIPPlaybackUpdate(IPPlaybackStateAggregator::UpdateType type,
+        const Json::Value &params);
+
     void RegisterJsonRPCMethods();
 
     bool GetActionValue(const Json::Value &actions, const std::string &actionName);
@@ -405,21 +534,56 @@ private:
     std::unique_ptr<ISessionCallback> m_sessionCallback;
 
     // Map to hold JSON-RPC methods
-    std::map<std::string, std::function<JsonRpcStatus(int connectionId, const
-        Json::Value&)> > m_json_rpc_methods;
+    std::map<std::string, MethodHandler> m_json_rpc_methods;
+
+    // Method names interned to the small integer IDs used in the method sets
+    std::unordered_map<std::string, int> m_method_ids;
+    std::vector<std::string> m_method_names;
+    int m_notify_method_id;
 
     // Sets to hold supported methods for both directions between the regular app and the terminal
-    std::unordered_set<std::string> m_supported_methods_app_to_terminal;
-    std::unordered_set<std::string> m_supported_methods_terminal_to_app;
+    MethodSet m_supported_methods_app_to_terminal;
+    MethodSet m_supported_methods_terminal_to_app;
 
     // Sets to hold supported methods for both directions between the terminal and the operator app
-    std::unordered_set<std::string> m_supported_methods_opapp_to_terminal;
-    std::unordered_set<std::string> m_supported_methods_terminal_to_opapp;
+    MethodSet m_supported_methods_opapp_to_terminal;
+    MethodSet m_supported_methods_terminal_to_opapp;
 
     // Map to hold connection data for each connection
     std::unordered_map<int, ConnectionData> m_connectionData;
+
+    // Connections to notify of each accessibility feature preference change, kept up to date
+    // as connections negotiate methods and subscribe
+    std::vector<int> m_notify_subscribers[MAX_ACCESSIBILITY_FEATURES];
+
+    // Requests waiting for a worker thread. The queue, limits and stats are guarded by
+    // m_dispatch_mutex
+    int m_worker_thread_count;
+    std::vector<std::thread> m_worker_threads;
+    std::mutex m_dispatch_mutex;
+    std::condition_variable m_dispatch_condition;
+    std::deque<PendingRequest> m_pending_requests;
+    bool m_stop_workers;
+    MethodSet m_inline_methods;
+    MethodSet m_deferred_methods;
+    std::array<int, MAX_METHODS> m_method_concurrency_limits;
+    std::array<MethodStats, MAX_METHODS> m_method_stats;
+    // Registered on the first call of each method
+    std::array<metrics::Histogram *, MAX_METHODS> m_method_latency;
     bool m_opAppEnabled;
     int m_currentSessionId;
+
+    // Batches waiting for responses, by connection and encoded request ID. Guarded by
+    // m_batch_mutex
+    std::mutex m_batch_mutex;
+    std::map<std::pair<int, std::string>, std::shared_ptr<PendingBatch>> m_batch_requests;
+    // The batch whose requests the current thread is handling. It takes the responses that are
+    // not matched to a request by ID, such as errors for invalid requests
+    static thread_local PendingBatch *m_handling_batch;
+
+    // Latest IP playback state of each session, forwarded to the session callback at a limited
+    // rate. Declared last so that it is stopped before the session callback is destroyed
+    IPPlaybackStateAggregator m_ip_playback_state;
 };
 } // namespace networkServices
 } // namespace orb
@@ -22,6 +22,7 @@
 #include <iomanip>
 #include <sstream>
 #include "JsonUtil.h"
+#include "json_codec.h"
 
 namespace orb
 {
@@ -282,9 +283,7 @@ namespace networkServices
             oss << std::noshowpoint << id.asDouble();
             return oss.str();
         }
-        Json::StreamWriterBuilder writerBuilder;
-        writerBuilder["indentation"] = OPTIONAL_STR_NOT_SET;
-        return Json::writeString(writerBuilder, id);
+        return JsonCodec::Write(id);
     }
 
     /**
@@ -295,11 +294,8 @@ namespace networkServices
     */
     Json::Value JsonRpcServiceUtil::DecodeJsonId(const std::string& id)
     {
-        Json::CharReaderBuilder builder;
         Json::Value jsonId;
-        std::string errs;
-        std::istringstream ss(id);
-        if (!Json::parseFromStream(builder, ss, &jsonId, &errs))
+        if (!JsonCodec::Parse(id, jsonId))
         {
             return Json::nullValue;
         }
@@ -37,6 +37,7 @@
 #include <memory>
 #include "CSSUtilities.h"
 #include "log.h"
+#include "json_codec.h"
 #include <regex>
 #include <iomanip>
 #include <sstream>
@@ -45,31 +46,10 @@ namespace NetworkServices {
 namespace CSSUtilities {
 bool unpack(const std::string &msg, Json::Value &msgToJson)
 {
-// Use version define in jsoncpp header 'json/version.h'
-#if JSONCPP_VERSION_HEXA > 0x01080200
-    Json::CharReaderBuilder builder = {};
-    auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
-
     std::string errors{};
-    const auto is_parsed = reader->parse(msg.c_str(),
-        msg.c_str() + msg.length(),
-        &msgToJson,
-        &errors);
-#else
-    Json::Reader reader;
-
-    const auto is_parsed = reader.parse(msg.c_str(),
-        msg.c_str() + msg.length(),
-        msgToJson,
-        false /* Discard comments */);
-#endif
-    if (!is_parsed)
+    if (!orb::networkServices::JsonCodec::Parse(msg, msgToJson, &errors))
     {
-#if JSONCPP_VERSION_HEXA > 0x01080200
         LOG(LOG_ERROR, "CSSUtilities::unpack ERROR: Could not parse! %s\n", errors.c_str());
-#else
-        LOG(LOG_ERROR, "CSSUtilities::unpack ERROR: Could not parse!\n");
-#endif
         return false;
     }
 
@@ -41,6 +41,7 @@
 #include "ContentIdentificationService.h"
 #include "CSSUtilities.h"
 #include "log.h"
+#include "json_codec.h"
 
 namespace NetworkServices {
 ContentIdentificationProperties::ContentIdentificationProperties()
@@ -154,6 +155,8 @@ ContentIdentificationService::ContentIdentificationService(int port,
                                                            ContentIdentificationProperties *props) :
     WebSocketService("lws-cii", port, false, ""), m_properties(props)
 {
+    // Companion devices receive the whole CII message each time it changes
+    EnablePermessageDeflate();
 }
 
 bool ContentIdentificationService::OnConnection(WebSocketService::WebSocketConnection *connection)
@@ -168,10 +171,10 @@ bool ContentIdentificationService::OnConnection(WebSocketService::WebSocketConne
 
 void ContentIdentificationService::OnMessageReceived(
     WebSocketService::WebSocketConnection *connection,
-    const std::string &text)
+    std::string_view text)
 {
-    LOG(LOG_INFO, "Received unexpected message on connection %s: %s\n", connection->Uri().c_str(),
-        text.c_str());
+    LOG(LOG_INFO, "Received unexpected message on connection %s: %.*s\n",
+        connection->Uri().c_str(), static_cast<int>(text.size()), text.data());
 }
 
 void ContentIdentificationService::OnDisconnected(WebSocketService::WebSocketConnection *connection)
@@ -214,16 +217,11 @@ std::string ContentIdentificationService::pack(const Json::Value &currentMessage
 
     // if (onlydiff) {
     //     LOG(LOG_DEBUG, "ContentIdentificationService::pack:: \n%s\n", diffMessage.toStyledString().c_str());
-    //     return Json::writeString(m_wbuilder, diffMessage);
+    //     return orb::networkServices::JsonCodec::Write(diffMessage);
     // }
 
     LOG(LOG_DEBUG, "ContentIdentificationService::pack:: \n%s\n",
         currentMessage.toStyledString().c_str());
-// Use version define in jsoncpp header 'json/version.h'
-#if JSONCPP_VERSION_HEXA > 0x01080200
-    return Json::writeString(m_wbuilder, currentMessage);
-#else
-    return m_writer.write(currentMessage);
-#endif
+    return orb::networkServices::JsonCodec::Write(currentMessage);
 }
 }
@@ -77,7 +77,7 @@ public:
 
     bool OnConnection(WebSocketConnection *connection) override;
 
-    void OnMessageReceived(WebSocketConnection *connection, const std::string &text) override;
+    void OnMessageReceived(WebSocketConnection *connection, std::string_view text) override;
 
     void OnDisconnected(WebSocketConnection *connection) override;
 
@@ -93,12 +93,6 @@ public:
 private:
     ContentIdentificationProperties *m_properties;
     Json::Value m_previousMessage;
-// Use version define in jsoncpp header 'json/version.h'
-#if JSONCPP_VERSION_HEXA > 0x01080200
-    Json::StreamWriterBuilder m_wbuilder;
-#else
-    Json::FastWriter m_writer;
-#endif
     std::stringstream m_pattern;
 
     std::string pack(const Json::Value &currentMessage, bool onlydiff, bool alwaysSendTimelines =
@@ -37,6 +37,7 @@
 #include "TimelineSyncService.h"
 #include "CSSUtilities.h"
 #include "log.h"
+#include "json_codec.h"
 #include "ContentIdentificationService.h"
 #include "media_synchroniser.h"
 
@@ -397,6 +398,8 @@ TimelineSyncService::TimelineSyncService(int port, ClockBase *wallClock,
     m_wallclock{wallClock}, m_mediaSync(mediaSync), m_ciiService{cii}, m_contentIdOverride{
                                                                                            contentIdOverride}
 {
+    // Control timestamps differ from the previous one in a few digits
+    EnablePermessageDeflate();
 }
 
 void TimelineSyncService::setContentId(const std::string &cid, const bool forceUpdate)
@@ -474,8 +477,9 @@ void TimelineSyncService::OnDisconnected(WebSocketService::WebSocketConnection *
 }
 
 void TimelineSyncService::OnMessageReceived(WebSocketService::WebSocketConnection *connection,
-    const std::string &text)
+    std::string_view message)
 {
+    const std::string text(message);
     LOG(LOG_DEBUG, "TimelineSyncService::OnMessageReceived %s \n", text.c_str());
 
     if (m_connectionSetupData[connection].isEmpty())       //initial setup
@@ -536,11 +540,7 @@ void TimelineSyncService::updateClient(WebSocketService::WebSocketConnection *co
             m_connectionPreviousControlTimestamp[connection] = ct;
             LOG(LOG_DEBUG, "Current Control timestamp: %s\n",
                 ct.value().pack().toStyledString().c_str());
-#if JSONCPP_VERSION_HEXA > 0x01080200
-            connection->SendMessage(Json::writeString(m_wbuilder, ct.value().pack()));
-#else
-            connection->SendMessage(m_writer.write(ct.value().pack()));
-#endif
+            connection->SendMessage(orb::networkServices::JsonCodec::Write(ct.value().pack()));
         }
         else
         {
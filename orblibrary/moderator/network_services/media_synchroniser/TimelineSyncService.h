@@ -326,7 +326,7 @@ public:
 
     bool OnConnection(WebSocketConnection *connection) override;
 
-    void OnMessageReceived(WebSocketConnection *connection, const std::string &text) override;
+    void OnMessageReceived(WebSocketConnection *connection, std::string_view message) override;
 
     void OnDisconnected(WebSocketConnection *connection) override;
 
@@ -354,12 +354,6 @@ private:
     std::unordered_map<WebSocketConnection *, SetupTSData> m_connectionSetupData;
     std::unordered_map<WebSocketConnection *,
                        Nullable<ControlTimestamp> > m_connectionPreviousControlTimestamp;
-// Use version define in jsoncpp header 'json/version.h'
-#if JSONCPP_VERSION_HEXA > 0x01080200
-    Json::StreamWriterBuilder m_wbuilder;
-#else
-    Json::FastWriter m_writer;
-#endif
     ContentIdentificationService *m_ciiService;
     MediaSynchroniser *m_mediaSync;
 
@@ -0,0 +1,138 @@
+#include "testing/gtest/include/gtest/gtest.h"
+#include "IPPlaybackStateAggregator.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace orb::networkServices;
+
+typedef IPPlaybackStateAggregator::UpdateType UpdateType;
+
+class ForwardRecorder {
+public:
+    IPPlaybackStateAggregator::ForwardCallback Callback() {
+        return [this](UpdateType type, const Json::Value &params) {
+            std::lock_guard<std::mutex> lock(mutex);
+            forwarded.emplace_back(type, params);
+        };
+    }
+
+    std::vector<std::pair<UpdateType, Json::Value>> Get() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return forwarded;
+    }
+
+    std::mutex mutex;
+    std::vector<std::pair<UpdateType, Json::Value>> forwarded;
+};
+
+static Json::Value Status(int sessionId, int status) {
+    Json::Value params;
+    params["sessionID"] = sessionId;
+    params["status"] = status;
+    return params;
+}
+
+static Json::Value Position(int sessionId, double currentTime) {
+    Json::Value params;
+    params["sessionID"] = sessionId;
+    params["currentTime"] = currentTime;
+    return params;
+}
+
+TEST(IPPlaybackStateAggregator, TestNoIntervalForwardsEveryUpdate) {
+    // GIVEN: an aggregator with no interval
+    ForwardRecorder recorder;
+    IPPlaybackStateAggregator aggregator(recorder.Callback());
+
+    // WHEN: posting the same media position twice
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 1.0));
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 1.0));
+
+    // THEN: both updates should be forwarded
+    EXPECT_EQ(recorder.Get().size(), 2u);
+}
+
+TEST(IPPlaybackStateAggregator, TestMediaPositionCoalesced) {
+    // GIVEN: an aggregator with an interval
+    ForwardRecorder recorder;
+    IPPlaybackStateAggregator aggregator(recorder.Callback());
+    aggregator.SetInterval(std::chrono::milliseconds(100));
+
+    // WHEN: posting media positions faster than the interval
+    for (int i = 1; i <= 5; i++)
+    {
+        aggregator.Update(UpdateType::MediaPosition, Position(1, i));
+    }
+
+    // THEN: the first should be forwarded at once and the latest after the interval
+    auto forwarded = recorder.Get();
+    ASSERT_EQ(forwarded.size(), 1u);
+    EXPECT_EQ(forwarded[0].second["currentTime"].asDouble(), 1.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    forwarded = recorder.Get();
+    ASSERT_EQ(forwarded.size(), 2u);
+    EXPECT_EQ(forwarded[1].first, UpdateType::MediaPosition);
+    EXPECT_EQ(forwarded[1].second["currentTime"].asDouble(), 5.0);
+}
+
+TEST(IPPlaybackStateAggregator, TestDiscreteTransitionsFlushImmediately) {
+    // GIVEN: an aggregator with an interval longer than the test
+    ForwardRecorder recorder;
+    IPPlaybackStateAggregator aggregator(recorder.Callback());
+    aggregator.SetInterval(std::chrono::seconds(60));
+    aggregator.Update(UpdateType::Status, Status(1, 1));
+
+    // WHEN: posting a media position then PRESENTING, a repeated PRESENTING, then STOPPED
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 2.0));
+    aggregator.Update(UpdateType::Status, Status(1, 2));
+    aggregator.Update(UpdateType::Status, Status(1, 2));
+    aggregator.Update(UpdateType::Status, Status(1, 3));
+
+    // THEN: the held position should be forwarded before PRESENTING, and the repeat dropped
+    auto forwarded = recorder.Get();
+    ASSERT_EQ(forwarded.size(), 4u);
+    EXPECT_EQ(forwarded[0].second["status"].asInt(), 1);
+    EXPECT_EQ(forwarded[1].first, UpdateType::MediaPosition);
+    EXPECT_EQ(forwarded[2].second["status"].asInt(), 2);
+    EXPECT_EQ(forwarded[3].second["status"].asInt(), 3);
+}
+
+TEST(IPPlaybackStateAggregator, TestStopFlushesHeldUpdates) {
+    // GIVEN: an aggregator holding a change for each of two sessions
+    ForwardRecorder recorder;
+    IPPlaybackStateAggregator aggregator(recorder.Callback());
+    aggregator.SetInterval(std::chrono::seconds(60));
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 1.0));
+    aggregator.Update(UpdateType::MediaPosition, Position(2, 1.0));
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 2.0));
+    aggregator.Update(UpdateType::MediaPosition, Position(2, 2.0));
+    EXPECT_EQ(recorder.Get().size(), 2u);
+
+    // WHEN: stopping the aggregator
+    aggregator.Stop();
+
+    // THEN: the held changes should be forwarded
+    EXPECT_EQ(recorder.Get().size(), 4u);
+}
+
+TEST(IPPlaybackStateAggregator, TestIdleSessionsForgotten) {
+    // GIVEN: an aggregator that has forwarded an update for each of two sessions
+    ForwardRecorder recorder;
+    IPPlaybackStateAggregator aggregator(recorder.Callback());
+    aggregator.SetInterval(std::chrono::milliseconds(50));
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 1.0));
+    aggregator.Update(UpdateType::MediaPosition, Position(2, 1.0));
+    EXPECT_EQ(aggregator.GetSessionCount(), 2u);
+
+    // WHEN: only one session posts an update after the interval
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    aggregator.Update(UpdateType::MediaPosition, Position(1, 2.0));
+
+    // THEN: the idle session should be forgotten
+    EXPECT_EQ(aggregator.GetSessionCount(), 1u);
+    EXPECT_EQ(recorder.Get().size(), 3u);
+}
@@ -0,0 +1,79 @@
+// create unit for all static methods in json_codec.cpp
+#include "testing/gtest/include/gtest/gtest.h"
+#include "json_codec.h"
+
+using namespace orb::networkServices;
+
+TEST(JsonCodec, TestParseAndWrite) {
+    // GIVEN: JSON text
+    std::string text = "{ \"a\": [1, 2.5, \"x\"], \"b\": null }";
+
+    // WHEN: parsing the text and writing the parsed value
+    Json::Value value;
+    bool parsed = JsonCodec::Parse(text, value);
+    std::string written = JsonCodec::Write(value);
+
+    // THEN: the value should be written as compact text
+    EXPECT_TRUE(parsed);
+    EXPECT_EQ(written, "{\"a\":[1,2.5,\"x\"],\"b\":null}");
+}
+
+TEST(JsonCodec, TestParseInvalid) {
+    // GIVEN: invalid JSON text
+    std::string text = "{\"a\":";
+
+    // WHEN: parsing the text
+    Json::Value value;
+    std::string errors;
+    bool parsed = JsonCodec::Parse(text, value, &errors);
+
+    // THEN: it should fail with a description of the error
+    EXPECT_FALSE(parsed);
+    EXPECT_FALSE(errors.empty());
+}
+
+TEST(JsonCodec, TestScanRequestEnvelope) {
+    // GIVEN: a JSON-RPC request
+    std::string text = "{\"jsonrpc\":\"2.0\", \"id\":-12.5e1, \"method\":\"org.hbbtv.subscribe\","
+        " \"params\":{\"msgType\":[\"subtitlesPrefChange\"], \"s\":\"}\\\"]\"}}";
+
+    // WHEN: scanning the envelope
+    JsonCodec::RequestEnvelope envelope;
+    bool scanned = JsonCodec::ScanRequestEnvelope(text, envelope);
+
+    // THEN: it should find every member
+    EXPECT_TRUE(scanned);
+    EXPECT_TRUE(envelope.hasVersion);
+    EXPECT_EQ(envelope.version, "2.0");
+    EXPECT_TRUE(envelope.hasMethod);
+    EXPECT_EQ(envelope.method, "org.hbbtv.subscribe");
+    EXPECT_EQ(std::string(envelope.id, envelope.idLength), "-12.5e1");
+    Json::Value params;
+    EXPECT_TRUE(JsonCodec::Parse(envelope.params, envelope.params + envelope.paramsLength, params));
+    EXPECT_EQ(params["msgType"][0].asString(), "subtitlesPrefChange");
+    EXPECT_EQ(params["s"].asString(), "}\"]");
+}
+
+TEST(JsonCodec, TestScanRequestEnvelopeUncommonForms) {
+    // GIVEN: messages that are not in the common form of request
+    const char *texts[] = {
+        "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{}}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"a\\u0062\"}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"a\",\"method\":\"b\"}",
+        "{\"jsonrpc\":2.0,\"method\":\"a\"}",
+        "{\"jsonrpc\":\"2.0\",\"id\":01,\"method\":\"a\"}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"a\",\"params\":{/* } */}}",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"a\"} x",
+        "{\"jsonrpc\":\"2.0\",\"method\":\"a\",\"params\":{",
+    };
+
+    for (const char *text : texts)
+    {
+        // WHEN: scanning the envelope
+        JsonCodec::RequestEnvelope envelope;
+        bool scanned = JsonCodec::ScanRequestEnvelope(text, envelope);
+
+        // THEN: it should fail, so the message is parsed instead
+        EXPECT_FALSE(scanned) << text;
+    }
+}
@@ -1,5 +1,8 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "JsonRpcService.h"
+#include "Metrics.h"
+#include <atomic>
+#include <mutex>
 #include <thread>
 #include <chrono>
 
@@ -39,7 +42,7 @@ public:
         int connectionId,
         std::string id,
         int feature) override {
-        // Mock implementation
+        featureSupportInfoRequests++;
     }
 
     void RequestFeatureSettingsQuery(
@@ -116,6 +119,8 @@ public:
     void RequestIPPlaybackSetTimelineMapping(const Json::Value& params) override {
         // Mock implementation
     }
+
+    std::atomic<int> featureSupportInfoRequests{0};
 };
 
 TEST(JsonRpcService, TestJsonRpcServiceStartAndStop) {
@@ -155,6 +160,63 @@ TEST(JsonRpcService, TestConnectionClose) {
     EXPECT_EQ(connection.GetQueueSize(), 1);
 }
 
+// implement a WebSocketService that records the messages it receives
+class TestWebSocketService : public WebSocketService {
+public:
+    TestWebSocketService() : WebSocketService("test", 8091, false, "lo") {}
+    bool OnConnection(WebSocketConnection *connection) override { return true; }
+    void OnDisconnected(WebSocketConnection *connection) override {}
+    void OnMessageReceived(WebSocketConnection *connection, std::string_view text) override {
+        messages.emplace_back(text);
+    }
+    std::vector<std::string> messages;
+};
+
+TEST(JsonRpcService, TestFragmentReassembly) {
+    // GIVEN: a WebSocketService object and a connection
+    TestWebSocketService service;
+    struct lws *wsi = nullptr;
+    WebSocketService::WebSocketConnection connection(wsi, "/test");
+    const std::string part1(5000, 'a');
+    const std::string part2 = "bc";
+    const uint8_t *data1 = reinterpret_cast<const uint8_t *>(part1.data());
+    const uint8_t *data2 = reinterpret_cast<const uint8_t *>(part2.data());
+
+    // WHEN: receiving an unfragmented message and then a fragmented message, twice
+    service.OnFragmentReceived(&connection, data2, part2.size(), true, true, false);
+    for (int i = 0; i < 2; i++)
+    {
+        service.OnFragmentReceived(&connection, data1, part1.size(), true, false, false);
+        service.OnFragmentReceived(&connection, data2, part2.size(), false, true, false);
+    }
+
+    // THEN: each message is received whole
+    ASSERT_EQ(service.messages.size(), 3u);
+    EXPECT_EQ(service.messages[0], part2);
+    EXPECT_EQ(service.messages[1], part1 + part2);
+    EXPECT_EQ(service.messages[2], part1 + part2);
+    EXPECT_EQ(connection.GetQueueSize(), 0);
+}
+
+TEST(JsonRpcService, TestFragmentReassemblyMaxMessageSize) {
+    // GIVEN: a WebSocketService object with a maximum message size and a connection
+    TestWebSocketService service;
+    service.SetMaxMessageSize(6000);
+    struct lws *wsi = nullptr;
+    WebSocketService::WebSocketConnection connection(wsi, "/test");
+    const std::string part(4000, 'a');
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(part.data());
+
+    // WHEN: receiving a fragmented message larger than the maximum
+    service.OnFragmentReceived(&connection, data, part.size(), true, false, false);
+    service.OnFragmentReceived(&connection, data, part.size(), false, false, false);
+    service.OnFragmentReceived(&connection, data, part.size(), false, true, false);
+
+    // THEN: the message is dropped and the connection closed
+    EXPECT_TRUE(service.messages.empty());
+    EXPECT_EQ(connection.GetQueueSize(), 1);
+}
+
 // write cases test following methods in JsonRpcService:
 
 TEST(JSonRpcService, TestSendIPPlayerSelectChannel) {
@@ -306,3 +368,253 @@ TEST(JsonRpcService, TestRequestIPPlaybackSetPresentFollowing) {
     auto status = jsonRpcService.RequestIPPlaybackSetPresentFollowing(1, obj);
     EXPECT_EQ(status, JsonRpcService::JsonRpcStatus::SUCCESS);
 }
+
+TEST(JsonRpcService, TestOnlyNegotiatedMethodsAreHandled) {
+    // GIVEN: a JsonRpcService object with a connected application
+    MockSessionCallback *mockCallback = new MockSessionCallback();
+    std::unique_ptr<JsonRpcService::ISessionCallback> sessionCallback(mockCallback);
+    JsonRpcService jsonRpcService(8090, "/jsonrpc", std::move(sessionCallback));
+    struct lws *wsi = nullptr;
+    WebSocketService::WebSocketConnection connection(wsi, "/jsonrpc");
+    EXPECT_TRUE(jsonRpcService.OnConnection(&connection));
+    const std::string request = "{\"jsonrpc\":\"2.0\",\"id\":1,"
+        "\"method\":\"org.hbbtv.af.featureSupportInfo\",\"params\":{\"feature\":\"subtitles\"}}";
+
+    // WHEN: the application calls a method it has not negotiated
+    jsonRpcService.OnMessageReceived(&connection, request);
+    // THEN: the method is not handled
+    EXPECT_EQ(mockCallback->featureSupportInfoRequests.load(), 0);
+
+    // WHEN: the application negotiates the method, along with one the terminal does not support
+    jsonRpcService.OnMessageReceived(&connection, "{\"jsonrpc\":\"2.0\",\"id\":2,"
+        "\"method\":\"org.hbbtv.negotiateMethods\",\"params\":{\"terminalToApp\":[],"
+        "\"appToTerminal\":[\"org.hbbtv.af.featureSupportInfo\",\"org.example.unknown\"]}}");
+    jsonRpcService.OnMessageReceived(&connection, request);
+    // THEN: the method is handled
+    EXPECT_EQ(mockCallback->featureSupportInfoRequests.load(), 1);
+    jsonRpcService.OnDisconnected(&connection);
+}
+
+TEST(JsonRpcService, TestBatchOnWorkerThreads) {
+    // GIVEN: a JsonRpcService object with worker threads and a connected application that has
+    // negotiated featureSupportInfo
+    MockSessionCallback *mockCallback = new MockSessionCallback();
+    std::unique_ptr<JsonRpcService::ISessionCallback> sessionCallback(mockCallback);
+    JsonRpcService jsonRpcService(8090, "/jsonrpc", std::move(sessionCallback));
+    jsonRpcService.SetWorkerThreadCount(2);
+    jsonRpcService.SetMethodConcurrencyLimit("org.hbbtv.af.featureSupportInfo", 1);
+    struct lws *wsi = nullptr;
+    WebSocketService::WebSocketConnection connection(wsi, "/jsonrpc");
+    EXPECT_TRUE(jsonRpcService.OnConnection(&connection));
+    jsonRpcService.OnMessageReceived(&connection, "{\"jsonrpc\":\"2.0\",\"id\":1,"
+        "\"method\":\"org.hbbtv.negotiateMethods\",\"params\":{\"terminalToApp\":[],"
+        "\"appToTerminal\":[\"org.hbbtv.af.featureSupportInfo\"]}}");
+
+    orb::metrics::Histogram &latency = orb::metrics::Registry::Instance().GetHistogram(
+        JsonRpcService::GetLatencyMetricName("org.hbbtv.af.featureSupportInfo"));
+    uint64_t latencyCount = latency.GetSnapshot().count;
+
+    // WHEN: the application sends a batch of two requests
+    jsonRpcService.OnMessageReceived(&connection, "["
+        "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"org.hbbtv.af.featureSupportInfo\","
+        "\"params\":{\"feature\":\"subtitles\"}},"
+        "{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"org.hbbtv.af.featureSupportInfo\","
+        "\"params\":{\"feature\":\"uiMagnifier\"}}]");
+    for (int i = 0; i < 100 &&
+         jsonRpcService.GetMethodStats("org.hbbtv.af.featureSupportInfo").calls < 2; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // THEN: both requests are handled and their latencies recorded
+    JsonRpcService::MethodStats stats =
+        jsonRpcService.GetMethodStats("org.hbbtv.af.featureSupportInfo");
+    EXPECT_EQ(mockCallback->featureSupportInfoRequests.load(), 2);
+    EXPECT_EQ(stats.calls, 2u);
+    EXPECT_EQ(stats.inFlight, 0);
+    EXPECT_EQ(latency.GetSnapshot().count - latencyCount, 2u);
+    jsonRpcService.OnDisconnected(&connection);
+}
+
+// implement a connection that records the messages sent to it
+class RecordingConnection : public WebSocketService::WebSocketConnection {
+public:
+    RecordingConnection() : WebSocketConnection(nullptr, "/jsonrpc") {}
+    void SendMessage(const std::string &text) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back(text);
+    }
+    std::vector<Json::Value> WaitForMessages(size_t count) {
+        for (int i = 0; i < 200 && GetMessageCount() < count; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Json::Value> result;
+        for (const std::string &message : messages)
+        {
+            Json::Value value;
+            Json::Reader().parse(message, value);
+            result.push_back(value);
+        }
+        return result;
+    }
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.clear();
+    }
+    size_t GetMessageCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return messages.size();
+    }
+    std::mutex mutex;
+    std::vector<std::string> messages;
+};
+
+// implement a JsonRpcService that the test connects to directly
+class TestJsonRpcService : public JsonRpcService {
+public:
+    using JsonRpcService::JsonRpcService;
+    RecordingConnection *Connect() {
+        auto connection = std::make_unique<RecordingConnection>();
+        RecordingConnection *result = connection.get();
+        std::lock_guard<std::recursive_mutex> lock(mConnectionsMutex);
+        mConnections[result] = std::move(connection);
+        EXPECT_TRUE(OnConnection(result));
+        OnMessageReceived(result, "{\"jsonrpc\":\"2.0\",\"id\":1,"
+            "\"method\":\"org.hbbtv.negotiateMethods\",\"params\":{\"terminalToApp\":[],"
+            "\"appToTerminal\":[\"org.hbbtv.af.featureSupportInfo\","
+            "\"org.hbbtv.app.voice.ready\"]}}");
+        result->Clear();
+        return result;
+    }
+};
+
+// implement a session callback that answers featureSupportInfo, slowly for the subtitles feature
+class RespondingSessionCallback : public MockSessionCallback {
+public:
+    void RequestFeatureSupportInfo(
+        int connectionId,
+        std::string id,
+        int feature) override {
+        int running = ++inFlight;
+        int max = maxInFlight.load();
+        while (running > max && !maxInFlight.compare_exchange_weak(max, running))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(feature == 0 ? 200 : 20));
+        inFlight--;
+        service->RespondFeatureSupportInfo(connectionId, id, feature, "tvosSupport");
+    }
+
+    JsonRpcService *service = nullptr;
+    std::atomic<int> inFlight{0};
+    std::atomic<int> maxInFlight{0};
+};
+
+static std::string FeatureSupportInfoRequest(int id, const std::string &feature)
+{
+    return "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id) +
+        ",\"method\":\"org.hbbtv.af.featureSupportInfo\",\"params\":{\"feature\":\"" +
+        feature + "\"}}";
+}
+
+TEST(JsonRpcService, TestBatchResponsesInOneArray) {
+    // GIVEN: a JsonRpcService object and a connected application
+    RespondingSessionCallback *callback = new RespondingSessionCallback();
+    TestJsonRpcService jsonRpcService(8090, "/jsonrpc",
+        std::unique_ptr<JsonRpcService::ISessionCallback>(callback));
+    callback->service = &jsonRpcService;
+    RecordingConnection *connection = jsonRpcService.Connect();
+
+    // WHEN: the application sends a batch of two requests, a notification and an invalid request
+    jsonRpcService.OnMessageReceived(connection, "[" + FeatureSupportInfoRequest(2, "uiMagnifier") +
+        "," + FeatureSupportInfoRequest(3, "highContrastUI") + ","
+        "{\"jsonrpc\":\"2.0\",\"method\":\"org.hbbtv.app.voice.ready\","
+        "\"params\":{\"ready\":true}},1]");
+
+    // THEN: the responses are sent in one array
+    std::vector<Json::Value> messages = connection->WaitForMessages(1);
+    ASSERT_EQ(messages.size(), 1u);
+    ASSERT_TRUE(messages[0].isArray());
+    ASSERT_EQ(messages[0].size(), 3u);
+    EXPECT_EQ(messages[0][0]["id"].asInt(), 2);
+    EXPECT_EQ(messages[0][1]["id"].asInt(), 3);
+    EXPECT_TRUE(messages[0][2]["id"].isNull());
+    EXPECT_EQ(messages[0][2]["error"]["code"].asInt(), -32600);
+}
+
+TEST(JsonRpcService, TestBatchOfNotificationsHasNoResponse) {
+    // GIVEN: a JsonRpcService object and a connected application
+    RespondingSessionCallback *callback = new RespondingSessionCallback();
+    TestJsonRpcService jsonRpcService(8090, "/jsonrpc",
+        std::unique_ptr<JsonRpcService::ISessionCallback>(callback));
+    callback->service = &jsonRpcService;
+    RecordingConnection *connection = jsonRpcService.Connect();
+
+    // WHEN: the application sends a batch of notifications
+    const std::string notification = "{\"jsonrpc\":\"2.0\","
+        "\"method\":\"org.hbbtv.app.voice.ready\",\"params\":{\"ready\":true}}";
+    jsonRpcService.OnMessageReceived(connection, "[" + notification + "," + notification + "]");
+
+    // THEN: nothing is sent
+    EXPECT_EQ(connection->GetMessageCount(), 0u);
+}
+
+TEST(JsonRpcService, TestWorkerThreadsCompleteOutOfOrder) {
+    // GIVEN: a JsonRpcService object with worker threads and a connected application
+    RespondingSessionCallback *callback = new RespondingSessionCallback();
+    TestJsonRpcService jsonRpcService(8090, "/jsonrpc",
+        std::unique_ptr<JsonRpcService::ISessionCallback>(callback));
+    callback->service = &jsonRpcService;
+    jsonRpcService.SetWorkerThreadCount(2);
+    RecordingConnection *connection = jsonRpcService.Connect();
+
+    // WHEN: the application sends a slow request and then a fast one
+    jsonRpcService.OnMessageReceived(connection, FeatureSupportInfoRequest(2, "subtitles"));
+    jsonRpcService.OnMessageReceived(connection, FeatureSupportInfoRequest(3, "uiMagnifier"));
+
+    // THEN: they are handled at once and the response to the second is written first
+    std::vector<Json::Value> messages = connection->WaitForMessages(2);
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0]["id"].asInt(), 3);
+    EXPECT_EQ(messages[1]["id"].asInt(), 2);
+    EXPECT_EQ(callback->maxInFlight.load(), 2);
+
+    // WHEN: the application sends the same requests in a batch
+    connection->Clear();
+    jsonRpcService.OnMessageReceived(connection, "[" + FeatureSupportInfoRequest(4, "subtitles") +
+        "," + FeatureSupportInfoRequest(5, "uiMagnifier") + "]");
+
+    // THEN: the responses are sent in one array, in the order they completed
+    messages = connection->WaitForMessages(1);
+    ASSERT_EQ(messages.size(), 1u);
+    ASSERT_EQ(messages[0].size(), 2u);
+    EXPECT_EQ(messages[0][0]["id"].asInt(), 5);
+    EXPECT_EQ(messages[0][1]["id"].asInt(), 4);
+}
+
+TEST(JsonRpcService, TestMethodConcurrencyLimitQueuesCalls) {
+    // GIVEN: a JsonRpcService object with worker threads, a concurrency limit of 1 for
+    // featureSupportInfo and a connected application
+    RespondingSessionCallback *callback = new RespondingSessionCallback();
+    TestJsonRpcService jsonRpcService(8090, "/jsonrpc",
+        std::unique_ptr<JsonRpcService::ISessionCallback>(callback));
+    callback->service = &jsonRpcService;
+    jsonRpcService.SetWorkerThreadCount(2);
+    jsonRpcService.SetMethodConcurrencyLimit("org.hbbtv.af.featureSupportInfo", 1);
+    RecordingConnection *connection = jsonRpcService.Connect();
+
+    // WHEN: the application sends a slow request and then two fast ones
+    jsonRpcService.OnMessageReceived(connection, FeatureSupportInfoRequest(2, "subtitles"));
+    jsonRpcService.OnMessageReceived(connection, FeatureSupportInfoRequest(3, "uiMagnifier"));
+    jsonRpcService.OnMessageReceived(connection, FeatureSupportInfoRequest(4, "uiMagnifier"));
+
+    // THEN: the calls are queued and handled one at a time, in order
+    std::vector<Json::Value> messages = connection->WaitForMessages(3);
+    ASSERT_EQ(messages.size(), 3u);
+    EXPECT_EQ(messages[0]["id"].asInt(), 2);
+    EXPECT_EQ(messages[1]["id"].asInt(), 3);
+    EXPECT_EQ(messages[2]["id"].asInt(), 4);
+    EXPECT_EQ(callback->maxInFlight.load(), 1);
+}
@@ -16,6 +16,7 @@
 
 #include "third_party/orb/logging/include/log.h"
 #include "websocket_service.h"
+#include "Metrics.h"
 
 #define         LWS_PROTOCOL_LIST_TERM   { NULL, NULL, 0, 0, 0, NULL, 0 }
 
@@ -27,7 +28,7 @@ static int sNextConnectionId = 0;
 // Implementation of WebSocketConnection methods
 
 WebSocketService::WebSocketConnection::WebSocketConnection(struct lws *wsi, const std::string &uri)
-    : mWsi(wsi), mUri(uri), mTextBuffer("")
+    : mWsi(wsi), mUri(uri), mDiscardMessage(false)
 {
     mId = sNextConnectionId++;
 }
@@ -54,6 +55,7 @@ void WebSocketService::WebSocketConnection::SendFragment(std::vector<uint8_t> &&
     struct FragmentWriteInfo fragment = {
         .write_protocol = static_cast<lws_write_protocol>(protocol),
         .data = std::move(data),
+        .queued = std::chrono::steady_clock::now(),
     };
     mWriteQueue.emplace(fragment);
     if (mWsi != nullptr)
@@ -65,10 +67,12 @@ void WebSocketService::WebSocketConnection::SendFragment(std::vector<uint8_t> &&
     }
 }
 
-void WebSocketService::WebSocketConnection::Close()
+void WebSocketService::WebSocketConnection::Close(enum lws_close_status status)
 {
     struct FragmentWriteInfo fragment = {
         .close = true,
+        .close_status = status,
+        .queued = std::chrono::steady_clock::now(),
     };
     mWriteQueue.emplace(fragment);
     if (mWsi != nullptr)
@@ -99,6 +103,7 @@ WebSocketService::WebSocketService(const std::string &protocol_name, int port, b
                SECS_SINCE_VALID_HANGUP},
 #endif
     mProtocols{Protocol(mProtocolName.c_str()), LWS_PROTOCOL_LIST_TERM},
+    mMaxMessageSize(DEFAULT_MAX_MESSAGE_SIZE),
     mContext(nullptr)
 {
     mContextInfo =
@@ -140,6 +145,30 @@ bool WebSocketService::Start()
     return ret;
 }
 
+void WebSocketService::SetMaxMessageSize(size_t size)
+{
+    mMaxMessageSize = size;
+}
+
+bool WebSocketService::EnablePermessageDeflate()
+{
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+    // The vhost is created with this table, so the extension is negotiated in the handshake
+    mExtensions[0] = {
+        .name = "permessage-deflate",
+        .callback = lws_extension_callback_pm_deflate,
+        .client_offer = "permessage-deflate; client_max_window_bits"
+    };
+    mExtensions[1] = { nullptr, nullptr, nullptr };
+    mContextInfo.extensions = mExtensions;
+    LOGI("Offering permessage-deflate");
+    return true;
+#else
+    LOGI("Cannot offer permessage-deflate, libwebsockets built without extensions.");
+    return false;
+#endif
+}
+
 void WebSocketService::Stop()
 {
     {
@@ -252,18 +281,27 @@ int WebSocketService::LwsCallback(struct lws *wsi, enum lws_callback_reasons rea
 
         case LWS_CALLBACK_CLOSED: {
             OnDisconnected(it->second.get());
+            ReleaseMessageBuffer(it->second->mMessageBuffer);
             mConnections.erase(it);
             break;
         }
 
         case LWS_CALLBACK_SERVER_WRITEABLE: {
+            static metrics::Histogram &queueWait = metrics::Registry::Instance().GetHistogram(
+                "orb_websocket_write_queue_wait_microseconds",
+                "Time from queuing a WebSocket fragment to writing it");
+            static metrics::Counter &sentBytes = metrics::Registry::Instance().GetCounter(
+                "orb_websocket_sent_bytes_total", "Bytes of WebSocket payload written");
+            const auto now = std::chrono::steady_clock::now();
             while (!it->second->mWriteQueue.empty())
             {
                 auto fragment = std::move(it->second->mWriteQueue.front());
                 it->second->mWriteQueue.pop();
+                queueWait.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+                    now - fragment.queued).count());
                 if (fragment.close)
                 {
-                    lws_close_reason(wsi, LWS_CLOSE_STATUS_GOINGAWAY, nullptr, 0);
+                    lws_close_reason(wsi, fragment.close_status, nullptr, 0);
                     result = -1;
                 } else {
                     int size = fragment.data.size();
@@ -273,15 +311,15 @@ int WebSocketService::LwsCallback(struct lws *wsi, enum lws_callback_reasons rea
                     {
                        result = -1;
                     }
+                    sentBytes.Increment(size);
                 }
             }
             break;
         }
 
         case LWS_CALLBACK_RECEIVE: {
-            std::vector<uint8_t> data(static_cast<uint8_t *>(in), static_cast<uint8_t *>(in) + len);
-            OnFragmentReceived(it->second.get(), std::move(data), lws_is_first_fragment(wsi),
-                lws_is_final_fragment(wsi), lws_frame_is_binary(wsi));
+            OnFragmentReceived(it->second.get(), static_cast<const uint8_t *>(in), len,
+                lws_is_first_fragment(wsi), lws_is_final_fragment(wsi), lws_frame_is_binary(wsi));
             break;
         }
 
@@ -293,34 +331,120 @@ int WebSocketService::LwsCallback(struct lws *wsi, enum lws_callback_reasons rea
 }
 
 void WebSocketService::OnFragmentReceived(WebSocketConnection *connection,
-    std::vector<uint8_t> &&data, bool is_first, bool is_final, bool is_binary)
+    const uint8_t *data, size_t length, bool is_first, bool is_final, bool is_binary)
 {
-    // Convenience default that concatenates fragments before calling OnMessageReceived
-    if (!is_binary)
+    // Convenience default that reassembles text messages before calling OnMessageReceived
+    if (is_binary)
+    {
+        // Not implemented
+        LOGI("WebSocketService::OnFragmentReceived: Binary data received, but not handled.");
+        return;
+    }
+    const char *text = reinterpret_cast<const char *>(data);
+    if (is_first && is_final)
     {
-        if (is_first)
+        // The whole message is in the lws receive buffer
+        OnMessageReceived(connection, std::string_view(text, length));
+        return;
+    }
+
+    std::string &buffer = connection->mMessageBuffer;
+    size_t size = buffer.size() + length;
+    if (is_first)
+    {
+        buffer.clear();
+        connection->mDiscardMessage = false;
+        size = length;
+        if (connection->mWsi != nullptr)
         {
-            // Clear the text buffer if this is the first fragment
-            connection->mTextBuffer.clear();
+            // Size the buffer for the rest of the frame. Later frames grow it if needed
+            size += lws_remaining_packet_payload(connection->mWsi);
         }
-        connection->mTextBuffer += std::string(reinterpret_cast<char *>(data.data()),
-                data.size());
+    }
+    if (connection->mDiscardMessage)
+    {
+        return;
+    }
+    if (size > mMaxMessageSize)
+    {
+        LOGE("Message exceeds " << mMaxMessageSize << " bytes, closing connection " <<
+            connection->Id());
+        connection->mDiscardMessage = true;
+        ReleaseMessageBuffer(buffer);
+        connection->Close(LWS_CLOSE_STATUS_MESSAGE_TOO_LARGE);
+        return;
+    }
+    ReserveMessageBuffer(buffer, size);
+    buffer.append(text, length);
 
-        if (is_final)
+    if (is_final)
+    {
+        OnMessageReceived(connection, buffer);
+        if (buffer.capacity() > MAX_KEPT_MESSAGE_BUFFER_SIZE)
         {
-            OnMessageReceived(connection, connection->mTextBuffer);
+            ReleaseMessageBuffer(buffer);
         }
     }
+}
+
+void WebSocketService::OnMessageReceived(WebSocketConnection *connection, std::string_view text)
+{
+    // Possibly called by the implementation of OnFragmentReceived
+}
+
+/**
+ * Make sure a reassembly buffer can hold size bytes, keeping its contents. The capacity is rounded
+ * up to a power of two, and a large enough buffer is taken from the pool if there is one.
+ */
+void WebSocketService::ReserveMessageBuffer(std::string &buffer, size_t size)
+{
+    if (buffer.capacity() >= size)
+    {
+        return;
+    }
+    size_t capacity = MIN_MESSAGE_BUFFER_SIZE;
+    while (capacity < size)
+    {
+        capacity *= 2;
+    }
+    auto best = mMessageBufferPool.end();
+    for (auto it = mMessageBufferPool.begin(); it != mMessageBufferPool.end(); ++it)
+    {
+        if (it->capacity() >= capacity &&
+            (best == mMessageBufferPool.end() || it->capacity() < best->capacity()))
+        {
+            best = it;
+        }
+    }
+    std::string replacement;
+    if (best != mMessageBufferPool.end())
+    {
+        replacement = std::move(*best);
+        mMessageBufferPool.erase(best);
+    }
     else
     {
-        // Not implemented
-        LOGI("WebSocketService::OnFragmentReceived: Binary data received, but not handled.");
+        replacement.reserve(capacity);
     }
+    replacement.assign(buffer);
+    std::swap(buffer, replacement);
+    ReleaseMessageBuffer(replacement);
 }
 
-void WebSocketService::OnMessageReceived(WebSocketConnection *connection, const std::string &text)
+/**
+ * Return a reassembly buffer to the pool, leaving it empty. A buffer grown by a large message is
+ * freed rather than kept in the pool.
+ */
+void WebSocketService::ReleaseMessageBuffer(std::string &buffer)
 {
-    // Possibly called by the implementation of OnFragmentReceived
+    if (buffer.capacity() >= MIN_MESSAGE_BUFFER_SIZE &&
+        buffer.capacity() <= MAX_KEPT_MESSAGE_BUFFER_SIZE &&
+        mMessageBufferPool.size() < MAX_POOLED_MESSAGE_BUFFERS)
+    {
+        buffer.clear();
+        mMessageBufferPool.push_back(std::move(buffer));
+    }
+    buffer = std::string();
 }
 
 struct lws_protocols WebSocketService::Protocol(const char *protocol_name)
@@ -0,0 +1,111 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JsonResponseWriter.h"
+
+namespace orb
+{
+
+static const char RESULT_PREFIX[] = "{\"result\": ";
+
+JsonResponseWriter::JsonResponseWriter(std::string &buffer)
+    : mBuffer(buffer)
+{
+    mBuffer.clear();
+}
+
+void JsonResponseWriter::WriteResult(const std::string &value)
+{
+    mBuffer.clear();
+    mBuffer.append(RESULT_PREFIX);
+    AppendQuoted(mBuffer, value);
+    mBuffer.push_back('}');
+}
+
+void JsonResponseWriter::WriteResult(const char *value)
+{
+    WriteResult(std::string(value));
+}
+
+void JsonResponseWriter::WriteResult(int value)
+{
+    mBuffer.clear();
+    mBuffer.append(RESULT_PREFIX);
+    mBuffer.append(std::to_string(value));
+    mBuffer.push_back('}');
+}
+
+void JsonResponseWriter::WriteResult(const std::vector<int> &values)
+{
+    WriteArray(values);
+}
+
+void JsonResponseWriter::WriteResult(const std::vector<uint16_t> &values)
+{
+    WriteArray(values);
+}
+
+template<typename T>
+void JsonResponseWriter::WriteArray(const std::vector<T> &values)
+{
+    mBuffer.clear();
+    mBuffer.append(RESULT_PREFIX);
+    mBuffer.push_back('[');
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (i > 0)
+        {
+            mBuffer.push_back(',');
+        }
+        mBuffer.append(std::to_string(values[i]));
+    }
+    mBuffer.append("]}");
+}
+
+void JsonResponseWriter::AppendQuoted(std::string &out, const std::string &value)
+{
+    static const char HEX[] = "0123456789abcdef";
+    out.reserve(out.size() + value.size() + 2);
+    out.push_back('"');
+    for (const char c : value)
+    {
+        switch (c)
+        {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out.append("\\u00");
+                    out.push_back(HEX[(c >> 4) & 0xF]);
+                    out.push_back(HEX[c & 0xF]);
+                }
+                else
+                {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+} // namespace orb
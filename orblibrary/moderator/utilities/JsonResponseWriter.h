@@ -0,0 +1,63 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JSON_RESPONSE_WRITER_H
+#define JSON_RESPONSE_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace orb
+{
+
+/**
+ * Writes JSON responses of the form {"result": <value>} directly into a caller supplied buffer.
+ * Each write replaces the buffer contents but keeps its capacity, so a buffer that is reused
+ * across requests stops allocating once it has grown to the largest response.
+ */
+class JsonResponseWriter
+{
+public:
+    /**
+     * @param buffer The output buffer. Its previous contents are discarded.
+     */
+    explicit JsonResponseWriter(std::string &buffer);
+
+    void WriteResult(const std::string &value);
+    void WriteResult(const char *value);
+    void WriteResult(int value);
+    void WriteResult(const std::vector<int> &values);
+    void WriteResult(const std::vector<uint16_t> &values);
+
+    /**
+     * Append a JSON string literal, including the surrounding quotes, to the output.
+     *
+     * @param out The string to append to.
+     * @param value The unescaped string value.
+     */
+    static void AppendQuoted(std::string &out, const std::string &value);
+
+private:
+    template<typename T>
+    void WriteArray(const std::vector<T> &values);
+
+    std::string &mBuffer;
+}; // class JsonResponseWriter
+
+} // namespace orb
+
+#endif // JSON_RESPONSE_WRITER_H
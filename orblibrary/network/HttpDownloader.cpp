@@ -15,6 +15,7 @@
  */
 
 #include "HttpDownloader.h"
+#include "Metrics.h"
 #include "log.h"
 
 #include <sys/socket.h>
@@ -71,6 +72,33 @@ namespace {
     private:
         SSL_CTX* m_ctx;
     };
+
+    metrics::Counter& DownloadedBytes()
+    {
+        static metrics::Counter &bytes = metrics::Registry::Instance().GetCounter(
+            "orb_http_downloaded_bytes_total", "Bytes of HTTP response bodies downloaded");
+        return bytes;
+    }
+
+    // Records the time taken by a download and counts it if it fails
+    class DownloadRecorder {
+    public:
+        explicit DownloadRecorder(metrics::Histogram& histogram) : m_timer(histogram) {}
+
+        std::shared_ptr<DownloadedObject> Finish(std::shared_ptr<DownloadedObject> result)
+        {
+            static metrics::Counter &failures = metrics::Registry::Instance().GetCounter(
+                "orb_http_download_failures_total",
+                "HTTP downloads that failed or returned a non-2xx status");
+            if (!result || !result->IsSuccess()) {
+                failures.Increment();
+            }
+            return result;
+        }
+
+    private:
+        metrics::ScopedTimer m_timer;
+    };
 }
 
 // DownloadedObject implementation
@@ -349,6 +377,7 @@ std::shared_ptr<DownloadedObject> HttpDownloader::ParseAndCreateResponse(const s
     LOG(INFO) << "HttpDownloader: status=" << statusCode
               << " contentType=" << contentType
               << " bodySize=" << body.length();
+    DownloadedBytes().Increment(body.length());
 
     return std::make_shared<DownloadedObject>(body, contentType, statusCode);
 }
@@ -370,19 +399,23 @@ std::shared_ptr<DownloadedObject> HttpDownloader::Download(const std::string& ur
 std::shared_ptr<DownloadedObject> HttpDownloader::Download(
     const std::string& host, uint16_t port, const std::string& path, bool useHttps)
 {
+    static metrics::Histogram &downloadTime = metrics::Registry::Instance().GetHistogram(
+        "orb_http_download_microseconds", "Time to download an HTTP resource to memory");
+    DownloadRecorder recorder(downloadTime);
+
     LOG(INFO) << "HttpDownloader: " << (useHttps ? "HTTPS" : "HTTP")
               << " GET " << host << ":" << port << path;
 
     // Resolve hostname
     std::string ipAddress = ResolveHostname(host);
     if (ipAddress.empty()) {
-        return nullptr;
+        return recorder.Finish(nullptr);
     }
 
     if (useHttps) {
-        return DownloadHttps(host, port, path, ipAddress);
+        return recorder.Finish(DownloadHttps(host, port, path, ipAddress));
     } else {
-        return DownloadHttp(host, port, path, ipAddress);
+        return recorder.Finish(DownloadHttp(host, port, path, ipAddress));
     }
 }
 
@@ -523,19 +556,23 @@ std::shared_ptr<DownloadedObject> HttpDownloader::DownloadHttps(
 std::shared_ptr<DownloadedObject> HttpDownloader::DownloadToFile(
     const std::string& url, const std::filesystem::path& outputPath)
 {
+    static metrics::Histogram &downloadTime = metrics::Registry::Instance().GetHistogram(
+        "orb_http_download_to_file_microseconds", "Time to download an HTTP resource to a file");
+    DownloadRecorder recorder(downloadTime);
+
     std::string host;
     uint16_t port;
     std::string path;
     bool useHttps;
 
     if (!ParseUrl(url, host, port, path, useHttps)) {
-        return nullptr;
+        return recorder.Finish(nullptr);
     }
 
     // Resolve hostname
     std::string ipAddress = ResolveHostname(host);
     if (ipAddress.empty()) {
-        return nullptr;
+        return recorder.Finish(nullptr);
     }
 
     // Ensure parent directory exists
@@ -545,14 +582,14 @@ std::shared_ptr<DownloadedObject> HttpDownloader::DownloadToFile(
         std::filesystem::create_directories(parentDir, ec);
         if (ec) {
             LOG(ERROR) << "Failed to create directory for download: " << ec.message();
-            return nullptr;
+            return recorder.Finish(nullptr);
         }
     }
 
     if (useHttps) {
-        return DownloadHttpsToFile(host, port, path, ipAddress, outputPath);
+        return recorder.Finish(DownloadHttpsToFile(host, port, path, ipAddress, outputPath));
     } else {
-        return DownloadHttpToFile(host, port, path, ipAddress, outputPath);
+        return recorder.Finish(DownloadHttpToFile(host, port, path, ipAddress, outputPath));
     }
 }
 
@@ -756,6 +793,7 @@ std::shared_ptr<DownloadedObject> HttpDownloader::StreamToFile(
     }
 
     LOG(INFO) << "Downloaded " << bytesWritten << " bytes to " << outputPath;
+    DownloadedBytes().Increment(bytesWritten);
 
     return std::make_shared<DownloadedObject>("", contentType, statusCode);
 }
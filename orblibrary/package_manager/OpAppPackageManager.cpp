@@ -2,6 +2,8 @@
 #include "AitFetcher.h"
 #include "xml_parser.h"
 #include "HttpDownloader.h"
+#include "Metrics.h"
+#include "Trace.h"
 
 #include <cassert>
 #include <mutex>
@@ -179,6 +181,7 @@ bool OpAppPackageManager::isOpAppInstalled()
 
 bool OpAppPackageManager::tryLocalUpdate()
 {
+  ORB_TRACE_SCOPE("OpAppPackageManager::tryLocalUpdate");
   setOpAppUpdateStatus(OpAppUpdateStatus::SOFTWARE_DISCOVERING);
   if (m_Configuration.m_PackageLocation.empty() || m_Configuration.m_InstallReceiptFilePath.empty()) {
     setOpAppUpdateStatus(OpAppUpdateStatus::SOFTWARE_DISCOVERY_FAILED);
@@ -225,6 +228,7 @@ bool OpAppPackageManager::tryLocalUpdate()
 
 bool OpAppPackageManager::tryRemoteUpdate()
 {
+  ORB_TRACE_SCOPE("OpAppPackageManager::tryRemoteUpdate");
   setOpAppUpdateStatus(OpAppUpdateStatus::SOFTWARE_DISCOVERING);
   m_PackageStatus = doRemotePackageCheck();
 
@@ -263,6 +267,14 @@ bool OpAppPackageManager::tryRemoteUpdate()
 
 OpAppPackageManager::PackageStatus OpAppPackageManager::installFromPackageFile()
 {
+  static metrics::Histogram &installTime = metrics::Registry::Instance().GetHistogram(
+      "orb_opapp_package_install_microseconds",
+      "Time to decrypt, verify, unzip and install an OpApp package");
+  static metrics::Counter &installFailures = metrics::Registry::Instance().GetCounter(
+      "orb_opapp_package_install_failures_total", "OpApp package installs that failed");
+  metrics::ScopedTimer timer(installTime);
+  ORB_TRACE_SCOPE("OpAppPackageManager::installFromPackageFile");
+
   // Track intermediate files for cleanup (on both success and failure)
   std::filesystem::path decryptedFile;
   std::filesystem::path zipFile;
@@ -307,6 +319,9 @@ OpAppPackageManager::PackageStatus OpAppPackageManager::installFromPackageFile()
 
   // Always clean up intermediate files before returning
   cleanupIntermediateFiles(decryptedFile, zipFile, unzippedDir);
+  if (result != PackageStatus::Installed) {
+    installFailures.Increment();
+  }
   return result;
 }
 
@@ -353,6 +368,7 @@ void OpAppPackageManager::cleanupIntermediateFiles(
 
 bool OpAppPackageManager::checkForUpdates(bool isFirstInstall)
 {
+  ORB_TRACE_SCOPE("OpAppPackageManager::checkForUpdates");
   // Update and first install is the same operation.
   bool wasInstalled = tryLocalUpdate();
   if (!wasInstalled) {
@@ -453,6 +469,7 @@ OpAppPackageManager::PackageStatus OpAppPackageManager::doLocalPackageCheck()
 
 OpAppPackageManager::PackageStatus OpAppPackageManager::doRemotePackageCheck()
 {
+  ORB_TRACE_SCOPE("OpAppPackageManager::doRemotePackageCheck");
   // Check for a remote package file via AIT acquisition.
   // Needs the FQDN passed in. Use the FQDN from the Configuration::m_OpAppFqdn.
   if (m_Configuration.m_OpAppFqdn.empty()) {
@@ -1138,6 +1155,7 @@ bool OpAppPackageManager::parseAitFiles(
 
 bool OpAppPackageManager::downloadPackageFile(const PackageInfo& packageInfo)
 {
+  ORB_TRACE_SCOPE("OpAppPackageManager::downloadPackageFile");
   // TS 103 606 V1.2.1 Section 6.1.7 - Package Download
   // - HTTP GET request to download the encrypted application package
   // - User-Agent header per ETSI TS 102 796 Section 7.3.2.4 (set in HttpDownloader constructor)
@@ -1149,6 +1167,11 @@ bool OpAppPackageManager::downloadPackageFile(const PackageInfo& packageInfo)
   const int retryDelayMin = m_Configuration.m_DownloadRetryDelayMinSeconds;
   const int retryDelayMax = m_Configuration.m_DownloadRetryDelayMaxSeconds;
   static constexpr const char* EXPECTED_CONTENT_TYPE = "application/vnd.hbbtv.opapp.pkg";
+  static metrics::Counter &downloadAttempts = metrics::Registry::Instance().GetCounter(
+      "orb_opapp_package_download_attempts_total", "OpApp package download attempts");
+  static metrics::Counter &downloadFailures = metrics::Registry::Instance().GetCounter(
+      "orb_opapp_package_download_failures_total",
+      "OpApp package downloads that failed after every attempt");
 
   std::string downloadUrl = packageInfo.getPackageUrl();
   if (downloadUrl.empty()) {
@@ -1187,6 +1210,7 @@ bool OpAppPackageManager::downloadPackageFile(const PackageInfo& packageInfo)
   std::string lastError;
   for (int attempt = 1; attempt <= maxAttempts; ++attempt) {
     LOG(INFO) << "Download attempt " << attempt << " of " << maxAttempts;
+    downloadAttempts.Increment();
 
     auto result = m_HttpDownloader->DownloadToFile(downloadUrl, downloadedFilePath);
 
@@ -1227,6 +1251,7 @@ bool OpAppPackageManager::downloadPackageFile(const PackageInfo& packageInfo)
   }
 
   // All attempts failed
+  downloadFailures.Increment();
   m_LastErrorMessage = "Package download failed after " + std::to_string(maxAttempts) +
                        " attempts. Last error: " + lastError;
   LOG(ERROR) << m_LastErrorMessage;
@@ -35,6 +35,7 @@ public:
     MOCK_METHOD(void, showApplication, (), (override));
     MOCK_METHOD(void, hideApplication, (), (override));
     MOCK_METHOD(std::string, sendRequestToClient, (std::string jsonRequest), (override));
+    MOCK_METHOD(void, sendRequestToClientAsync, (uint32_t requestId, std::string jsonRequest, onClientResponse callback), (override));
     MOCK_METHOD(void, dispatchEvent, (const std::string& etype, const std::string& properties), (override));
     MOCK_METHOD(void, notifyKeySetChange, (const uint16_t keyset, const std::vector<uint16_t> &otherkeys), (override));
 };
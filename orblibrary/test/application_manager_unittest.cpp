@@ -786,6 +786,54 @@ TEST_F(ApplicationManagerTest, TestInKeySetInvalidAppId)
     EXPECT_FALSE(appManager.InKeySet(99999, 403));
 }
 
+TEST_F(ApplicationManagerTest, TestInKeySetReplacedOtherKeys)
+{
+    // GIVEN: ApplicationManager with a created app and KEY_SET_OTHER with a specific key
+    ApplicationManager appManager;
+    appManager.RegisterCallback(APP_TYPE_HBBTV, mockCallback.get());
+
+    EXPECT_CALL(*mockCallback, LoadApplication(
+        testing::_, testing::_, testing::_, testing::_, testing::An<MockApplicationSessionCallback::onPageLoadedSuccess>()))
+        .Times(1);
+
+    int appId = appManager.CreateAndRunApp("http://example.com/app.html", false);
+    appManager.SetKeySetMask(appId, KEY_SET_OTHER, {500});
+
+    // WHEN: the other keys are replaced
+    appManager.SetKeySetMask(appId, KEY_SET_OTHER, {501});
+
+    // THEN: Should return true only for the new key
+    EXPECT_FALSE(appManager.InKeySet(appId, 500));
+    EXPECT_TRUE(appManager.InKeySet(appId, 501));
+}
+
+TEST_F(ApplicationManagerTest, TestInRunningAppKeySet)
+{
+    // GIVEN: ApplicationManager with a running HbbTV app and a keyset
+    ApplicationManager appManager;
+    appManager.RegisterCallback(APP_TYPE_HBBTV, mockCallback.get());
+
+    EXPECT_CALL(*mockCallback, LoadApplication(
+        testing::_, testing::_, testing::_, testing::_, testing::An<MockApplicationSessionCallback::onPageLoadedSuccess>()))
+        .Times(1);
+
+    int appId = appManager.CreateAndRunApp("http://example.com/app.html", false);
+    appManager.SetKeySetMask(appId, KEY_SET_RED, {});
+
+    // WHEN: InRunningAppKeySet is called for the app type
+    // THEN: Should return true only for keys in the keyset of the running app
+    EXPECT_TRUE(appManager.InRunningAppKeySet(APP_TYPE_HBBTV, 403)); // VK_RED
+    EXPECT_FALSE(appManager.InRunningAppKeySet(APP_TYPE_HBBTV, 404)); // VK_GREEN
+    // AND: Should return false for an app type with no running app
+    EXPECT_FALSE(appManager.InRunningAppKeySet(APP_TYPE_OPAPP, 403));
+
+    // WHEN: the app is destroyed
+    appManager.DestroyApplication(appId);
+
+    // THEN: Should return false
+    EXPECT_FALSE(appManager.InRunningAppKeySet(APP_TYPE_HBBTV, 403));
+}
+
 // ============================================================================
 // Unit tests for HbbTVApp SetKeySetMask override
 // ============================================================================
@@ -0,0 +1,225 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "async_logger.h"
+
+using orb::logging::AsyncLogger;
+using orb::logging::CallSite;
+
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        output = tmpfile();
+        ASSERT_NE(output, nullptr);
+    }
+
+    void TearDown() override {
+        fclose(output);
+    }
+
+    std::string ReadOutput() {
+        fflush(output);
+        std::string text;
+        rewind(output);
+        char chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), output)) > 0) {
+            text.append(chunk, n);
+        }
+        return text;
+    }
+
+    static size_t CountLines(const std::string &text) {
+        size_t lines = 0;
+        for (char c : text) {
+            lines += (c == '\n');
+        }
+        return lines;
+    }
+
+    static void WaitForNextSecond() {
+        using namespace std::chrono;
+        auto now = duration_cast<seconds>(steady_clock::now().time_since_epoch());
+        while (duration_cast<seconds>(steady_clock::now().time_since_epoch()) == now) {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+    }
+
+    FILE *output = nullptr;
+};
+
+TEST_F(AsyncLoggerTest, TestSubmit_WritesFormattedLine) {
+    // GIVEN: a logger writing to a file
+    AsyncLogger logger(16, output);
+
+    // WHEN: a message is submitted and flushed
+    logger.Submit(ORB_LOG_LEVEL_WARNING, "/src/dir/file.cpp", "Function", 42, 0, "hello", 5);
+    logger.Flush();
+
+    // THEN: the drain thread has written it with its prefix
+    EXPECT_EQ(ReadOutput(), "[WARNING] file.cpp:Function:42: hello\n");
+}
+
+TEST_F(AsyncLoggerTest, TestSubmit_WakesIdleDrainThread) {
+    // GIVEN: a logger whose drain thread has gone idle, writing to a file read through another
+    // stream so that reading does not move the write position
+    char path[] = "/tmp/async_logger_unittestXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    FILE *file = fdopen(fd, "w");
+    AsyncLogger logger(16, file);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // WHEN: a message is submitted without a flush
+    logger.Submit(ORB_LOG_LEVEL_INFO, "file.cpp", "Function", 1, 0, "wake", 4);
+
+    // THEN: the drain thread is woken and writes it
+    std::string text;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (text.empty() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        FILE *reader = fopen(path, "r");
+        ASSERT_NE(reader, nullptr);
+        char chunk[256];
+        size_t n = fread(chunk, 1, sizeof(chunk), reader);
+        text.assign(chunk, n);
+        fclose(reader);
+    }
+    EXPECT_EQ(text, "[INFO] file.cpp:Function:1: wake\n");
+    logger.Flush();
+    fclose(file);
+    unlink(path);
+}
+
+TEST_F(AsyncLoggerTest, TestSubmit_ReportsSuppressedCount) {
+    // GIVEN: a logger writing to a file
+    AsyncLogger logger(16, output);
+
+    // WHEN: a message follows some that were rate limited
+    logger.Submit(ORB_LOG_LEVEL_INFO, "file.cpp", "Function", 1, 3, "again", 5);
+    logger.Flush();
+
+    // THEN: the number suppressed is appended
+    EXPECT_EQ(ReadOutput(), "[INFO] file.cpp:Function:1: again (3 similar messages suppressed)\n");
+}
+
+TEST_F(AsyncLoggerTest, TestSubmit_TruncatesLongMessage) {
+    // GIVEN: a logger writing to a file
+    AsyncLogger logger(16, output);
+    std::string message(AsyncLogger::MAX_MESSAGE_LENGTH * 2, 'x');
+
+    // WHEN: a message longer than the slot is submitted
+    logger.Submit(ORB_LOG_LEVEL_ERROR, "file.cpp", "Function", 1, 0, message.data(), message.size());
+    logger.Flush();
+
+    // THEN: it is written truncated
+    std::string expected = "[ERROR] file.cpp:Function:1: " +
+        std::string(AsyncLogger::MAX_MESSAGE_LENGTH, 'x') + "\n";
+    EXPECT_EQ(ReadOutput(), expected);
+}
+
+TEST_F(AsyncLoggerTest, TestSubmit_DropsWhenFull) {
+    // GIVEN: a logger with a small ring buffer
+    AsyncLogger logger(4, output);
+    const size_t submitted = 10000;
+
+    // WHEN: messages are submitted faster than they can be written
+    for (size_t i = 0; i < submitted; i++) {
+        logger.Submit(ORB_LOG_LEVEL_INFO, "file.cpp", "Function", 1, 0, "message", 7);
+    }
+    logger.Flush();
+
+    // THEN: every message is either written or counted as dropped
+    EXPECT_GT(logger.GetDroppedCount(), 0u);
+    EXPECT_EQ(CountLines(ReadOutput()) + logger.GetDroppedCount(), submitted);
+}
+
+TEST_F(AsyncLoggerTest, TestSubmit_ManyProducers) {
+    // GIVEN: a logger large enough to hold every message
+    AsyncLogger logger(4096, output);
+
+    // WHEN: several threads submit at once
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&logger] {
+            for (int i = 0; i < 500; i++) {
+                logger.Submit(ORB_LOG_LEVEL_INFO, "file.cpp", "Function", i, 0, "message", 7);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    logger.Flush();
+
+    // THEN: every message is written
+    EXPECT_EQ(logger.GetDroppedCount(), 0u);
+    EXPECT_EQ(CountLines(ReadOutput()), 2000u);
+}
+
+TEST_F(AsyncLoggerTest, TestCallSite_RateLimited) {
+    // GIVEN: a call site at the start of a one second window
+    CallSite site;
+    uint32_t suppressed = 0;
+    int allowed = 0;
+    WaitForNextSecond();
+
+    // WHEN: it logs more than the limit within the window
+    for (int i = 0; i < ORB_LOG_RATE_LIMIT + 5; i++) {
+        allowed += site.Allow(suppressed);
+    }
+
+    // THEN: only the limit is allowed
+    EXPECT_EQ(allowed, ORB_LOG_RATE_LIMIT);
+
+    // WHEN: the next window starts
+    WaitForNextSecond();
+
+    // THEN: the next message is allowed and reports the number suppressed
+    EXPECT_TRUE(site.Allow(suppressed));
+    EXPECT_EQ(suppressed, 5u);
+}
+
+TEST_F(AsyncLoggerTest, TestMacro_ErrorNotRateLimited) {
+    // GIVEN: the shared logger writing to a file
+    AsyncLogger &logger = AsyncLogger::Instance();
+    logger.SetOutput(output);
+    WaitForNextSecond();
+
+    // WHEN: one ERROR statement logs more than the limit within a second
+    for (int i = 0; i < ORB_LOG_RATE_LIMIT + 5; i++) {
+        ORB_ASYNC_LOG(ERROR) << "error " << i;
+    }
+    logger.Flush();
+    logger.SetOutput(stdout);
+
+    // THEN: every message is written
+    EXPECT_EQ(CountLines(ReadOutput()), static_cast<size_t>(ORB_LOG_RATE_LIMIT + 5));
+}
+
+TEST_F(AsyncLoggerTest, TestMacro_RunLevel) {
+    // GIVEN: the shared logger writing to a file with a run level of WARNING
+    AsyncLogger &logger = AsyncLogger::Instance();
+    logger.SetOutput(output);
+    logger.SetRunLevel(ORB_LOG_LEVEL_WARNING);
+
+    // WHEN: messages are logged at INFO and ERROR
+    ORB_ASYNC_LOG(INFO) << "hidden " << 1;
+    ORB_ASYNC_LOG(ERROR) << "shown " << 2;
+    logger.Flush();
+    logger.SetRunLevel(ORB_LOG_LEVEL_DEBUG);
+    logger.SetOutput(stdout);
+
+    // THEN: only the ERROR message is written
+    std::string text = ReadOutput();
+    EXPECT_EQ(CountLines(text), 1u);
+    EXPECT_NE(text.find("[ERROR] async_logger_unittest.cpp:TestBody:"), std::string::npos);
+    EXPECT_NE(text.find(": shown 2\n"), std::string::npos);
+}
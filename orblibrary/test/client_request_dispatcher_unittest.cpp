@@ -0,0 +1,191 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Unit tests for ClientRequestDispatcher
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "ClientRequestDispatcher.h"
+#include "MockOrbBrowser.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+
+namespace orb
+{
+
+/**
+ * Browser that only implements the synchronous request, so uses the default async behaviour
+ */
+class SyncOrbBrowser : public IOrbBrowser
+{
+public:
+    void loadApplication(std::string, std::string, onPageLoadedSuccess) override {}
+    void showApplication() override {}
+    void hideApplication() override {}
+    std::string sendRequestToClient(std::string jsonRequest) override
+    {
+        requests.push_back(jsonRequest);
+        return "response to " + jsonRequest;
+    }
+    void dispatchEvent(const std::string&, const std::string&) override {}
+    void notifyKeySetChange(const uint16_t, const std::vector<uint16_t>&) override {}
+
+    std::vector<std::string> requests;
+};
+
+class ClientRequestDispatcherTest : public ::testing::Test
+{
+protected:
+    /**
+     * Make the mock browser hold on to requests until the test completes them
+     */
+    void HoldRequests()
+    {
+        EXPECT_CALL(mockBrowser, sendRequestToClientAsync(_, _, _))
+            .WillRepeatedly(Invoke([this](uint32_t id, std::string request, onClientResponse callback) {
+                sent.push_back(request);
+                pending[request] = [id, callback](std::string response) { callback(id, response); };
+            }));
+    }
+
+    void CompleteRequest(const std::string &request, const std::string &response)
+    {
+        auto complete = pending.at(request);
+        pending.erase(request);
+        complete(response);
+    }
+
+    MockOrbBrowser mockBrowser;
+    std::vector<std::string> sent;
+    std::map<std::string, std::function<void(std::string)>> pending;
+};
+
+TEST_F(ClientRequestDispatcherTest, TestSendCompletesWithResponse)
+{
+    // GIVEN: a dispatcher over a browser that answers later
+    HoldRequests();
+    ClientRequestDispatcher dispatcher(&mockBrowser, 4);
+    std::string response;
+
+    // WHEN: a request is sent and later answered
+    dispatcher.Send("request", [&response](std::string r) { response = r; });
+    EXPECT_EQ(dispatcher.GetInFlightCount(), 1u);
+    EXPECT_TRUE(response.empty());
+    CompleteRequest("request", "answer");
+
+    // THEN: the callback gets the response and the request is no longer in flight
+    EXPECT_EQ(response, "answer");
+    EXPECT_EQ(dispatcher.GetInFlightCount(), 0u);
+}
+
+TEST_F(ClientRequestDispatcherTest, TestRequestIdsAreUnique)
+{
+    // GIVEN: a dispatcher
+    HoldRequests();
+    ClientRequestDispatcher dispatcher(&mockBrowser, 4);
+
+    // WHEN: several requests are sent
+    uint32_t first = dispatcher.Send("a", [](std::string) {});
+    uint32_t second = dispatcher.Send("b", [](std::string) {});
+
+    // THEN: each gets its own non-zero ID
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(first, second);
+}
+
+TEST_F(ClientRequestDispatcherTest, TestWindowBoundsRequestsInFlight)
+{
+    // GIVEN: a dispatcher with a window of two requests
+    HoldRequests();
+    ClientRequestDispatcher dispatcher(&mockBrowser, 2);
+    std::vector<std::string> responses;
+    auto collect = [&responses](std::string r) { responses.push_back(r); };
+
+    // WHEN: four requests are sent
+    dispatcher.Send("a", collect);
+    dispatcher.Send("b", collect);
+    dispatcher.Send("c", collect);
+    dispatcher.Send("d", collect);
+
+    // THEN: only two reach the client and the others wait
+    EXPECT_EQ(sent, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(dispatcher.GetInFlightCount(), 2u);
+    EXPECT_EQ(dispatcher.GetQueuedCount(), 2u);
+
+    // WHEN: a request completes out of order
+    CompleteRequest("b", "B");
+
+    // THEN: the oldest waiting request takes its place
+    EXPECT_EQ(sent, (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(dispatcher.GetQueuedCount(), 1u);
+
+    // WHEN: the remaining requests complete
+    CompleteRequest("a", "A");
+    CompleteRequest("d", "D");
+    CompleteRequest("c", "C");
+
+    // THEN: every response is delivered in completion order
+    EXPECT_EQ(responses, (std::vector<std::string>{"B", "A", "D", "C"}));
+    EXPECT_EQ(dispatcher.GetInFlightCount(), 0u);
+    EXPECT_EQ(dispatcher.GetQueuedCount(), 0u);
+}
+
+TEST_F(ClientRequestDispatcherTest, TestDefaultAsyncCompletesInline)
+{
+    // GIVEN: a browser that only answers synchronously and a window of one
+    SyncOrbBrowser browser;
+    ClientRequestDispatcher dispatcher(&browser, 1);
+    std::vector<std::string> responses;
+
+    // WHEN: requests are sent, including one from a completion callback
+    dispatcher.Send("a", [&](std::string r) {
+        responses.push_back(r);
+        dispatcher.Send("c", [&](std::string r) { responses.push_back(r); });
+    });
+    dispatcher.Send("b", [&](std::string r) { responses.push_back(r); });
+
+    // THEN: every request completes before Send returns
+    EXPECT_EQ(browser.requests, (std::vector<std::string>{"a", "c", "b"}));
+    EXPECT_EQ(responses, (std::vector<std::string>{"response to a", "response to c", "response to b"}));
+    EXPECT_EQ(dispatcher.GetInFlightCount(), 0u);
+}
+
+TEST_F(ClientRequestDispatcherTest, TestDestructionCancelsWaitingRequests)
+{
+    // GIVEN: a dispatcher with one request in flight and one waiting
+    HoldRequests();
+    auto dispatcher = std::make_unique<ClientRequestDispatcher>(&mockBrowser, 1);
+    std::string inFlightResponse;
+    std::string waitingResponse;
+    dispatcher->Send("a", [&](std::string r) { inFlightResponse = r; });
+    dispatcher->Send("b", [&](std::string r) { waitingResponse = r; });
+
+    // WHEN: the dispatcher is destroyed and the client answers afterwards
+    dispatcher.reset();
+    CompleteRequest("a", "late");
+
+    // THEN: the waiting request is cancelled and the late response is dropped
+    EXPECT_EQ(waitingResponse, R"({"error": "Request cancelled"})");
+    EXPECT_TRUE(inFlightResponse.empty());
+    EXPECT_EQ(sent, (std::vector<std::string>{"a"}));
+}
+
+} // namespace orb
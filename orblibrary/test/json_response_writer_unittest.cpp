@@ -0,0 +1,76 @@
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "JsonResponseWriter.h"
+#include "JsonUtil.h"
+
+class JsonResponseWriterTest : public ::testing::Test {
+protected:
+    std::string buffer;
+};
+
+TEST_F(JsonResponseWriterTest, TestWriteResult_String) {
+    // GIVEN: a writer over an empty buffer
+    orb::JsonResponseWriter writer(buffer);
+
+    // WHEN: a string result is written
+    writer.WriteResult(std::string("value"));
+
+    // THEN: the buffer holds the response
+    EXPECT_EQ(buffer, R"({"result": "value"})");
+}
+
+TEST_F(JsonResponseWriterTest, TestWriteResult_Integer) {
+    // GIVEN: a writer over an empty buffer
+    orb::JsonResponseWriter writer(buffer);
+
+    // WHEN: an integer result is written
+    writer.WriteResult(-42);
+
+    // THEN: the buffer holds the response
+    EXPECT_EQ(buffer, R"({"result": -42})");
+}
+
+TEST_F(JsonResponseWriterTest, TestWriteResult_Arrays) {
+    // GIVEN: a writer over an empty buffer
+    orb::JsonResponseWriter writer(buffer);
+
+    // WHEN: empty and non-empty arrays are written
+    writer.WriteResult(std::vector<int>{});
+    std::string empty = buffer;
+    writer.WriteResult(std::vector<uint16_t>{1, 2, 0x416});
+
+    // THEN: each write replaces the previous response
+    EXPECT_EQ(empty, R"({"result": []})");
+    EXPECT_EQ(buffer, R"({"result": [1,2,1046]})");
+}
+
+TEST_F(JsonResponseWriterTest, TestWriteResult_ReusesBuffer) {
+    // GIVEN: a buffer that already holds a large response
+    buffer.assign(1024, 'x');
+    const size_t capacity = buffer.capacity();
+
+    // WHEN: a smaller response is written
+    orb::JsonResponseWriter writer(buffer);
+    writer.WriteResult(1);
+
+    // THEN: the old contents are replaced and the capacity is kept
+    EXPECT_EQ(buffer, R"({"result": 1})");
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST_F(JsonResponseWriterTest, TestWriteResult_EscapesString) {
+    // GIVEN: a string with characters that must be escaped
+    std::string value = "quote\" backslash\\ newline\n tab\t control\x01 url/path";
+    orb::JsonResponseWriter writer(buffer);
+
+    // WHEN: the string result is written
+    writer.WriteResult(value);
+
+    // THEN: the response parses back to the same string
+    Json::Value json;
+    ASSERT_TRUE(orb::JsonUtil::decodeJson(buffer, &json));
+    EXPECT_EQ(json["result"].asString(), value);
+}
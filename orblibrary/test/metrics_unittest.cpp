@@ -0,0 +1,102 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "Metrics.h"
+
+using orb::metrics::Counter;
+using orb::metrics::Histogram;
+using orb::metrics::Registry;
+
+TEST(MetricsTest, TestCounterSumsIncrementsFromEveryThread) {
+    // GIVEN: a counter
+    Counter counter;
+
+    // WHEN: incrementing it from several threads
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < 10000; j++) {
+                counter.Increment();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    counter.Increment(5);
+
+    // THEN: the value should be the total of all increments
+    EXPECT_EQ(counter.Value(), 80005u);
+}
+
+TEST(MetricsTest, TestHistogramBucketsCoverValues) {
+    // GIVEN: values across the whole range
+    const uint64_t values[] = {0, 1, 7, 8, 9, 15, 16, 17, 100, 1000, 123456789, UINT64_MAX};
+
+    for (uint64_t value : values) {
+        // WHEN: finding the bucket for the value
+        size_t index = Histogram::BucketIndex(value);
+
+        // THEN: the bucket should hold the value and be no wider than 1/8 of it
+        ASSERT_LT(index, Histogram::BUCKETS);
+        uint64_t upperBound = Histogram::BucketUpperBound(index);
+        EXPECT_GE(upperBound, value);
+        EXPECT_LE(upperBound - value, value / 8);
+        if (index > 0) {
+            EXPECT_LT(Histogram::BucketUpperBound(index - 1), value);
+        }
+    }
+}
+
+TEST(MetricsTest, TestHistogramQuantiles) {
+    // GIVEN: a histogram with the values 1 to 1000
+    Histogram histogram;
+    for (uint64_t value = 1; value <= 1000; value++) {
+        histogram.Record(value);
+    }
+
+    // WHEN: taking a snapshot
+    Histogram::Snapshot snapshot = histogram.GetSnapshot();
+
+    // THEN: the count, sum and max should be exact, and the quantiles within 12.5%
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.sum, 500500u);
+    EXPECT_EQ(snapshot.max, 1000u);
+    EXPECT_NEAR(snapshot.ValueAtQuantile(0.5), 500, 500 / 8);
+    EXPECT_NEAR(snapshot.ValueAtQuantile(0.99), 990, 990 / 8);
+    EXPECT_EQ(snapshot.ValueAtQuantile(1.0), 1000u);
+}
+
+TEST(MetricsTest, TestRegistryReturnsSameMetricForName) {
+    // GIVEN: a registry
+    Registry registry;
+
+    // WHEN: getting a counter twice by the same name
+    Counter &first = registry.GetCounter("orb_test_events_total", "Test events");
+    Counter &second = registry.GetCounter("orb_test_events_total");
+
+    // THEN: both should be the same counter
+    EXPECT_EQ(&first, &second);
+}
+
+TEST(MetricsTest, TestRegistryWritesJsonAndPrometheusText) {
+    // GIVEN: a registry with a counter and a histogram
+    Registry registry;
+    registry.GetCounter("orb_test_events_total", "Test events").Increment(3);
+    registry.GetHistogram("orb_test_microseconds", "Test latency").Record(4);
+
+    // WHEN: writing the metrics in each format
+    std::string json = registry.Write(Registry::Format::JSON);
+    std::string text = registry.Write(Registry::Format::PROMETHEUS_TEXT);
+
+    // THEN: the metrics should be written
+    EXPECT_EQ(json, "{\"counters\":{\"orb_test_events_total\":3},\"histograms\":"
+        "{\"orb_test_microseconds\":{\"count\":1,\"sum\":4,\"max\":4,\"p50\":4,\"p90\":4,"
+        "\"p99\":4}}}");
+    EXPECT_NE(text.find("# TYPE orb_test_events_total counter\norb_test_events_total 3\n"),
+        std::string::npos);
+    EXPECT_NE(text.find("orb_test_microseconds{quantile=\"0.99\"} 4\n"), std::string::npos);
+    EXPECT_NE(text.find("orb_test_microseconds_count 1\n"), std::string::npos);
+}
@@ -64,76 +64,12 @@ protected:
         g_mockJson = std::move(mockJson);
     }
 
-    void setupJsonParsing(const std::string& input, bool parseResult, const std::string& methodValue = "") {
-        EXPECT_CALL(*mockJson, parse(input))
-            .WillOnce(::testing::Return(parseResult));
-
-        if (!methodValue.empty()) {
-            EXPECT_CALL(*mockJson, getString("method"))
-             .WillOnce(::testing::Return(methodValue));
-        }
-
-        finishMockPrepare();
-    }
-
-    /**
-     * Set up expectations for error request handling
-     */
-    void setupErrorRequestHandling(const std::string& input) {
-        EXPECT_CALL(*mockJson, parse(input))
-            .WillOnce(::testing::Return(true));
-        EXPECT_CALL(*mockJson, hasParam("error", orb::IJson::JSON_TYPE_OBJECT))
-            .WillOnce(::testing::Return(true));
-        finishMockPrepare();
-    }
-
-    /**
-     * Set up expectations for invalid method handling
-     */
-    void setupNoMethodHandling(const std::string& input) {
-      EXPECT_CALL(*mockJson, parse(input))
-            .WillOnce(::testing::Return(true));
-        EXPECT_CALL(*mockJson, hasParam("method", orb::IJson::JSON_TYPE_STRING))
-            .WillOnce(::testing::Return(false));
-        EXPECT_CALL(*mockJson, hasParam("error", orb::IJson::JSON_TYPE_OBJECT))
-            .WillOnce(::testing::Return(false));
-        finishMockPrepare();
-    }
-
     /**
-     * Set up expectations for valid method handling
+     * Set up the application type reported for requests. The moderator adds it to the params.
      */
-    void setupHandleOrbRequest(const std::string& input, const std::string& methodValue,
-        const std::string& resultValue, bool isForRequestToClient = false) {
-        auto anotherMockParams = std::make_unique<orb::MockJson>();
-        EXPECT_CALL(*mockJson, parse(input))
-            .WillOnce(::testing::Return(true));
-        EXPECT_CALL(*mockJson, hasParam("error", orb::IJson::JSON_TYPE_OBJECT))
-            .WillOnce(::testing::Return(false));
-        EXPECT_CALL(*mockJson, hasParam("method", orb::IJson::JSON_TYPE_STRING))
-            .WillOnce(::testing::Return(true));
-        EXPECT_CALL(*mockJson, hasParam("params", orb::IJson::JSON_TYPE_OBJECT))
-            .WillOnce(::testing::Return(true));
-        EXPECT_CALL(*mockJson, getString("method"))
-            .WillOnce(::testing::Return(methodValue));
-        EXPECT_CALL(*mockJson, getString("token"))
-            .WillOnce(::testing::Return("token"));
-
-         int appType = orb::APP_TYPE_HBBTV;
-         EXPECT_CALL(*mockJson, setInteger("params",  appType, "applicationType"))
-            .WillOnce(::testing::Return());
-        if (isForRequestToClient) {
-            EXPECT_CALL(*mockJson, toString())
-            .WillOnce(::testing::Return(methodValue));
-
-            EXPECT_CALL(*mockBrowser, sendRequestToClient(methodValue))
-                .WillOnce(::testing::Return(resultValue));
-        }
-
-        EXPECT_CALL(*mockJson, getObject("params"))
-            .WillOnce(::testing::Return(::testing::ByMove(std::move(anotherMockParams))));
-
-        finishMockPrepare();
+    void setupApplicationType(orb::ApplicationType appType) {
+        EXPECT_CALL(*mockAppMgrInterface, GetApplicationType())
+            .WillRepeatedly(::testing::Return(appType));
     }
 
      // Mock objects available to all test methods
@@ -145,7 +81,6 @@ protected:
 
 TEST_F(ModeratorTest, HandleOrbRequestEmptyRequest)
 {
-    setupJsonParsing("", false);
     auto moderator = createModerator();
     std::string response = moderator->handleOrbRequest("");
     EXPECT_EQ(response, R"({"error": "Invalid Request"})");
@@ -153,15 +88,20 @@ TEST_F(ModeratorTest, HandleOrbRequestEmptyRequest)
 
 TEST_F(ModeratorTest, HandleOrbRequestInvalidJsonRequest)
 {
-    setupJsonParsing("invalid json", false);
     auto moderator = createModerator();
     std::string response = moderator->handleOrbRequest("invalid json");
     EXPECT_EQ(response, R"({"error": "Invalid Request"})");
 }
 
+TEST_F(ModeratorTest, HandleOrbRequestNonObjectRequest)
+{
+    auto moderator = createModerator();
+    std::string response = moderator->handleOrbRequest(R"([ "method", "params" ])");
+    EXPECT_EQ(response, R"({"error": "Invalid Request"})");
+}
+
 TEST_F(ModeratorTest, HandleOrbRequestNoMethod)
 {
-    setupNoMethodHandling(R"({ "NotAMethod": { "Some": "Value" }})");
     auto moderator = createModerator();
     std::string response = moderator->handleOrbRequest(R"({ "NotAMethod": { "Some": "Value" }})");
     EXPECT_EQ(response, R"({"error": "No method"})");
@@ -169,50 +109,152 @@ TEST_F(ModeratorTest, HandleOrbRequestNoMethod)
 
 TEST_F(ModeratorTest, HandleOrbRequestErrorRequest)
 {
-    setupErrorRequestHandling(R"({ "error": { "Some": "Value" }})");
     auto moderator = createModerator();
     std::string response = moderator->handleOrbRequest(R"({ "error": { "Some": "Value" }})");
     EXPECT_EQ(response, R"({"error": "Error Request"})");
 }
 
+TEST_F(ModeratorTest, HandleOrbRequestNoParams)
+{
+    auto moderator = createModerator();
+    std::string response = moderator->handleOrbRequest(R"({ "method": "Manager.showApplication" })");
+    EXPECT_EQ(response, R"({"error": "No params"})");
+}
+
+TEST_F(ModeratorTest, HandleOrbRequestInvalidMethod)
+{
+    setupApplicationType(orb::APP_TYPE_HBBTV);
+    auto moderator = createModerator();
+    std::string response = moderator->handleOrbRequest(R"({ "method": "showApplication", "params": {} })");
+    EXPECT_EQ(response, R"({"error": "Invalid method"})");
+}
+
 TEST_F(ModeratorTest, HandleOrbRequestForApplicationManager)
 {
+    setupApplicationType(orb::APP_TYPE_OPAPP);
     EXPECT_CALL(*mockAppMgrInterface, executeRequest("showApplication", "token", ::testing::_))
-        .WillOnce(::testing::Return(R"({"result": ""})"));
-    setupHandleOrbRequest(R"({ "method": "Manager.showApplication" })", "Manager.showApplication", R"({"result": ""})");
+        .WillOnce([](const std::string&, const std::string&, const orb::IJson& params) {
+            EXPECT_EQ(params.getInteger("id"), 3);
+            EXPECT_EQ(params.getInteger("applicationType"), orb::APP_TYPE_OPAPP);
+            return std::string(R"({"result": ""})");
+        });
     auto moderator = createModerator();
-    std::string response = moderator->handleOrbRequest(R"({ "method": "Manager.showApplication" })");
+    std::string response = moderator->handleOrbRequest(
+        R"({ "method": "Manager.showApplication", "token": "token", "params": { "id": 3 } })");
     EXPECT_EQ(response, R"({"result": ""})");
 }
 
 TEST_F(ModeratorTest, HandleOrbRequestForDrm)
 {
+    setupApplicationType(orb::APP_TYPE_HBBTV);
     EXPECT_CALL(*mockDrm, executeRequest("setActiveDRM", "token", ::testing::_))
-        .WillOnce(::testing::Return(R"({"result": false})"));
-    setupHandleOrbRequest(R"({ "method": "Drm.setActiveDRM" })", "Drm.setActiveDRM", R"({"result": false})");
+        .WillOnce([](const std::string&, const std::string&, const orb::IJson& params) {
+            EXPECT_EQ(params.getString("DRMSystemID"), "urn:dvb:casystemid:19219");
+            return std::string(R"({"result": false})");
+        });
     auto moderator = createModerator();
-    std::string response = moderator->handleOrbRequest(R"({ "method": "Drm.setActiveDRM" })");
+    std::string response = moderator->handleOrbRequest(
+        R"({ "method": "Drm.setActiveDRM", "token": "token", "params": { "DRMSystemID": "urn:dvb:casystemid:19219" } })");
     EXPECT_EQ(response, R"({"result": false})");
 }
 
 TEST_F(ModeratorTest, HandleOrbRequestForNetwork)
 {
+    setupApplicationType(orb::APP_TYPE_HBBTV);
     std::string result = R"({"Response": "Network request [resolveHostAddress] not implemented"})";
-    setupHandleOrbRequest(R"({ "method": "Network.resolveHostAddress" })", "Network.resolveHostAddress", result);
     auto moderator = createModerator();
-    std::string response = moderator->handleOrbRequest(R"({ "method": "Network.resolveHostAddress" })");
+    std::string response = moderator->handleOrbRequest(
+        R"({ "method": "Network.resolveHostAddress", "token": "token", "params": {} })");
     EXPECT_EQ(response, result);
 }
 
 TEST_F(ModeratorTest, HandleOrbRequestForSendRequestToClient)
 {
+    setupApplicationType(orb::APP_TYPE_HBBTV);
     std::string result = R"({"result": "OrbClient Response"})";
-    setupHandleOrbRequest(R"({ "method": "Broadcast.SetChannel" })", "Broadcast.SetChannel", result, true);
+    // The request is forwarded byte for byte, apart from applicationType inserted into params
+    EXPECT_CALL(*mockBrowser, sendRequestToClient(
+        R"({ "method": "Broadcast.setChannel", "token": "token", "params": {"applicationType":0, "ccid": "ccid:1" } })"))
+        .WillOnce(::testing::Return(result));
     auto moderator = createModerator();
-    std::string response = moderator->handleOrbRequest(R"({ "method": "Broadcast.SetChannel" })");
+    std::string response = moderator->handleOrbRequest(
+        R"({ "method": "Broadcast.setChannel", "token": "token", "params": { "ccid": "ccid:1" } })");
     EXPECT_EQ(response, result);
 }
 
+TEST_F(ModeratorTest, HandleOrbRequestForSendRequestToClientEmptyParams)
+{
+    setupApplicationType(orb::APP_TYPE_OPAPP);
+    EXPECT_CALL(*mockBrowser, sendRequestToClient(
+        R"({"method":"Broadcast.getChannelList","params":{"applicationType":1}})"))
+        .WillOnce(::testing::Return(R"({"result": []})"));
+    auto moderator = createModerator();
+    std::string response = moderator->handleOrbRequest(
+        R"({"method":"Broadcast.getChannelList","params":{}})");
+    EXPECT_EQ(response, R"({"result": []})");
+}
+
+TEST_F(ModeratorTest, HandleOrbRequestForSendRequestToClientReplacesApplicationType)
+{
+    setupApplicationType(orb::APP_TYPE_OPAPP);
+    // The request cannot be patched in place, so it is serialised again with the new value
+    EXPECT_CALL(*mockBrowser, sendRequestToClient(::testing::_))
+        .WillOnce([](std::string request) {
+            EXPECT_EQ(request.find(R"("applicationType" : 0)"), std::string::npos);
+            EXPECT_NE(request.find(R"("applicationType" : 1)"), std::string::npos);
+            return std::string(R"({"result": true})");
+        });
+    auto moderator = createModerator();
+    std::string response = moderator->handleOrbRequest(
+        R"({"method":"Broadcast.setChannel","params":{"applicationType":0}})");
+    EXPECT_EQ(response, R"({"result": true})");
+}
+
+TEST_F(ModeratorTest, HandleOrbRequestAsyncForApplicationManager)
+{
+    setupApplicationType(orb::APP_TYPE_HBBTV);
+    EXPECT_CALL(*mockAppMgrInterface, executeRequest("getKeyValues", "token", ::testing::_))
+        .WillOnce(::testing::Return(R"({"result": 1})"));
+    auto moderator = createModerator();
+    std::string response;
+    moderator->handleOrbRequestAsync(
+        R"({ "method": "Manager.getKeyValues", "token": "token", "params": { "id": 1 } })",
+        [&response](std::string r) { response = r; });
+    EXPECT_EQ(response, R"({"result": 1})");
+}
+
+TEST_F(ModeratorTest, HandleOrbRequestAsyncInvalidRequest)
+{
+    auto moderator = createModerator();
+    std::string response;
+    moderator->handleOrbRequestAsync("invalid json", [&response](std::string r) { response = r; });
+    EXPECT_EQ(response, R"({"error": "Invalid Request"})");
+}
+
+TEST_F(ModeratorTest, HandleOrbRequestAsyncForSendRequestToClient)
+{
+    setupApplicationType(orb::APP_TYPE_HBBTV);
+    orb::onClientResponse complete;
+    uint32_t requestId = 0;
+    EXPECT_CALL(*mockBrowser, sendRequestToClientAsync(::testing::_,
+        R"({"method":"Broadcast.getChannelList","params":{"applicationType":0}})", ::testing::_))
+        .WillOnce([&](uint32_t id, std::string, orb::onClientResponse callback) {
+            requestId = id;
+            complete = callback;
+        });
+    EXPECT_CALL(*mockBrowser, sendRequestToClient(::testing::_)).Times(0);
+    auto moderator = createModerator();
+    std::string response;
+    moderator->handleOrbRequestAsync(R"({"method":"Broadcast.getChannelList","params":{}})",
+        [&response](std::string r) { response = r; });
+
+    // The moderator returns before the client has answered
+    EXPECT_TRUE(response.empty());
+    ASSERT_TRUE(complete);
+    complete(requestId, R"({"result": []})");
+    EXPECT_EQ(response, R"({"result": []})");
+}
+
 TEST_F(ModeratorTest, HandleBridgeEventForChannelStatusChange)
 {
     std::string etype = orb::CHANNEL_STATUS_CHANGE;
@@ -0,0 +1,87 @@
+#include <string>
+#include <thread>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "Trace.h"
+
+using orb::metrics::Tracer;
+using orb::metrics::TRACE_EVENTS_PER_THREAD;
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tracer::Instance().Clear();
+    }
+
+    static size_t Count(const std::string &text, const std::string &pattern) {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos;
+             pos = text.find(pattern, pos + 1)) {
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(TraceTest, TestScopeRecordsCompleteEvent) {
+    // GIVEN: a scope that has ended
+    {
+        ORB_TRACE_SCOPE("TraceTest::Scope");
+    }
+
+    // WHEN: writing the trace
+    std::string trace = Tracer::Instance().Write();
+
+    // THEN: the trace should hold a complete event with a duration
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(trace.find("{\"name\":\"TraceTest::Scope\",\"cat\":\"orb\",\"ph\":\"X\""),
+        std::string::npos);
+    EXPECT_NE(trace.find("\"dur\":"), std::string::npos);
+}
+
+TEST_F(TraceTest, TestAsyncSpanAcrossThreads) {
+    // GIVEN: an async span begun on one thread
+    ORB_TRACE_ASYNC_BEGIN("TraceTest::Async", 42);
+
+    // WHEN: ending it on another thread
+    std::thread thread([] {
+        ORB_TRACE_ASYNC_END("TraceTest::Async", 42);
+    });
+    thread.join();
+
+    // THEN: the trace should hold both ends with the same id, recorded by the exited thread too
+    std::string trace = Tracer::Instance().Write();
+    EXPECT_EQ(Count(trace, "\"ph\":\"b\""), 1u);
+    EXPECT_EQ(Count(trace, "\"ph\":\"e\""), 1u);
+    EXPECT_EQ(Count(trace, "\"id\":\"0x2a\""), 2u);
+}
+
+TEST_F(TraceTest, TestExitedThreadBufferIsReused) {
+    // GIVEN: threads that record an event and exit one after another
+    for (int i = 0; i < 8; i++) {
+        std::thread thread([] {
+            ORB_TRACE_INSTANT("TraceTest::ShortLived");
+        });
+        thread.join();
+    }
+
+    // WHEN: writing the trace
+    std::string trace = Tracer::Instance().Write();
+
+    // THEN: each thread should have taken over the buffer of the one before, so only the event
+    // of the last thread is left
+    EXPECT_EQ(Count(trace, "TraceTest::ShortLived"), 1u);
+}
+
+TEST_F(TraceTest, TestRingBufferKeepsNewestEvents) {
+    // GIVEN: more events on a thread than its buffer holds
+    for (size_t i = 0; i < TRACE_EVENTS_PER_THREAD + 10; i++) {
+        ORB_TRACE_INSTANT("TraceTest::Instant");
+    }
+
+    // WHEN: writing the trace
+    std::string trace = Tracer::Instance().Write();
+
+    // THEN: the trace should hold a full buffer of events
+    EXPECT_EQ(Count(trace, "TraceTest::Instant"), TRACE_EVENTS_PER_THREAD);
+}
@@ -0,0 +1,78 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "utils.h"
+
+using orb::Utils;
+
+class UtilsTest : public ::testing::Test {
+protected:
+    const std::string appUri = "https://app.example.com/apps/entry.html?x=1";
+    const std::vector<std::string> boundaries = {
+        "https://cdn.example.com/",
+        "http://legacy.example.com:8080/path/",
+        "not a url",
+    };
+};
+
+TEST_F(UtilsTest, TestOriginSet_AppUriOrigin) {
+    // GIVEN: an origin set for an app with boundaries
+    Utils::OriginSet origins(appUri, boundaries);
+
+    // WHEN/THEN: URLs with the origin of the app URI are contained, whatever their path
+    EXPECT_TRUE(origins.Contains("https://app.example.com/other/page.html"));
+    EXPECT_TRUE(origins.Contains("https://app.example.com"));
+    EXPECT_TRUE(origins.Contains("https://app.example.com:443/"));
+}
+
+TEST_F(UtilsTest, TestOriginSet_BoundaryOrigins) {
+    // GIVEN: an origin set for an app with boundaries
+    Utils::OriginSet origins(appUri, boundaries);
+
+    // WHEN/THEN: URLs with the origin of a boundary are contained
+    EXPECT_TRUE(origins.Contains("https://cdn.example.com/lib.js"));
+    EXPECT_TRUE(origins.Contains("http://legacy.example.com:8080/"));
+}
+
+TEST_F(UtilsTest, TestOriginSet_OtherOrigins) {
+    // GIVEN: an origin set for an app with boundaries
+    Utils::OriginSet origins(appUri, boundaries);
+
+    // WHEN/THEN: URLs with a different scheme, host or port are not contained
+    EXPECT_FALSE(origins.Contains("http://app.example.com/"));
+    EXPECT_FALSE(origins.Contains("https://evil.example.com/"));
+    EXPECT_FALSE(origins.Contains("https://app.example.com:8443/"));
+    EXPECT_FALSE(origins.Contains("http://legacy.example.com/"));
+    EXPECT_FALSE(origins.Contains("about:blank"));
+    EXPECT_FALSE(origins.Contains(""));
+}
+
+TEST_F(UtilsTest, TestOriginSet_Empty) {
+    // GIVEN: an empty origin set
+    Utils::OriginSet origins;
+
+    // WHEN/THEN: nothing is contained
+    EXPECT_FALSE(origins.Contains("https://app.example.com/"));
+}
+
+TEST_F(UtilsTest, TestCheckBoundaries_ExpectedResults) {
+    // GIVEN: URLs and whether each is within the app URI or its boundaries
+    const std::vector<std::pair<std::string, bool>> urls = {
+        {"https://app.example.com/a", true},
+        {"https://app.example.com:443/other.html", true},
+        {"https://cdn.example.com", true},
+        {"http://legacy.example.com:8080/other/", true},
+        {"http://cdn.example.com/", false},
+        {"https://cdn.example.com:444/", false},
+        {"http://legacy.example.com/path/", false},
+        {"dvb://current.ait/1.1", false},
+        {"", false},
+    };
+
+    // WHEN/THEN: CheckBoundaries gives the expected result for each
+    for (const auto &url : urls) {
+        EXPECT_EQ(Utils::CheckBoundaries(url.first, appUri, boundaries), url.second) << url.first;
+    }
+}
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
  * Unit tests for XmlParser::ParseAit - OpApp extensions support
+ *
+ * Every document parsed by these tests is also parsed by XmlStreamParser, which must produce an
+ * identical table.
  */
 
 #include <string>
@@ -37,6 +40,7 @@ class XmlParserTest : public ::testing::Test {
 protected:
     void SetUp() override {
         m_xmlParser = std::make_unique<XmlParser>();
+        m_xmlStreamParser = std::make_unique<XmlStreamParser>();
 
         // Base AIT XML template with placeholders for customization
         // Includes OtherApp type element by default (common to HbbTV apps and OpApps)
@@ -77,10 +81,77 @@ protected:
 
     void TearDown() override {
         m_xmlParser.reset();
+        m_xmlStreamParser.reset();
     }
 
     std::unique_ptr<Ait::S_AIT_TABLE> parseAitXml(const std::string& xmlContent) {
-        return m_xmlParser->ParseAit(xmlContent.c_str(), xmlContent.length());
+        auto aitTable = m_xmlParser->ParseAit(xmlContent.c_str(), xmlContent.length());
+        auto streamAitTable = m_xmlStreamParser->ParseAit(xmlContent.c_str(), xmlContent.length());
+        expectSameAit(aitTable.get(), streamAitTable.get());
+        return aitTable;
+    }
+
+    /**
+     * Check that two parsed tables are identical, field by field.
+     */
+    static void expectSameAit(const Ait::S_AIT_TABLE* expected, const Ait::S_AIT_TABLE* actual) {
+        ASSERT_EQ(expected == nullptr, actual == nullptr);
+        if (expected == nullptr) {
+            return;
+        }
+        EXPECT_EQ(expected->appType, actual->appType);
+        ASSERT_EQ(expected->numApps, actual->numApps);
+        ASSERT_EQ(expected->appArray.size(), actual->appArray.size());
+        for (size_t i = 0; i < expected->appArray.size(); i++) {
+            SCOPED_TRACE("application " + std::to_string(i));
+            const Ait::S_AIT_APP_DESC& e = expected->appArray[i];
+            const Ait::S_AIT_APP_DESC& a = actual->appArray[i];
+            EXPECT_EQ(e.orgId, a.orgId);
+            EXPECT_EQ(e.appId, a.appId);
+            EXPECT_EQ(e.controlCode, a.controlCode);
+            EXPECT_EQ(e.numTransports, a.numTransports);
+            for (int t = 0; t < Ait::MAX_NUM_PROTOCOLS; t++) {
+                const Ait::S_TRANSPORT_PROTOCOL_DESC& et = e.transportArray[t];
+                const Ait::S_TRANSPORT_PROTOCOL_DESC& at = a.transportArray[t];
+                EXPECT_EQ(et.protocolId, at.protocolId);
+                EXPECT_EQ(et.oc.dvb.originalNetworkId, at.oc.dvb.originalNetworkId);
+                EXPECT_EQ(et.oc.dvb.transportStreamId, at.oc.dvb.transportStreamId);
+                EXPECT_EQ(et.oc.dvb.serviceId, at.oc.dvb.serviceId);
+                EXPECT_EQ(et.oc.componentTag, at.oc.componentTag);
+                EXPECT_EQ(et.oc.remoteConnection, at.oc.remoteConnection);
+                EXPECT_EQ(et.url.baseUrl, at.url.baseUrl);
+                EXPECT_EQ(et.url.extensionUrls, at.url.extensionUrls);
+                EXPECT_EQ(et.failedToLoad, at.failedToLoad);
+            }
+            EXPECT_EQ(e.location, a.location);
+            EXPECT_EQ(e.appName.numLangs, a.appName.numLangs);
+            ASSERT_EQ(e.appName.names.size(), a.appName.names.size());
+            for (size_t n = 0; n < e.appName.names.size(); n++) {
+                EXPECT_EQ(e.appName.names[n].langCode, a.appName.names[n].langCode);
+                EXPECT_EQ(e.appName.names[n].name, a.appName.names[n].name);
+            }
+            EXPECT_EQ(e.appDesc.visibility, a.appDesc.visibility);
+            EXPECT_EQ(e.appDesc.priority, a.appDesc.priority);
+            EXPECT_EQ(e.appDesc.serviceBound, a.appDesc.serviceBound);
+            ASSERT_EQ(e.appDesc.appProfiles.size(), a.appDesc.appProfiles.size());
+            for (size_t p = 0; p < e.appDesc.appProfiles.size(); p++) {
+                EXPECT_EQ(e.appDesc.appProfiles[p].appProfile, a.appDesc.appProfiles[p].appProfile);
+                EXPECT_EQ(e.appDesc.appProfiles[p].versionMajor, a.appDesc.appProfiles[p].versionMajor);
+                EXPECT_EQ(e.appDesc.appProfiles[p].versionMinor, a.appDesc.appProfiles[p].versionMinor);
+                EXPECT_EQ(e.appDesc.appProfiles[p].versionMicro, a.appDesc.appProfiles[p].versionMicro);
+            }
+            EXPECT_EQ(e.xmlType, a.xmlType);
+            EXPECT_EQ(e.xmlVersion, a.xmlVersion);
+            EXPECT_EQ(e.boundaries, a.boundaries);
+            ASSERT_EQ(e.parentalRatings.size(), a.parentalRatings.size());
+            for (size_t r = 0; r < e.parentalRatings.size(); r++) {
+                EXPECT_EQ(e.parentalRatings[r].scheme, a.parentalRatings[r].scheme);
+                EXPECT_EQ(e.parentalRatings[r].region, a.parentalRatings[r].region);
+                EXPECT_EQ(e.parentalRatings[r].value, a.parentalRatings[r].value);
+            }
+            EXPECT_EQ(e.graphicsConstraints, a.graphicsConstraints);
+            EXPECT_EQ(e.appUsage, a.appUsage);
+        }
     }
 
     /**
@@ -186,6 +257,7 @@ private:
 
 protected:
     std::unique_ptr<XmlParser> m_xmlParser;
+    std::unique_ptr<XmlStreamParser> m_xmlStreamParser;
     std::string m_baseAitXml;
     std::string m_defaultTransport;
 };
@@ -698,3 +770,178 @@ TEST_F(XmlParserTest, ParseAit_EmptyApplicationList_ReturnsZeroApps)
     ASSERT_NE(aitTable, nullptr);
     EXPECT_EQ(aitTable->numApps, 0);
 }
+
+// =============================================================================
+// XmlStreamParser Tests
+// =============================================================================
+
+TEST_F(XmlParserTest, ParseAit_Stream_AllElements)
+{
+    // GIVEN: An AIT XML using every element the parsers recognise
+    std::string aitXml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<mhp:ServiceDiscovery xmlns:mhp="urn:dvb:mhp:2009">
+  <!-- comment -->
+  <mhp:ApplicationDiscovery DomainName="test.example.com">
+    <mhp:ApplicationList>
+      <mhp:Application>
+        <mhp:appName Language="eng">English &amp; more</mhp:appName>
+        <mhp:appName Language="deu"><![CDATA[Deutsch]]></mhp:appName>
+        <mhp:appName Language="fra"/>
+        <mhp:applicationIdentifier>
+          <mhp:orgId>7</mhp:orgId>
+          <mhp:appId>42</mhp:appId>
+        </mhp:applicationIdentifier>
+        <mhp:applicationDescriptor>
+          <mhp:type>
+            <mhp:DvbApp>DVB-HTML</mhp:DvbApp>
+          </mhp:type>
+          <mhp:controlCode>PRESENT</mhp:controlCode>
+          <mhp:visibility>NOT_VISIBLE_USERS</mhp:visibility>
+          <mhp:priority>fe</mhp:priority>
+          <mhp:mhpVersion>
+            <mhp:profile>1a2b</mhp:profile>
+            <mhp:versionMajor>1</mhp:versionMajor>
+            <mhp:versionMinor>7</mhp:versionMinor>
+            <mhp:versionMicro>2</mhp:versionMicro>
+          </mhp:mhpVersion>
+          <mhp:icon>icon.png</mhp:icon>
+          <mhp:ParentalRating Scheme="dvb-si" Region="GBR">12</mhp:ParentalRating>
+          <mhp:ParentalRating Scheme="urn:other">4</mhp:ParentalRating>
+          <mhp:GraphicsConstraints>
+            <mhp:GraphicsConfiguration>urn:hbbtv:graphics:resolution:1920x1080</mhp:GraphicsConfiguration>
+            <mhp:GraphicsConfiguration>urn:hbbtv:graphics:resolution:unknown</mhp:GraphicsConfiguration>
+            <mhp:GraphicsConfiguration>urn:hbbtv:graphics:resolution:3840x2160</mhp:GraphicsConfiguration>
+          </mhp:GraphicsConstraints>
+        </mhp:applicationDescriptor>
+        <mhp:applicationBoundary>
+          <mhp:BoundaryExtension>https://a.example.com/</mhp:BoundaryExtension>
+          <mhp:BoundaryExtension>https://b.example.com/</mhp:BoundaryExtension>
+        </mhp:applicationBoundary>
+        <mhp:applicationTransport xsi:type="mhp:OCTransportType" xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance">
+          <mhp:DvbTriplet OrigNetId="9018" TSId="4100" ServiceId="4164"/>
+          <mhp:TextualId>ignored</mhp:TextualId>
+          <mhp:ComponentTag ComponentTag="b4"/>
+        </mhp:applicationTransport>
+        <mhp:applicationTransport xsi:type="mhp:OCTransportType" xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance">
+          <mhp:ComponentTag ComponentTag="01"/>
+        </mhp:applicationTransport>
+        <mhp:applicationLocation>index.html?x=1</mhp:applicationLocation>
+      </mhp:Application>
+      <mhp:Application/>
+      <mhp:Application>
+        <mhp:appName>Unnamed language</mhp:appName>
+        <mhp:appName>Second</mhp:appName>
+        <mhp:GraphicsConstraints/>
+        <mhp:applicationDescriptor/>
+      </mhp:Application>
+    </mhp:ApplicationList>
+  </mhp:ApplicationDiscovery>
+</mhp:ServiceDiscovery>)";
+
+    // WHEN: Parsing the AIT XML (both parsers, compared by parseAitXml)
+    auto aitTable = parseAitXml(aitXml);
+
+    // THEN: The values are parsed
+    ASSERT_NE(aitTable, nullptr);
+    ASSERT_EQ(aitTable->numApps, 3);
+    const Ait::S_AIT_APP_DESC& app = aitTable->appArray[0];
+    ASSERT_EQ(app.appName.numLangs, 2);
+    EXPECT_EQ(app.appName.names[0].name, "English & more");
+    EXPECT_EQ(app.appName.names[1].name, "Deutsch");
+    EXPECT_EQ(app.appId, 42);
+    EXPECT_EQ(app.xmlType, Ait::XML_TYP_DVB_HTML);
+    EXPECT_EQ(app.appDesc.priority, 0xFE);
+    ASSERT_EQ(app.appDesc.appProfiles.size(), size_t(1));
+    EXPECT_EQ(app.appDesc.appProfiles[0].appProfile, 0x1A2B);
+    ASSERT_EQ(app.parentalRatings.size(), size_t(2));
+    EXPECT_EQ(app.parentalRatings[0].region, "GBR");
+    EXPECT_EQ(app.graphicsConstraints, (std::vector<uint16_t>{720, 1080, 2160}));
+    EXPECT_EQ(app.boundaries.size(), size_t(2));
+    EXPECT_EQ(app.numTransports, 2);
+    EXPECT_EQ(app.transportArray[0].oc.componentTag, 0xB4);
+    EXPECT_EQ(app.transportArray[0].oc.dvb.serviceId, 4164);
+    EXPECT_EQ(app.location, "index.html?x=1");
+    EXPECT_EQ(aitTable->appArray[2].appName.numLangs, 2);
+}
+
+TEST_F(XmlParserTest, ParseAit_Stream_TrailingGarbage)
+{
+    // GIVEN: An AIT XML that becomes malformed after the application list
+    std::string aitXml = buildAitXml() + "<trailing>";
+
+    // WHEN: Parsing the AIT XML
+    auto aitTable = parseAitXml(aitXml);
+
+#ifdef RDK
+    // THEN: Both parsers recover the applications read before the error
+    ASSERT_NE(aitTable, nullptr);
+    EXPECT_EQ(aitTable->numApps, 1);
+#else
+    // THEN: Both parsers reject the document
+    EXPECT_EQ(aitTable, nullptr);
+#endif
+}
+
+TEST_F(XmlParserTest, ParseAit_Stream_MixedContent)
+{
+    // GIVEN: An AIT XML where some content is split by, or starts with, a child element
+    std::string aitXml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<mhp:ServiceDiscovery xmlns:mhp="urn:dvb:mhp:2009">
+  <mhp:ApplicationDiscovery DomainName="test.example.com">
+    <mhp:ApplicationList>
+      <mhp:Application>
+        <mhp:appName Language="eng">Before<mhp:b>Inside</mhp:b>After</mhp:appName>
+        <mhp:appName Language="deu"><mhp:b>Only child</mhp:b></mhp:appName>
+        <mhp:applicationIdentifier>
+          <mhp:orgId>12<mhp:x>34</mhp:x></mhp:orgId>
+          <mhp:appId><mhp:x>5</mhp:x></mhp:appId>
+        </mhp:applicationIdentifier>
+        <mhp:applicationLocation>index.html<mhp:x>other.html</mhp:x></mhp:applicationLocation>
+      </mhp:Application>
+    </mhp:ApplicationList>
+  </mhp:ApplicationDiscovery>
+</mhp:ServiceDiscovery>)";
+
+    // WHEN: Parsing the AIT XML
+    auto aitTable = parseAitXml(aitXml);
+
+    // THEN: Only the first child of each element is taken as its content
+    ASSERT_NE(aitTable, nullptr);
+    ASSERT_EQ(aitTable->numApps, 1);
+    const auto& app = aitTable->appArray[0];
+    ASSERT_EQ(app.appName.numLangs, 1);
+    EXPECT_EQ(app.appName.names[0].name, "Before");
+    EXPECT_EQ(app.orgId, 12u);
+    EXPECT_EQ(app.appId, 0);
+    EXPECT_EQ(app.location, "index.html");
+}
+
+TEST_F(XmlParserTest, ParseAit_Stream_LargeDocument)
+{
+    // GIVEN: An AIT XML with many applications and long content
+    std::string apps;
+    for (int i = 0; i < 40; i++) {
+        apps += R"(<mhp:Application>
+        <mhp:appName Language="eng">)" + std::string(300, 'a' + (i % 26)) + R"(</mhp:appName>
+        <mhp:applicationIdentifier><mhp:orgId>1</mhp:orgId><mhp:appId>)" + std::to_string(i) +
+            R"(</mhp:appId></mhp:applicationIdentifier>
+        )" + buildHttpTransport("https://example.com/" + std::to_string(i) + "/",
+            {"ext/a/", "ext/b/"}) + R"(
+      </mhp:Application>)";
+    }
+    std::string aitXml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<mhp:ServiceDiscovery xmlns:mhp="urn:dvb:mhp:2009">
+  <mhp:ApplicationDiscovery DomainName="test.example.com">
+    <mhp:ApplicationList>)" + apps + R"(</mhp:ApplicationList>
+  </mhp:ApplicationDiscovery>
+</mhp:ServiceDiscovery>)";
+
+    // WHEN: Parsing the AIT XML
+    auto aitTable = parseAitXml(aitXml);
+
+    // THEN: Every application is parsed
+    ASSERT_NE(aitTable, nullptr);
+    ASSERT_EQ(aitTable->numApps, 40);
+    EXPECT_EQ(aitTable->appArray[39].appName.names[0].name, std::string(300, 'a' + 13));
+    EXPECT_EQ(aitTable->appArray[39].transportArray[0].url.extensionUrls.size(), size_t(2));
+}
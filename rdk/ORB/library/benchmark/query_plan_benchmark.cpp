@@ -0,0 +1,302 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for matching metadata search queries against a synthetic EPG
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "ProgrammeIndex.h"
+#include "QueryPlan.h"
+
+namespace
+{
+
+const int NUM_CHANNELS = 50;
+const int PROGRAMMES_PER_CHANNEL = 2000; // 100k programmes in total
+const long EPG_START = 1735689600;
+
+const char *const TITLES[] = {
+    "News at Six", "Weather", "Gardeners' World", "The Great Bake Off", "Panorama",
+    "Match of the Day", "Antiques Roadshow", "Doctor Who", "Newsnight", "Question Time",
+};
+
+struct Epg
+{
+    std::vector<std::string> ccids;
+    std::vector<std::vector<orb::Programme> > programmes;
+};
+
+/**
+ * Build an EPG of consecutive half hour programmes on every channel.
+ */
+const Epg& GetEpg()
+{
+    static Epg epg;
+    if (epg.ccids.empty())
+    {
+        for (int c = 0; c < NUM_CHANNELS; c++)
+        {
+            std::string ccid = "ccid:dvbt." + std::to_string(c);
+            std::vector<orb::Programme> programmes;
+            for (int p = 0; p < PROGRAMMES_PER_CHANNEL; p++)
+            {
+                std::string title = TITLES[(c + p) % 10];
+                programmes.push_back(orb::Programme(
+                    "crid://example.com/" + std::to_string(c) + "/" + std::to_string(p),
+                    title + " " + std::to_string(p % 7),
+                    "Description", "Long description", ccid,
+                    EPG_START + p * 1800, 1800, orb::Programme::ID_TVA_CRID, {}));
+            }
+            epg.ccids.push_back(ccid);
+            epg.programmes.push_back(programmes);
+        }
+    }
+    return epg;
+}
+
+/**
+ * Programmes in a two hour window whose name contains "news", but not on channel 3.
+ */
+std::shared_ptr<orb::Query> BuildQuery()
+{
+    long windowStart = EPG_START + 1000 * 1800;
+    json query = {
+        {"operation", "AND"},
+        {"arguments", {
+             {
+                 {"operation", "AND"},
+                 {"arguments", {
+                      {{"field", "Programme.startTime"}, {"comparison", 3},
+                       {"value", std::to_string(windowStart)}},
+                      {{"field", "Programme.endTime"}, {"comparison", 5},
+                       {"value", std::to_string(windowStart + 7200)}},
+                  }},
+             },
+             {
+                 {"operation", "AND"},
+                 {"arguments", {
+                      {{"field", "Programme.name"}, {"comparison", 6}, {"value", "NEWS"}},
+                      {
+                          {"operation", "NOT"},
+                          {"arguments", {
+                               {{"field", "Programme.channelID"}, {"comparison", 0},
+                                {"value", "ccid:dvbt.3"}},
+                           }},
+                      },
+                  }},
+             },
+         }},
+    };
+    return std::make_shared<orb::Query>(query);
+}
+
+// The interpreter MetadataSearchTask used before queries were compiled
+std::string ToLowerCase(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(),
+        [](unsigned char c){
+            return std::tolower(c);
+        });
+    return s;
+}
+
+bool CompareStringValues(orb::Query::Comparison comparison, std::string programmeValue,
+    std::string queryValue)
+{
+    programmeValue = ToLowerCase(programmeValue);
+    queryValue = ToLowerCase(queryValue);
+    switch (comparison)
+    {
+        case orb::Query::Comparison::CMP_EQUAL:
+            return programmeValue == queryValue;
+        case orb::Query::Comparison::CMP_NOT_EQL:
+            return programmeValue != queryValue;
+        case orb::Query::Comparison::CMP_MORE:
+            return programmeValue.compare(queryValue) > 0;
+        case orb::Query::Comparison::CMP_MORE_EQL:
+            return programmeValue.compare(queryValue) >= 0;
+        case orb::Query::Comparison::CMP_LESS:
+            return programmeValue.compare(queryValue) < 0;
+        case orb::Query::Comparison::CMP_LESS_EQL:
+            return programmeValue.compare(queryValue) <= 0;
+        case orb::Query::Comparison::CMP_CONTAINS:
+            return programmeValue.find(queryValue) != std::string::npos;
+        default:
+            return false;
+    }
+}
+
+bool CompareLongValues(orb::Query::Comparison comparison, long programmeValue, long queryValue)
+{
+    switch (comparison)
+    {
+        case orb::Query::Comparison::CMP_EQUAL:
+        case orb::Query::Comparison::CMP_CONTAINS:
+            return programmeValue == queryValue;
+        case orb::Query::Comparison::CMP_NOT_EQL:
+            return programmeValue != queryValue;
+        case orb::Query::Comparison::CMP_MORE:
+            return programmeValue > queryValue;
+        case orb::Query::Comparison::CMP_MORE_EQL:
+            return programmeValue >= queryValue;
+        case orb::Query::Comparison::CMP_LESS:
+            return programmeValue < queryValue;
+        case orb::Query::Comparison::CMP_LESS_EQL:
+            return programmeValue <= queryValue;
+        default:
+            return false;
+    }
+}
+
+bool Match(std::shared_ptr<orb::Query> query, orb::Programme programme, std::string ccid)
+{
+    switch (query->GetOperation())
+    {
+        case orb::Query::Operation::OP_ID:
+        {
+            std::string field = query->GetField();
+            if (field == "Programme.channelID")
+            {
+                return CompareStringValues(query->GetComparison(), ccid, query->GetValue());
+            }
+            else if (field == "Programme.startTime")
+            {
+                return CompareLongValues(query->GetComparison(), programme.GetStartTime(),
+                    std::stol(query->GetValue()));
+            }
+            else if (field == "Programme.endTime")
+            {
+                return CompareLongValues(query->GetComparison(),
+                    programme.GetStartTime() + programme.GetDuration(),
+                    std::stol(query->GetValue()));
+            }
+            else if (field == "Programme.name")
+            {
+                return CompareStringValues(query->GetComparison(), programme.GetName(),
+                    query->GetValue());
+            }
+            else if (field == "Programme.programmeID")
+            {
+                return CompareStringValues(query->GetComparison(), programme.GetProgrammeId(),
+                    query->GetValue());
+            }
+            return false;
+        }
+        case orb::Query::Operation::OP_AND:
+            return Match(query->GetOperator1(), programme, ccid) &&
+                   Match(query->GetOperator2(), programme, ccid);
+        case orb::Query::Operation::OP_OR:
+            return Match(query->GetOperator1(), programme, ccid) ||
+                   Match(query->GetOperator2(), programme, ccid);
+        case orb::Query::Operation::OP_NOT:
+            return !Match(query->GetOperator1(), programme, ccid);
+        default:
+            return false;
+    }
+}
+
+/**
+ * Every programme matched by recursing through the Query tree.
+ */
+void BM_MatchInterpreter(benchmark::State& state)
+{
+    const Epg &epg = GetEpg();
+    std::shared_ptr<orb::Query> query = BuildQuery();
+
+    for (auto _ : state) {
+        int matches = 0;
+        for (size_t c = 0; c < epg.ccids.size(); c++)
+        {
+            for (auto programme : epg.programmes[c])
+            {
+                matches += Match(query, programme, epg.ccids[c]);
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_CHANNELS * PROGRAMMES_PER_CHANNEL);
+}
+BENCHMARK(BM_MatchInterpreter)->Unit(benchmark::kMillisecond);
+
+/**
+ * Every programme matched by the compiled query, against columns built beforehand.
+ */
+void BM_MatchQueryPlan(benchmark::State& state)
+{
+    const Epg &epg = GetEpg();
+    std::shared_ptr<orb::Query> query = BuildQuery();
+    std::vector<orb::ProgrammeColumns> columns;
+    for (size_t c = 0; c < epg.ccids.size(); c++)
+    {
+        columns.emplace_back(epg.ccids[c], epg.programmes[c]);
+    }
+
+    for (auto _ : state) {
+        const orb::QueryPlan plan(*query);
+        int matches = 0;
+        for (const orb::ProgrammeColumns &channel : columns)
+        {
+            for (size_t i = 0; i < channel.Size(); i++)
+            {
+                matches += plan.Matches(channel, i);
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_CHANNELS * PROGRAMMES_PER_CHANNEL);
+}
+BENCHMARK(BM_MatchQueryPlan)->Unit(benchmark::kMillisecond);
+
+/**
+ * As MetadataSearchTask searches, candidates from the indexes checked with the compiled query.
+ */
+void BM_MatchIndexed(benchmark::State& state)
+{
+    const Epg &epg = GetEpg();
+    std::shared_ptr<orb::Query> query = BuildQuery();
+    std::vector<std::unique_ptr<orb::ChannelProgrammes> > channels;
+    for (size_t c = 0; c < epg.ccids.size(); c++)
+    {
+        channels.emplace_back(new orb::ChannelProgrammes(epg.ccids[c], epg.programmes[c]));
+    }
+
+    for (auto _ : state) {
+        const orb::QueryPlan plan(*query);
+        int matches = 0;
+        for (const auto &channel : channels)
+        {
+            orb::ChannelProgrammes::Candidates candidates = channel->Find(*query);
+            for (size_t i = 0; i < candidates.positions.Size(); i++)
+            {
+                if (candidates.positions.Test(i) &&
+                    (candidates.exact || plan.Matches(channel->GetColumns(), i)))
+                {
+                    matches++;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_CHANNELS * PROGRAMMES_PER_CHANNEL);
+}
+BENCHMARK(BM_MatchIndexed)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,191 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Throughput of the SHA256 and Base64 kernels. Each kernel is checked against known vectors
+ * before it is timed.
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "Base64.h"
+#include "CpuFeatures.h"
+#include "SHA256.h"
+
+namespace
+{
+
+struct Kernel
+{
+    const char *name;
+    unsigned int features; // Features the kernel may use
+    orb::CpuFeatures::Feature required; // Feature without which it is not available
+};
+
+const Kernel SHA256_KERNELS[] = {
+    {"scalar", 0, orb::CpuFeatures::FEATURE_ALL},
+    {"sha-ni", orb::CpuFeatures::FEATURE_SHA_NI, orb::CpuFeatures::FEATURE_SHA_NI},
+    {"armv8", orb::CpuFeatures::FEATURE_ARM_SHA2, orb::CpuFeatures::FEATURE_ARM_SHA2},
+};
+
+const Kernel BASE64_KERNELS[] = {
+    {"scalar", 0, orb::CpuFeatures::FEATURE_ALL},
+    {"ssse3", orb::CpuFeatures::FEATURE_SSSE3, orb::CpuFeatures::FEATURE_SSSE3},
+    {"avx2", orb::CpuFeatures::FEATURE_SSSE3 | orb::CpuFeatures::FEATURE_AVX2,
+     orb::CpuFeatures::FEATURE_AVX2},
+    {"neon", orb::CpuFeatures::FEATURE_NEON, orb::CpuFeatures::FEATURE_NEON},
+};
+
+const int SIZES[] = {32, 256, 4096, 65536};
+
+/**
+ * Restrict the features to those of the kernel, or return false if the CPU lacks them.
+ */
+bool UseKernel(benchmark::State& state, const Kernel &kernel)
+{
+    orb::CpuFeatures::Restrict(kernel.features);
+    if (kernel.features != 0 && !orb::CpuFeatures::Has(kernel.required))
+    {
+        orb::CpuFeatures::Restrict(orb::CpuFeatures::FEATURE_ALL);
+        state.SkipWithError("Not supported by this CPU");
+        return false;
+    }
+    state.SetLabel(kernel.name);
+    return true;
+}
+
+std::string MakeData(size_t size)
+{
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<char>(i * 131 + 7);
+    }
+    return data;
+}
+
+void BM_SHA256(benchmark::State& state)
+{
+    if (!UseKernel(state, SHA256_KERNELS[state.range(0)]))
+    {
+        return;
+    }
+    // FIPS 180-2 and RFC 4231 test case 2
+    if (orb::SHA256::Encrypt("abc") !=
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" ||
+        orb::SHA256::Encrypt(std::string(1000000, 'a')) !=
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" ||
+        orb::Base64::Encode(orb::SHA256::Hmac("Jefe", "what do ya want for nothing?")) !=
+        "W9zBRr9gdU5qBCQmCJV1x1oAPwidJzmDnexYuWTsOEM=")
+    {
+        state.SkipWithError("Known vector mismatch");
+        return;
+    }
+    const std::string data = MakeData(state.range(1));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(orb::SHA256::Encrypt(data));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    orb::CpuFeatures::Restrict(orb::CpuFeatures::FEATURE_ALL);
+}
+BENCHMARK(BM_SHA256)->Apply([](benchmark::internal::Benchmark *b) {
+    for (size_t k = 0; k < sizeof(SHA256_KERNELS) / sizeof(SHA256_KERNELS[0]); k++)
+    {
+        for (int size : SIZES)
+        {
+            b->Args({static_cast<int64_t>(k), size});
+        }
+    }
+});
+
+/**
+ * Known vectors from RFC 4648, and a round trip of every byte value.
+ */
+bool CheckBase64()
+{
+    const char *const vectors[][2] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+    std::string decoded;
+    for (const auto &vector : vectors)
+    {
+        if (orb::Base64::Encode(vector[0]) != vector[1] ||
+            !orb::Base64::Decode(vector[1], decoded).empty() || decoded != vector[0])
+        {
+            return false;
+        }
+    }
+    const std::string data = MakeData(1000);
+    return orb::Base64::Decode(orb::Base64::Encode(data), decoded).empty() && decoded == data;
+}
+
+void BM_Base64Encode(benchmark::State& state)
+{
+    if (!UseKernel(state, BASE64_KERNELS[state.range(0)]))
+    {
+        return;
+    }
+    if (!CheckBase64())
+    {
+        state.SkipWithError("Known vector mismatch");
+        return;
+    }
+    const std::string data = MakeData(state.range(1));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(orb::Base64::Encode(data));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    orb::CpuFeatures::Restrict(orb::CpuFeatures::FEATURE_ALL);
+}
+
+void BM_Base64Decode(benchmark::State& state)
+{
+    if (!UseKernel(state, BASE64_KERNELS[state.range(0)]))
+    {
+        return;
+    }
+    if (!CheckBase64())
+    {
+        state.SkipWithError("Known vector mismatch");
+        return;
+    }
+    const std::string encoded = orb::Base64::Encode(MakeData(state.range(1)));
+    std::string decoded;
+
+    for (auto _ : state) {
+        orb::Base64::Decode(encoded, decoded);
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetBytesProcessed(state.iterations() * encoded.size());
+    orb::CpuFeatures::Restrict(orb::CpuFeatures::FEATURE_ALL);
+}
+
+void Base64Args(benchmark::internal::Benchmark *b)
+{
+    for (size_t k = 0; k < sizeof(BASE64_KERNELS) / sizeof(BASE64_KERNELS[0]); k++)
+    {
+        for (int size : SIZES)
+        {
+            b->Args({static_cast<int64_t>(k), size});
+        }
+    }
+}
+BENCHMARK(BM_Base64Encode)->Apply(Base64Args);
+BENCHMARK(BM_Base64Decode)->Apply(Base64Args);
+
+} // namespace
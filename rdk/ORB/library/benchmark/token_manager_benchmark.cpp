@@ -0,0 +1,96 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Benchmarks for checking the signature of the token sent with every bridge request
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "Base64.h"
+#include "SHA256.h"
+#include "TokenManager.h"
+
+namespace
+{
+
+const char *const APP_URI = "http://www.example.com/hbbtv/apps/news/index.html?channel=1";
+
+// The signature TokenManager used before tokens were signed with HMAC-SHA256
+json GetPayloadLegacy(const std::string &key, json token)
+{
+    json payload = token["payload"];
+    std::string claimedSignature = token["signature"];
+    std::string signature = orb::Base64::Encode(orb::SHA256::Encrypt(payload.dump() + key));
+    if (signature == claimedSignature)
+    {
+        return payload;
+    }
+    return "{}"_json;
+}
+
+/**
+ * Every request re-serialises the payload and hashes it with the key appended.
+ */
+void BM_VerifyTokenLegacy(benchmark::State& state)
+{
+    const std::string key = "0f8fad5b-d9cb-469f-a165-70867728950e";
+    json token;
+    token["payload"] = {{"appId", 1}, {"uri", APP_URI}, {"origin", "http://www.example.com"}};
+    token["signature"] = orb::Base64::Encode(orb::SHA256::Encrypt(token["payload"].dump() + key));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GetPayloadLegacy(key, token));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifyTokenLegacy);
+
+/**
+ * A fresh token from each of a number of applications, so every request misses the cache.
+ */
+void BM_VerifyTokenUncached(benchmark::State& state)
+{
+    orb::TokenManager tokenManager;
+    std::vector<json> tokens;
+    for (int appId = 0; appId < 4096; appId++)
+    {
+        tokens.push_back(tokenManager.CreateToken(appId, APP_URI));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenManager.GetTokenPayload(tokens[i++ % tokens.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifyTokenUncached);
+
+/**
+ * The same token on every request, as sent by a running application.
+ */
+void BM_VerifyTokenCached(benchmark::State& state)
+{
+    orb::TokenManager tokenManager;
+    json token = tokenManager.CreateToken(1, APP_URI);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenManager.GetTokenPayload(token));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifyTokenCached);
+
+} // namespace
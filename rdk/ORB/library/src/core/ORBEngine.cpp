@@ -59,6 +59,28 @@ static std::string DecodeUrl(std::string url)
     return url;
 }
 
+/**
+ * @brief StripDvbUrlQuery
+ *
+ * Helper function that removes the query string from a dvb:// url.
+ *
+ * @param url       The input url
+ * @return          The resulting url
+ */
+static std::string StripDvbUrlQuery(std::string url)
+{
+    if (url.rfind("dvb://", 0) == 0)
+    {
+        std::shared_ptr<URI> uri = URI::Parse(url);
+        std::string port = uri->GetPort();
+        url = uri->GetProtocol() + "://" + uri->GetHost() + ((port == "-1" || port.empty()) ? "" :
+                                                             ":" +
+                                                             port) + uri->GetPath();
+        ORB_LOG("Stripped url=%s", url.c_str());
+    }
+    return url;
+}
+
 /**
  * Resolves the object and method from the specified input, which has the following form:
  *
@@ -114,6 +136,41 @@ bool IsBridgeRequestValid(json request)
     return true;
 }
 
+/**
+ * @brief DispatchJavaScriptEvents
+ *
+ * Helper function that passes a batch of JavaScript events to the event listener, as one event
+ * if possible.
+ *
+ * @param eventListener The event listener
+ * @param events        The JavaScript events
+ */
+static void DispatchJavaScriptEvents(ORBEventListener *eventListener,
+    const std::vector<JavaScriptEventQueue::Event> &events)
+{
+    if (eventListener == nullptr)
+    {
+        return;
+    }
+    if (events.size() == 1)
+    {
+        eventListener->OnJavaScriptEventDispatchRequested(events[0].name, events[0].properties,
+            events[0].targetOrigin, events[0].broadcastRelated);
+        return;
+    }
+    json array = json::array();
+    for (const JavaScriptEventQueue::Event &event : events)
+    {
+        array.push_back({
+            {"eventName", event.name},
+            {"eventProperties", event.properties},
+            {"targetOrigin", event.targetOrigin},
+            {"broadcastRelated", event.broadcastRelated}
+        });
+    }
+    eventListener->OnJavaScriptEventsDispatchRequested(array.dump());
+}
+
 /**
  * Constructor.
  *
@@ -123,8 +180,17 @@ ORBEngine::ORBEngine()
     : m_eventListener(nullptr)
     , m_orbPlatformLoader(std::make_shared<ORBPlatformLoader>())
     , m_tokenManager(std::make_shared<TokenManager>())
+    , m_programmeIndex(std::make_shared<ProgrammeIndex>())
+    , m_broadcastCache(std::make_shared<BroadcastCache>())
+    , m_dsmccFileCache(std::make_shared<DsmccFileCache>())
+    , m_javaScriptEventQueue(std::make_shared<JavaScriptEventQueue>(
+        [this](const std::vector<JavaScriptEventQueue::Event> &events) {
+            DispatchJavaScriptEvents(GetEventListener().get(), events);
+        }))
     , m_platformEventHandler(std::make_shared<ORBPlatformEventHandlerImpl>())
     , m_orbPlatform(nullptr)
+    , m_metadataSearchScheduler(std::make_shared<MetadataSearchScheduler>())
+    , m_prefetchRequestId(0)
     , m_currentAppId(UINT16_MAX)
     , m_currentAppUrl("")
     , m_started(false)
@@ -139,6 +205,16 @@ ORBEngine::ORBEngine()
 ORBEngine::~ORBEngine()
 {
     ORB_LOG_NO_ARGS();
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto &entry : m_metadataSearchTasks)
+        {
+            entry.second->Stop();
+        }
+    }
+    // Join the search workers while the task map and m_mutex still exist, as a finishing task
+    // removes itself from the map
+    m_metadataSearchScheduler.reset();
     m_metadataSearchTasks.clear();
 }
 
@@ -209,11 +285,52 @@ bool ORBEngine::Stop()
         m_orbPlatformLoader->Unload(m_orbPlatform);
     }
 
+    // Deliver the events already posted before the listener goes
+    m_javaScriptEventQueue->Flush();
     m_eventListener = nullptr;
     m_started = false;
     return true;
 }
 
+/**
+ * Get the statistics of the engine components.
+ *
+ * @return A string representation of the JSON statistics
+ */
+std::string ORBEngine::GetStatistics()
+{
+    ORB_LOG_NO_ARGS();
+    MetadataSearchScheduler::Stats search = m_metadataSearchScheduler->GetStats();
+    json statistics;
+    statistics["metadataSearch"] = {
+        {"completed", search.completed},
+        {"superseded", search.superseded},
+        {"totalWaitUs", search.totalWaitUs},
+        {"maxWaitUs", search.maxWaitUs},
+        {"totalRunUs", search.totalRunUs},
+        {"maxRunUs", search.maxRunUs}
+    };
+    DsmccFileCache::Stats dsmcc = m_dsmccFileCache->GetStats();
+    statistics["dsmccFileCache"] = {
+        {"hits", dsmcc.hits},
+        {"joined", dsmcc.joined},
+        {"misses", dsmcc.misses},
+        {"prefetches", dsmcc.prefetches},
+        {"evictions", dsmcc.evictions},
+        {"invalidations", dsmcc.invalidations},
+        {"savedLatencyUs", dsmcc.savedLatencyUs},
+        {"bytes", dsmcc.bytes},
+        {"files", dsmcc.files}
+    };
+    JavaScriptEventQueue::Stats events = m_javaScriptEventQueue->GetStats();
+    statistics["javaScriptEvents"] = {
+        {"posted", events.posted},
+        {"coalesced", events.coalesced},
+        {"batches", events.batches}
+    };
+    return statistics.dump();
+}
+
 /************************************************************************************************
 ** Public Browser-specific API
 ***********************************************************************************************/
@@ -276,6 +393,12 @@ std::string ORBEngine::ExecuteBridgeRequest(std::string jsonRequest)
     json params = request["params"];
 
     std::shared_ptr<ORBBridgeRequestHandler> requestHandler = ORBBridgeRequestHandler::Get(object);
+    std::string serializedResponse;
+    if (requestHandler != nullptr &&
+        requestHandler->HandleSerialized(jsonToken, method, params, serializedResponse))
+    {
+        return serializedResponse;
+    }
     if (requestHandler != nullptr)
     {
         requestHandler->Handle(jsonToken, method, params, response);
@@ -285,8 +408,9 @@ std::string ORBEngine::ExecuteBridgeRequest(std::string jsonRequest)
         response = ORBBridgeRequestHandler::MakeErrorResponse("UnknownMethod");
     }
 
-    ORB_LOG("response=%s", response.dump().c_str());
-    return response.dump();
+    serializedResponse = response.dump();
+    ORB_LOG("response=%s", serializedResponse.c_str());
+    return serializedResponse;
 }
 
 /**
@@ -320,20 +444,54 @@ void ORBEngine::LoadDvbUrl(std::string url, int requestId)
 {
     ORB_LOG("url=%s requestId=%d", url.c_str(), requestId);
 
-    url = DecodeUrl(url);
+    url = StripDvbUrlQuery(DecodeUrl(url));
 
-    // Strip query string from the dvb URL
-    if (url.rfind("dvb://", 0) == 0)
+    // Files are only cached for platforms that tell which version of its module a file is from
+    uint32_t carouselId = 0;
+    uint32_t moduleVersion = 0;
+    if (!GetORBPlatform()->Dsmcc_GetFileVersion(url, carouselId, moduleVersion))
     {
-        std::shared_ptr<URI> uri = URI::Parse(url);
-        std::string port = uri->GetPort();
-        url = uri->GetProtocol() + "://" + uri->GetHost() + ((port == "-1" || port.empty()) ? "" :
-                                                             ":" +
-                                                             port) + uri->GetPath();
-        ORB_LOG("Stripped url=%s", url.c_str());
+        GetORBPlatform()->Dsmcc_RequestFile(url, requestId);
+        return;
     }
 
-    GetORBPlatform()->Dsmcc_RequestFile(url, requestId);
+    DsmccFileCache::Content content;
+    switch (m_dsmccFileCache->Find(carouselId, url, moduleVersion, requestId, content))
+    {
+        case DsmccFileCache::LOOKUP_HIT:
+            GetEventListener()->OnDvbUrlLoadedShared(requestId, content);
+            break;
+        case DsmccFileCache::LOOKUP_JOINED:
+            // Completed by the load already in progress
+            break;
+        default:
+            GetORBPlatform()->Dsmcc_RequestFile(url, requestId);
+            break;
+    }
+}
+
+/**
+ * Load the specified DVB URL into the DSM-CC file cache, so that a later request for it can be
+ * answered without waiting for the carousel. The URL is normalised as in LoadDvbUrl, so the
+ * prefetched file is found under the same key.
+ *
+ * @param url The DVB URL
+ */
+void ORBEngine::PrefetchDvbUrl(std::string url)
+{
+    url = StripDvbUrlQuery(DecodeUrl(url));
+    uint32_t carouselId = 0;
+    uint32_t moduleVersion = 0;
+    if (!GetORBPlatform()->Dsmcc_GetFileVersion(url, carouselId, moduleVersion))
+    {
+        return;
+    }
+    int requestId = --m_prefetchRequestId;
+    if (m_dsmccFileCache->StartPrefetch(carouselId, url, moduleVersion, requestId))
+    {
+        ORB_LOG("url=%s requestId=%d", url.c_str(), requestId);
+        GetORBPlatform()->Dsmcc_RequestFile(url, requestId);
+    }
 }
 
 /**
@@ -20,10 +20,16 @@
 #include "ORBPlatform.h"
 #include "ORBPlatformLoader.h"
 #include "MetadataSearchTask.h"
+#include "MetadataSearchScheduler.h"
+#include "ProgrammeIndex.h"
+#include "BroadcastCache.h"
+#include "DsmccFileCache.h"
+#include "JavaScriptEventQueue.h"
 #include "ORBEventListener.h"
 #include "ORBBrowserApi.h"
 #include "ORBPlatformEventHandlerImpl.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -94,6 +100,21 @@ public:
      */
     bool Stop();
 
+    /**
+     * Get the statistics of the engine components, as a string representation of a JSON object:
+     *
+     * {
+     *    "metadataSearch": {"completed", "superseded", "totalWaitUs", "maxWaitUs",
+     *                       "totalRunUs", "maxRunUs"},
+     *    "dsmccFileCache": {"hits", "joined", "misses", "prefetches", "evictions",
+     *                       "invalidations", "savedLatencyUs", "bytes", "files"},
+     *    "javaScriptEvents": {"posted", "coalesced", "batches"}
+     * }
+     *
+     * @return A string representation of the JSON statistics
+     */
+    std::string GetStatistics();
+
 
     /************************************************************************************************
     ** Public Browser-specific API
@@ -135,6 +156,14 @@ public:
      */
     virtual void LoadDvbUrl(std::string url, int requestId) override;
 
+    /**
+     * Load the specified DVB URL into the DSM-CC file cache, so that a later request for it can
+     * be answered without waiting for the carousel.
+     *
+     * @param url The DVB URL
+     */
+    void PrefetchDvbUrl(std::string url);
+
     /**
      * Notify the application manager and the current JavaScript context that the specified HbbTV
      * application has failed to load.
@@ -203,6 +232,26 @@ public:
         return m_tokenManager;
     }
 
+    std::shared_ptr<ProgrammeIndex> GetProgrammeIndex()
+    {
+        return m_programmeIndex;
+    }
+
+    std::shared_ptr<BroadcastCache> GetBroadcastCache()
+    {
+        return m_broadcastCache;
+    }
+
+    std::shared_ptr<DsmccFileCache> GetDsmccFileCache()
+    {
+        return m_dsmccFileCache;
+    }
+
+    std::shared_ptr<JavaScriptEventQueue> GetJavaScriptEventQueue()
+    {
+        return m_javaScriptEventQueue;
+    }
+
     std::shared_ptr<ORBPlatformEventHandler> GetPlatformEventHandler()
     {
         return m_platformEventHandler;
@@ -237,16 +286,28 @@ public:
         m_metadataSearchTasks[queryId] = searchTask;
     }
 
-    void RemoveMetadataSearchTask(int queryId)
+    // If searchTask is not null, the task is only removed if it is still the one for queryId
+    void RemoveMetadataSearchTask(int queryId, const MetadataSearchTask *searchTask = nullptr)
     {
         std::lock_guard<std::mutex> lock{m_mutex};
-        m_metadataSearchTasks.erase(queryId);
+        auto it = m_metadataSearchTasks.find(queryId);
+        if (it != m_metadataSearchTasks.end() &&
+            (searchTask == nullptr || it->second.get() == searchTask))
+        {
+            m_metadataSearchTasks.erase(it);
+        }
     }
 
     std::shared_ptr<MetadataSearchTask> GetMetadataSearchTask(int queryId)
     {
         std::lock_guard<std::mutex> lock{m_mutex};
-        return m_metadataSearchTasks[queryId];
+        auto it = m_metadataSearchTasks.find(queryId);
+        return it != m_metadataSearchTasks.end() ? it->second : nullptr;
+    }
+
+    std::shared_ptr<MetadataSearchScheduler> GetMetadataSearchScheduler()
+    {
+        return m_metadataSearchScheduler;
     }
 
     void SetPreferredUILanguage(std::string preferredUiLanguage)
@@ -266,9 +327,15 @@ private:
     std::shared_ptr<ORBPlatformLoader> m_orbPlatformLoader;
     std::shared_ptr<ApplicationManager> m_applicationManager;
     std::shared_ptr<TokenManager> m_tokenManager;
+    std::shared_ptr<ProgrammeIndex> m_programmeIndex;
+    std::shared_ptr<BroadcastCache> m_broadcastCache;
+    std::shared_ptr<DsmccFileCache> m_dsmccFileCache;
+    std::shared_ptr<JavaScriptEventQueue> m_javaScriptEventQueue;
     std::shared_ptr<ORBPlatformEventHandlerImpl> m_platformEventHandler;
     ORBPlatform *m_orbPlatform;
     std::map<int, std::shared_ptr<MetadataSearchTask> > m_metadataSearchTasks;
+    std::shared_ptr<MetadataSearchScheduler> m_metadataSearchScheduler;
+    std::atomic<int> m_prefetchRequestId; // Prefetches use negative request IDs
     uint16_t m_currentAppId;
     std::string m_currentAppUrl;
     bool m_started;
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -72,5 +74,27 @@ public:
      * Trigger the ExitButtonPressed event.
      */
     virtual void OnExitButtonPressed() = 0;
+
+    /**
+     * Trigger the DvbUrlLoaded event with content that is shared, for example with the DSM-CC
+     * file cache. The default copies the content for OnDvbUrlLoaded, listeners that can read it
+     * in place should override this.
+     *
+     * @param requestId The original request identifier
+     * @param content   The retrieved content
+     */
+    virtual void OnDvbUrlLoadedShared(int requestId,
+        std::shared_ptr<const std::vector<uint8_t> > content)
+    {
+        OnDvbUrlLoaded(requestId, *content, content->size());
+    }
+
+    /**
+     * Trigger the JavaScriptEventDispatchRequested event for each of a batch of events.
+     *
+     * @param events JSON array of the events in dispatch order, each an object with the
+     *               eventName, eventProperties, targetOrigin and broadcastRelated members
+     */
+    virtual void OnJavaScriptEventsDispatchRequested(std::string events) = 0;
 }; // class ORBEventListener
 } // namespace orb
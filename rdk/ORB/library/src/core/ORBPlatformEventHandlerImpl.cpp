@@ -89,6 +89,12 @@ void ORBPlatformEventHandlerImpl::OnChannelStatusChanged(int onetId, int transId
     ORB_LOG("onetId=%d transId=%d servId=%d statusCode=%d permanentError=%s",
         onetId, transId, servId, statusCode, permanentError ? "yes" : "no");
 
+    // the cached channel list and components may be out of date
+    std::shared_ptr<BroadcastCache> broadcastCache =
+        ORBEngine::GetSharedInstance().GetBroadcastCache();
+    broadcastCache->InvalidateChannelList();
+    broadcastCache->InvalidateComponents();
+
     // notify the application manager iff channel status is 'connecting'
     if (statusCode == Channel::Status::CHANNEL_STATUS_CONNECTING)
     {
@@ -107,7 +113,7 @@ void ORBPlatformEventHandlerImpl::OnChannelStatusChanged(int onetId, int transId
         properties.emplace("permanentError", permanentError);
     }
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "ChannelStatusChanged", properties.dump(), "", true);
 }
 
@@ -124,8 +130,9 @@ void ORBPlatformEventHandlerImpl::OnParentalRatingChanged(bool blocked)
     json properties;
     properties["blocked"] = blocked;
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
-        "ParentalRatingChange", properties.dump(), "", true);
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "ParentalRatingChange", properties.dump(), "", true,
+        "ParentalRatingChange");
 }
 
 /**
@@ -153,7 +160,7 @@ void ORBPlatformEventHandlerImpl::OnParentalRatingError(std::string contentId,
     properties.emplace("ratings", json_ratings);
     properties.emplace("DRMSystemID", drmSystemId);
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "ParentalRatingError", properties.dump(), "", true);
 }
 
@@ -166,12 +173,16 @@ void ORBPlatformEventHandlerImpl::OnSelectedComponentChanged(int componentType)
 {
     ORB_LOG("componentType=%d", componentType);
 
+    // the cached components are out of date
+    ORBEngine::GetSharedInstance().GetBroadcastCache()->InvalidateComponents();
+
     // prepare event properties and request event dispatching
     json properties;
     properties["componentType"] = componentType;
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
-        "SelectedComponentChanged", properties.dump(), "", true);
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "SelectedComponentChanged", properties.dump(), "", true,
+        "SelectedComponentChanged:" + std::to_string(componentType));
 }
 
 /**
@@ -183,6 +194,9 @@ void ORBPlatformEventHandlerImpl::OnComponentChanged(int componentType)
 {
     ORB_LOG("componentType=%d", componentType);
 
+    // the cached components are out of date
+    ORBEngine::GetSharedInstance().GetBroadcastCache()->InvalidateComponents();
+
     // prepare event properties and request event dispatching
     json properties;
 
@@ -191,8 +205,10 @@ void ORBPlatformEventHandlerImpl::OnComponentChanged(int componentType)
         properties["componentType"] = componentType;
     }
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
-        "ComponentChanged", properties.dump(), "", true);
+    // repeated changes of the same component type are only dispatched once per batch
+    std::string eventProperties = properties.dump();
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "ComponentChanged", eventProperties, "", true, "ComponentChanged:" + eventProperties);
 }
 
 /**
@@ -202,11 +218,14 @@ void ORBPlatformEventHandlerImpl::OnProgrammesChanged()
 {
     ORB_LOG_NO_ARGS();
 
+    // the indexed programmes are out of date
+    ORBEngine::GetSharedInstance().GetProgrammeIndex()->Invalidate();
+
     // prepare event properties and request event dispatching
     json properties = "{}"_json;
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
-        "ProgrammesChanged", properties.dump(), "", true);
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "ProgrammesChanged", properties.dump(), "", true, "ProgrammesChanged");
 }
 
 /**
@@ -219,7 +238,7 @@ void ORBPlatformEventHandlerImpl::OnLowMemory()
     // prepare event properties and request event dispatching
     json properties = "{}"_json;
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "LowMemory", properties.dump(), "", false);
 }
 
@@ -237,7 +256,7 @@ void ORBPlatformEventHandlerImpl::OnAccessToDistinctiveIdentifierDecided(std::st
     json properties;
     properties["allowAccess"] = accessAllowed;
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "accesstodistinctiveidentifier", properties.dump(), origin, false);
 }
 
@@ -251,7 +270,7 @@ void ORBPlatformEventHandlerImpl::OnAppTransitionedToBroadcastRelated()
     // prepare event properties and request event dispatching
     json properties = "{}"_json;
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "TransitionedToBroadcastRelated", properties.dump(), "", false);
 }
 
@@ -283,7 +302,7 @@ void ORBPlatformEventHandlerImpl::OnStreamEvent(int id, std::string name, std::s
     try
     {
         eventProperties = properties.dump();
-        ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+        ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
             "StreamEvent", eventProperties, "", true);
     }
     catch (json::type_error& e)
@@ -303,8 +322,20 @@ void ORBPlatformEventHandlerImpl::OnDvbUrlLoaded(int requestId, std::vector<uint
     unsigned int fileContentLength)
 {
     ORB_LOG("requestId=%d fileContentLength=%u", requestId, fileContentLength);
-    ORBEngine::GetSharedInstance().GetEventListener()->OnDvbUrlLoaded(requestId, fileContent,
-        fileContentLength);
+    ORBEngine &engine = ORBEngine::GetSharedInstance();
+    // The content is shared by the cache, the request and the requests that waited for it
+    DsmccFileCache::Content content =
+        std::make_shared<const std::vector<uint8_t> >(std::move(fileContent));
+    std::vector<int> waiters = engine.GetDsmccFileCache()->Complete(requestId, content);
+    for (int waiter : waiters)
+    {
+        engine.GetEventListener()->OnDvbUrlLoadedShared(waiter, content);
+    }
+    // Negative request IDs are prefetches, which no subscriber is waiting for
+    if (requestId >= 0)
+    {
+        engine.GetEventListener()->OnDvbUrlLoadedShared(requestId, content);
+    }
 }
 
 /**
@@ -317,8 +348,19 @@ void ORBPlatformEventHandlerImpl::OnDvbUrlLoadedNoData(int requestId, unsigned i
     fileContentLength)
 {
     ORB_LOG("requestId=%d fileContentLength=%u", requestId, fileContentLength);
-    ORBEngine::GetSharedInstance().GetEventListener()->OnDvbUrlLoadedNoData(requestId,
-        fileContentLength);
+    ORBEngine &engine = ORBEngine::GetSharedInstance();
+    std::string url;
+    std::vector<int> waiters = engine.GetDsmccFileCache()->CompleteWithoutContent(requestId,
+        url);
+    // The content went straight to the browser, so the waiters must load the file themselves
+    for (int waiter : waiters)
+    {
+        engine.GetORBPlatform()->Dsmcc_RequestFile(url, waiter);
+    }
+    if (requestId >= 0)
+    {
+        engine.GetEventListener()->OnDvbUrlLoadedNoData(requestId, fileContentLength);
+    }
 }
 
 /**
@@ -395,7 +437,7 @@ void ORBPlatformEventHandlerImpl::OnDrmRightsError(
     properties.emplace("DRMSystemID", drmSystemId);
     properties.emplace("rightsIssuerURL", rightsIssuerUrl);
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "DRMRightsError", properties.dump(), "", false);
 }
 
@@ -435,8 +477,9 @@ void ORBPlatformEventHandlerImpl::OnDrmSystemStatusChanged(
     properties.emplace("protectionGateways", protectionGateways);
     properties.emplace("supportedFormats", supportedFormats);
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
-        "DRMSystemStatusChange", properties.dump(), "", false);
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "DRMSystemStatusChange", properties.dump(), "", false,
+        "DRMSystemStatusChange:" + drmSystem);
 }
 
 /**
@@ -461,7 +504,7 @@ void ORBPlatformEventHandlerImpl::OnSendDrmMessageResult(
     properties.emplace("resultMsg", result);
     properties.emplace("resultCode", resultCode);
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "DRMMessageResult", properties.dump(), "", false);
 }
 
@@ -480,7 +523,33 @@ void ORBPlatformEventHandlerImpl::OnDrmSystemMessage(std::string message, std::s
     properties.emplace("msg", message);
     properties.emplace("DRMSystemID", drmSystemId);
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "DRMSystemMessage", properties.dump(), "", false);
 }
+
+/**
+ * Notify that the channel list has changed, for example after a channel scan.
+ */
+void ORBPlatformEventHandlerImpl::OnChannelListChanged()
+{
+    ORB_LOG_NO_ARGS();
+
+    // the cached channel list and indexed programmes are out of date
+    ORBEngine::GetSharedInstance().GetBroadcastCache()->InvalidateChannelList();
+    ORBEngine::GetSharedInstance().GetProgrammeIndex()->Invalidate();
+}
+
+/**
+ * Notify the engine that a module of the specified DSM-CC object carousel has changed version.
+ *
+ * @param carouselId    The carousel ID
+ * @param moduleId      The module ID
+ * @param moduleVersion The new module version
+ */
+void ORBPlatformEventHandlerImpl::OnDsmccModuleVersionChanged(uint32_t carouselId, uint16_t
+    moduleId, uint8_t moduleVersion)
+{
+    ORB_LOG("carouselId=%u moduleId=%hu moduleVersion=%u", carouselId, moduleId, moduleVersion);
+    ORBEngine::GetSharedInstance().GetDsmccFileCache()->InvalidateCarousel(carouselId);
+}
 } // namespace orb
@@ -201,5 +201,20 @@ public:
      * @param drmSystemId ID of the DRM System
      */
     virtual void OnDrmSystemMessage(std::string message, std::string drmSystemId) override final;
+
+    /**
+     * Notify that the channel list has changed, for example after a channel scan.
+     */
+    virtual void OnChannelListChanged() override final;
+
+    /**
+     * Notify the engine that a module of the specified DSM-CC object carousel has changed version.
+     *
+     * @param carouselId    The carousel ID
+     * @param moduleId      The module ID
+     * @param moduleVersion The new module version
+     */
+    virtual void OnDsmccModuleVersionChanged(uint32_t carouselId, uint16_t moduleId, uint8_t
+        moduleVersion) override final;
 }; // class ORBPlatformEventHandlerImpl
 } // namespace orb
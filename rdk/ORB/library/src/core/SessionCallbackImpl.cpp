@@ -108,6 +108,12 @@ void SessionCallbackImpl::LoadApplication(uint16_t app_id, const char *url)
     ORBEngine::GetSharedInstance().SetCurrentAppId(app_id);
     ORBEngine::GetSharedInstance().SetCurrentAppUrl(url);
 
+    // Start loading a broadcast entry page before the browser asks for it
+    if (std::string(url).rfind("dvb://", 0) == 0)
+    {
+        ORBEngine::GetSharedInstance().PrefetchDvbUrl(url);
+    }
+
     std::string urlStr = EncodeUrl(url);
 
     ORBEngine::GetSharedInstance().GetORBPlatform()->Application_Load(urlStr.c_str());
@@ -226,7 +232,7 @@ void SessionCallbackImpl::DispatchApplicationLoadErrorEvent()
 {
     ORB_LOG_NO_ARGS();
     json properties;
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
         "ApplicationLoadError", properties.dump(), "", false);
 }
 
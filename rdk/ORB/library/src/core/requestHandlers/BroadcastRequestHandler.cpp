@@ -124,24 +124,10 @@ bool BroadcastRequestHandler::Handle(
             response["result"] = JsonUtil::ChannelToJsonObject(*(currentChannel.get()));
         }
     }
-    // Broadcast.getChannelList
+    // Broadcast.getChannelList, allowed requests are answered by HandleSerialized
     else if (method == BROADCAST_GET_CHANNEL_LIST)
     {
-        if (!IsRequestAllowed(token, ApplicationManager::MethodRequirement::FOR_BROADCAST_APP_ONLY))
-        {
-            response = MakeErrorResponse("SecurityError");
-        }
-        else
-        {
-            std::vector<Channel> channelList =
-                ORBEngine::GetSharedInstance().GetORBPlatform()->Broadcast_GetChannelList();
-            json array;
-            for (auto channel : channelList)
-            {
-                array.push_back(JsonUtil::ChannelToJsonObject(channel));
-            }
-            response.emplace("result", array);
-        }
+        response = MakeErrorResponse("SecurityError");
     }
     // Broadcast.setChannelToCcid
     else if (method == BROADCAST_SET_CHANNEL_TO_CCID)
@@ -304,11 +290,12 @@ bool BroadcastRequestHandler::Handle(
 
             int componentType = params.value("typeCode", COMPONENT_TYPE_ANY);
 
-            std::vector<Component> components =
-                ORBEngine::GetSharedInstance().GetORBPlatform()->Broadcast_GetComponents(ccid,
+            ORBEngine &engine = ORBEngine::GetSharedInstance();
+            std::shared_ptr<const BroadcastCache::ComponentList> components =
+                engine.GetBroadcastCache()->GetComponents(engine.GetORBPlatform(), ccid,
                     componentType);
             json array = json::array();
-            for (auto component : components)
+            for (const Component &component : *components)
             {
                 array.push_back(JsonUtil::ComponentToJsonObject(component));
             }
@@ -408,6 +395,8 @@ bool BroadcastRequestHandler::Handle(
             std::shared_ptr<Query> query = std::make_shared<Query>(queryAsString);
             int offset = params.value("offset", -1);
             int count = params.value("count", -1);
+            bool stopAtCount = params.value("stopAtCount", false);
+            int pageSize = params.value("pageSize", 0);
             json array = params["channelConstraints"];
             std::vector<std::string> channelConstraints;
             for (int i = 0; i < array.size(); i++)
@@ -417,9 +406,10 @@ bool BroadcastRequestHandler::Handle(
             // cancel existing search task (if any) before starting a new one
             CancelSearch(query->GetQueryId());
             std::shared_ptr<MetadataSearchTask> searchTask = std::make_shared<MetadataSearchTask>(
-                query, offset, count, channelConstraints);
+                query, offset, count, channelConstraints, stopAtCount, pageSize);
             ORBEngine::GetSharedInstance().AddMetadataSearchTask(query->GetQueryId(), searchTask);
-            searchTask->Start();
+            ORBEngine::GetSharedInstance().GetMetadataSearchScheduler()->Submit(
+                token["payload"].value("appId", 0), searchTask);
         }
     }
     // Broadcast.abortSearch
@@ -435,9 +425,8 @@ bool BroadcastRequestHandler::Handle(
             int offset = params.value("offset", -1);
             int totalSize = params.value("totalSize", -1);
             CancelSearch(queryId);
-            std::vector<std::string> searchResults;
-            MetadataSearchTask::OnMetadataSearchCompleted(queryId, SEARCH_STATUS_ABORTED,
-                searchResults, offset, totalSize);
+            MetadataSearchTask::OnMetadataSearchCompleted(queryId, SEARCH_STATUS_ABORTED, "[]",
+                offset, totalSize);
         }
     }
     // Broadcast.addStreamEventListener
@@ -586,6 +575,35 @@ bool BroadcastRequestHandler::IsRequestAllowed(json token, ApplicationManager::M
         methodType);
 }
 
+/**
+ * @brief BroadcastRequestHandler::HandleSerialized
+ *
+ * Handle Broadcast.getChannelList with the serialised channel list held by the broadcast
+ * cache.
+ *
+ * @param token     (in)  The JSON token included in the request
+ * @param method    (in)  The requested method
+ * @param params    (in)  The requested method's input parameters
+ * @param response  (out) The serialised response
+ *
+ * @return true if the request was handled, otherwise false
+ */
+bool BroadcastRequestHandler::HandleSerialized(json token, std::string method, json params,
+    std::string& response)
+{
+    if (method != BROADCAST_GET_CHANNEL_LIST ||
+        !IsRequestAllowed(token, ApplicationManager::MethodRequirement::FOR_BROADCAST_APP_ONLY))
+    {
+        return false;
+    }
+
+    ORBEngine &engine = ORBEngine::GetSharedInstance();
+    std::shared_ptr<const BroadcastCache::ChannelList> channelList =
+        engine.GetBroadcastCache()->GetChannelList(engine.GetORBPlatform());
+    response = "{\"result\":" + channelList->json + "}";
+    return true;
+}
+
 /**
  * @brief BroadcastRequestHandler::CancelSearch
  *
@@ -601,8 +619,8 @@ void BroadcastRequestHandler::CancelSearch(int queryId)
     {
         ORB_LOG("Aborting existing search task");
         searchTask->Stop();
-        // REMARK: this is safe as the detached thread has its own shared_ptr ensuring that
-        //         the task is not destroyed while it is running.
+        // REMARK: this is safe as the scheduler has its own shared_ptr ensuring that
+        //         the task is not destroyed while it is queued or running.
         engine.RemoveMetadataSearchTask(queryId);
     }
 }
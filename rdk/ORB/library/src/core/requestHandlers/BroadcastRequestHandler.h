@@ -33,6 +33,9 @@ public:
 
     virtual bool Handle(json token, std::string method, json params, json& response) override;
 
+    virtual bool HandleSerialized(json token, std::string method, json params,
+        std::string& response) override;
+
 private:
 
     int AddStreamEventListener(std::string targetUrl, std::string eventName, int componentTag, int
@@ -333,11 +333,12 @@ int ConfigurationRequestHandler::GetExtraUHDVideoDecodes()
 std::vector<int> ConfigurationRequestHandler::GetDttNetworkIds()
 {
     std::vector<int> dttNetworkIds;
-    std::vector<Channel> channelList =
-        ORBEngine::GetSharedInstance().GetORBPlatform()->Broadcast_GetChannelList();
-    dttNetworkIds.reserve(channelList.size());
+    ORBEngine &engine = ORBEngine::GetSharedInstance();
+    std::shared_ptr<const BroadcastCache::ChannelList> channelList =
+        engine.GetBroadcastCache()->GetChannelList(engine.GetORBPlatform());
+    dttNetworkIds.reserve(channelList->channels.size());
 
-    for (const auto& channel : channelList)
+    for (const auto& channel : channelList->channels)
     {
         int idType = channel.GetIdType();
         if (idType == Channel::IdType::CHANNEL_ID_DVB_T || idType ==
@@ -81,4 +81,23 @@ std::shared_ptr<ORBBridgeRequestHandler> ORBBridgeRequestHandler::Get(std::strin
     }
     return nullptr;
 }
-} // namespace orb
\ No newline at end of file
+
+/**
+ * @brief ORBBridgeRequestHandler::HandleSerialized
+ *
+ * Handle the specified request with a response that is already serialised, for requests
+ * whose results are cached as JSON. Requests that are not handled are passed to Handle.
+ *
+ * @param token     (in)  The JSON token included in the request
+ * @param method    (in)  The requested method
+ * @param params    (in)  The requested method's input parameters
+ * @param response  (out) The serialised response
+ *
+ * @return true if the request was handled, otherwise false
+ */
+bool ORBBridgeRequestHandler::HandleSerialized(json token, std::string method, json params,
+    std::string& response)
+{
+    return false;
+}
+} // namespace orb
@@ -62,5 +62,21 @@ public:
      * @return true in success, otherwise false
      */
     virtual bool Handle(json token, std::string method, json params, json& response) = 0;
+
+    /**
+     * @brief ORBBridgeRequestHandler::HandleSerialized
+     *
+     * Handle the specified request with a response that is already serialised, for requests
+     * whose results are cached as JSON. Requests that are not handled are passed to Handle.
+     *
+     * @param token     (in)  The JSON token included in the request
+     * @param method    (in)  The requested method
+     * @param params    (in)  The requested method's input parameters
+     * @param response  (out) The serialised response
+     *
+     * @return true if the request was handled, otherwise false
+     */
+    virtual bool HandleSerialized(json token, std::string method, json params,
+        std::string& response);
 }; // class ORBBridgeRequestHandler
 } // namespace orb
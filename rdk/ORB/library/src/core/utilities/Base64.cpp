@@ -22,6 +22,15 @@
  * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "Base64.h"
+#include "CpuFeatures.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace orb {
 static constexpr char sEncodingTable[] = {
@@ -54,6 +63,247 @@ static constexpr unsigned char kDecodingTable[] = {
     64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64
 };
 
+/*
+ * The vector kernels below encode or decode as many whole blocks as they can and return the
+ * number of input bytes they consumed; the scalar loops finish the rest. The x86 kernels are
+ * those described by Wojciech Muła and Daniel Lemire in "Faster Base64 Encoding and Decoding
+ * using AVX2 Instructions".
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("ssse3")))
+static inline
+__m128i EncodeIndicesSsse3(__m128i in)
+{
+    // Spread 12 bytes over 16 and move each 6 bit group into its own byte
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map each index to the offset of its range of the alphabet
+    __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    offsets = _mm_or_si128(offsets, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, offsets), indices);
+}
+
+__attribute__((target("ssse3")))
+static
+size_t EncodeSsse3(const uint8_t *in, size_t len, char *out)
+{
+    size_t i = 0;
+    // 12 bytes are encoded from each 16 byte load
+    for (; i + 16 <= len; i += 12, out += 16)
+    {
+        __m128i chars = EncodeIndicesSsse3(_mm_loadu_si128((const __m128i *) (in + i)));
+        _mm_storeu_si128((__m128i *) out, chars);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static
+size_t EncodeAvx2(const uint8_t *in, size_t len, char *out)
+{
+    size_t i = 0;
+    // 24 bytes, 12 in each lane, are encoded from two 16 byte loads
+    for (; i + 28 <= len; i += 24, out += 32)
+    {
+        __m256i in256 = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (in + i))),
+            _mm_loadu_si128((const __m128i *) (in + i + 12)), 1);
+        in256 = _mm256_shuffle_epi8(in256, _mm256_setr_epi8(
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m256i t0 = _mm256_and_si256(in256, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in256, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        offsets = _mm256_or_si256(offsets, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        const __m256i shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0,
+            0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        _mm256_storeu_si256((__m256i *) out,
+            _mm256_add_epi8(_mm256_shuffle_epi8(shift, offsets), indices));
+    }
+    return i;
+}
+
+/**
+ * Translate 16 characters to their 6 bit values. Returns false if any is not in the alphabet,
+ * including padding.
+ */
+__attribute__((target("ssse3")))
+static inline
+bool DecodeValuesSsse3(__m128i &chars)
+{
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+        0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask2F);
+    const __m128i loNibbles = _mm_and_si128(chars, mask2F);
+    const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+    {
+        return false;
+    }
+    const __m128i eq2F = _mm_cmpeq_epi8(chars, mask2F);
+    chars = _mm_add_epi8(chars, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles)));
+    return true;
+}
+
+__attribute__((target("ssse3")))
+static
+size_t DecodeSsse3(const char *in, size_t len, uint8_t *out, size_t outLen)
+{
+    size_t i = 0;
+    // 16 characters are decoded to 12 bytes, but 16 bytes are stored
+    for (; i + 16 <= len && i / 4 * 3 + 16 <= outLen; i += 16, out += 12)
+    {
+        __m128i values = _mm_loadu_si128((const __m128i *) (in + i));
+        if (!DecodeValuesSsse3(values))
+        {
+            break;
+        }
+        const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i *) out, _mm_shuffle_epi8(triples,
+            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static
+size_t DecodeAvx2(const char *in, size_t len, uint8_t *out, size_t outLen)
+{
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04,
+        0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+
+    size_t i = 0;
+    // 32 characters are decoded to 24 bytes, but 32 bytes are stored
+    for (; i + 32 <= len && i / 4 * 3 + 32 <= outLen; i += 32, out += 24)
+    {
+        __m256i chars = _mm256_loadu_si256((const __m256i *) (in + i));
+        const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask2F);
+        const __m256i loNibbles = _mm256_and_si256(chars, mask2F);
+        const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        if (!_mm256_testz_si256(lo, hi))
+        {
+            break;
+        }
+        const __m256i eq2F = _mm256_cmpeq_epi8(chars, mask2F);
+        chars = _mm256_add_epi8(chars,
+            _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles)));
+        const __m256i pairs = _mm256_maddubs_epi16(chars, _mm256_set1_epi32(0x01400140));
+        __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        triples = _mm256_shuffle_epi8(triples, _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm256_storeu_si256((__m256i *) out, _mm256_permutevar8x32_epi32(triples,
+            _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1)));
+    }
+    return i;
+}
+#endif
+
+#if defined(__aarch64__)
+static
+size_t EncodeNeon(const uint8_t *in, size_t len, char *out)
+{
+    const uint8x16x4_t alphabet = {{
+        vld1q_u8(reinterpret_cast<const uint8_t *>(sEncodingTable)),
+        vld1q_u8(reinterpret_cast<const uint8_t *>(sEncodingTable) + 16),
+        vld1q_u8(reinterpret_cast<const uint8_t *>(sEncodingTable) + 32),
+        vld1q_u8(reinterpret_cast<const uint8_t *>(sEncodingTable) + 48)
+    }};
+    const uint8x16_t mask3F = vdupq_n_u8(0x3F);
+
+    size_t i = 0;
+    // 48 bytes, loaded as 16 triples, are encoded to 64 characters
+    for (; i + 48 <= len; i += 48, out += 64)
+    {
+        const uint8x16x3_t src = vld3q_u8(in + i);
+        uint8x16x4_t chars;
+        chars.val[0] = vshrq_n_u8(src.val[0], 2);
+        chars.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(src.val[0], 4), vshrq_n_u8(src.val[1], 4)),
+            mask3F);
+        chars.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(src.val[1], 2), vshrq_n_u8(src.val[2], 6)),
+            mask3F);
+        chars.val[3] = vandq_u8(src.val[2], mask3F);
+        for (int j = 0; j < 4; j++)
+        {
+            chars.val[j] = vqtbl4q_u8(alphabet, chars.val[j]);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t *>(out), chars);
+    }
+    return i;
+}
+
+static
+size_t DecodeNeon(const char *in, size_t len, uint8_t *out, size_t outLen)
+{
+    const uint8x16x4_t lo = {{
+        vld1q_u8(kDecodingTable), vld1q_u8(kDecodingTable + 16),
+        vld1q_u8(kDecodingTable + 32), vld1q_u8(kDecodingTable + 48)
+    }};
+    const uint8x16x4_t hi = {{
+        vld1q_u8(kDecodingTable + 64), vld1q_u8(kDecodingTable + 80),
+        vld1q_u8(kDecodingTable + 96), vld1q_u8(kDecodingTable + 112)
+    }};
+    const uint8x16_t offset = vdupq_n_u8(64);
+
+    size_t i = 0;
+    // 64 characters, loaded as 16 quads, are decoded to 48 bytes
+    for (; i + 64 <= len && i / 4 * 3 + 48 <= outLen; i += 64, out += 48)
+    {
+        uint8x16x4_t values = vld4q_u8(reinterpret_cast<const uint8_t *>(in + i));
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for (int j = 0; j < 4; j++)
+        {
+            // Characters from 128 up look up nothing, so are caught by their top bit
+            const uint8x16_t chars = values.val[j];
+            values.val[j] = vqtbx4q_u8(vqtbl4q_u8(lo, chars), hi, vsubq_u8(chars, offset));
+            invalid = vorrq_u8(invalid, vorrq_u8(values.val[j], vshrq_n_u8(chars, 1)));
+        }
+        if (vmaxvq_u8(invalid) >= 64)
+        {
+            break;
+        }
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+        vst3q_u8(out, bytes);
+    }
+    return i;
+}
+#endif
+
 /**
  * Base64::Encode
  *
@@ -68,28 +318,49 @@ std::string Base64::Encode(const std::string data)
     size_t in_len = data.size();
     size_t out_len = 4 * ((in_len + 2) / 3);
     std::string ret(out_len, '\0');
-    size_t i;
-    char *p = const_cast<char *>(ret.c_str());
+    size_t i = 0;
+    char *p = &ret[0];
+    const uint8_t *in = reinterpret_cast<const uint8_t *>(data.data());
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (CpuFeatures::Has(CpuFeatures::FEATURE_AVX2))
+    {
+        i = EncodeAvx2(in, in_len, p);
+        p += i / 3 * 4;
+    }
+    if (CpuFeatures::Has(CpuFeatures::FEATURE_SSSE3))
+    {
+        size_t count = EncodeSsse3(in + i, in_len - i, p);
+        i += count;
+        p += count / 3 * 4;
+    }
+#elif defined(__aarch64__)
+    if (CpuFeatures::Has(CpuFeatures::FEATURE_NEON))
+    {
+        i = EncodeNeon(in, in_len, p);
+        p += i / 3 * 4;
+    }
+#endif
 
-    for (i = 0; i < in_len - 2; i += 3)
+    for (; i + 2 < in_len; i += 3)
     {
-        *p++ = sEncodingTable[(data[i] >> 2) & 0x3F];
-        *p++ = sEncodingTable[((data[i] & 0x3) << 4) | ((int) (data[i + 1] & 0xF0) >> 4)];
-        *p++ = sEncodingTable[((data[i + 1] & 0xF) << 2) | ((int) (data[i + 2] & 0xC0) >> 6)];
-        *p++ = sEncodingTable[data[i + 2] & 0x3F];
+        *p++ = sEncodingTable[(in[i] >> 2) & 0x3F];
+        *p++ = sEncodingTable[((in[i] & 0x3) << 4) | ((int) (in[i + 1] & 0xF0) >> 4)];
+        *p++ = sEncodingTable[((in[i + 1] & 0xF) << 2) | ((int) (in[i + 2] & 0xC0) >> 6)];
+        *p++ = sEncodingTable[in[i + 2] & 0x3F];
     }
     if (i < in_len)
     {
-        *p++ = sEncodingTable[(data[i] >> 2) & 0x3F];
+        *p++ = sEncodingTable[(in[i] >> 2) & 0x3F];
         if (i == (in_len - 1))
         {
-            *p++ = sEncodingTable[((data[i] & 0x3) << 4)];
+            *p++ = sEncodingTable[((in[i] & 0x3) << 4)];
             *p++ = '=';
         }
         else
         {
-            *p++ = sEncodingTable[((data[i] & 0x3) << 4) | ((int) (data[i + 1] & 0xF0) >> 4)];
-            *p++ = sEncodingTable[((data[i + 1] & 0xF) << 2)];
+            *p++ = sEncodingTable[((in[i] & 0x3) << 4) | ((int) (in[i + 1] & 0xF0) >> 4)];
+            *p++ = sEncodingTable[((in[i + 1] & 0xF) << 2)];
         }
         *p++ = '=';
     }
@@ -114,6 +385,11 @@ std::string Base64::Decode(const std::string& input, std::string& out)
     {
         return "Input data size is not a multiple of 4";
     }
+    if (in_len == 0)
+    {
+        out.clear();
+        return "";
+    }
 
     size_t out_len = in_len / 4 * 3;
     if (input[in_len - 1] == '=')
@@ -123,12 +399,35 @@ std::string Base64::Decode(const std::string& input, std::string& out)
 
     out.resize(out_len);
 
-    for (size_t i = 0, j = 0; i < in_len;)
+    size_t start = 0;
+    uint8_t *decoded = reinterpret_cast<uint8_t *>(&out[0]);
+#if defined(__x86_64__) || defined(__i386__)
+    if (CpuFeatures::Has(CpuFeatures::FEATURE_AVX2))
+    {
+        start = DecodeAvx2(input.data(), in_len, decoded, out_len);
+    }
+    if (CpuFeatures::Has(CpuFeatures::FEATURE_SSSE3))
+    {
+        start += DecodeSsse3(input.data() + start, in_len - start, decoded + start / 4 * 3,
+            out_len - start / 4 * 3);
+    }
+#elif defined(__aarch64__)
+    if (CpuFeatures::Has(CpuFeatures::FEATURE_NEON))
+    {
+        start = DecodeNeon(input.data(), in_len, decoded, out_len);
+    }
+#endif
+
+    for (size_t i = start, j = start / 4 * 3; i < in_len;)
     {
-        uint32_t a = input[i] == '=' ? 0 & i++ : kDecodingTable[static_cast<int>(input[i++])];
-        uint32_t b = input[i] == '=' ? 0 & i++ : kDecodingTable[static_cast<int>(input[i++])];
-        uint32_t c = input[i] == '=' ? 0 & i++ : kDecodingTable[static_cast<int>(input[i++])];
-        uint32_t d = input[i] == '=' ? 0 & i++ : kDecodingTable[static_cast<int>(input[i++])];
+        uint32_t a = input[i] == '=' ? 0 & i++ :
+            kDecodingTable[static_cast<unsigned char>(input[i++])];
+        uint32_t b = input[i] == '=' ? 0 & i++ :
+            kDecodingTable[static_cast<unsigned char>(input[i++])];
+        uint32_t c = input[i] == '=' ? 0 & i++ :
+            kDecodingTable[static_cast<unsigned char>(input[i++])];
+        uint32_t d = input[i] == '=' ? 0 & i++ :
+            kDecodingTable[static_cast<unsigned char>(input[i++])];
 
         uint32_t triple = (a << 3 * 6) + (b << 2 * 6) + (c << 1 * 6) + (d << 0 * 6);
 
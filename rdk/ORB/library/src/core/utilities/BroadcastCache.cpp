@@ -0,0 +1,125 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BroadcastCache.h"
+#include "ORBPlatform.h"
+#include "JsonUtil.h"
+#include "ORBLogging.h"
+
+namespace orb {
+/**
+ * Constructor.
+ */
+BroadcastCache::BroadcastCache()
+    : m_channelListVersion(0)
+    , m_cachedChannelListVersion(0)
+    , m_componentsVersion(0)
+    , m_cachedComponentsVersion(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+BroadcastCache::~BroadcastCache()
+{
+}
+
+/**
+ * @brief BroadcastCache::GetChannelList
+ *
+ * @param platform The platform to get the channel list from if it is not cached
+ *
+ * @return The channel list
+ */
+std::shared_ptr<const BroadcastCache::ChannelList> BroadcastCache::GetChannelList(
+    ORBPlatform *platform)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Read the version first, so a change reported while fetching is fetched next time
+    const uint32_t version = m_channelListVersion.load();
+    if (!m_channelList || m_cachedChannelListVersion != version)
+    {
+        ORB_LOG("Fetching channel list, version %u", version);
+        std::shared_ptr<ChannelList> channelList = std::make_shared<ChannelList>();
+        channelList->channels = platform->Broadcast_GetChannelList();
+        json array = json::array();
+        for (const Channel &channel : channelList->channels)
+        {
+            array.push_back(JsonUtil::ChannelToJsonObject(channel));
+        }
+        channelList->json = array.dump();
+        m_channelList = channelList;
+        m_cachedChannelListVersion = version;
+    }
+    return m_channelList;
+}
+
+/**
+ * @brief BroadcastCache::GetComponents
+ *
+ * @param platform      The platform to get the components from if they are not cached
+ * @param ccid          The ID of the channel
+ * @param componentType The component type, or COMPONENT_TYPE_ANY
+ *
+ * @return The components of the channel of the specified type
+ */
+std::shared_ptr<const BroadcastCache::ComponentList> BroadcastCache::GetComponents(
+    ORBPlatform *platform, const std::string &ccid, int componentType)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t version = m_componentsVersion.load();
+    if (m_cachedComponentsVersion != version)
+    {
+        m_components.clear();
+        m_cachedComponentsVersion = version;
+    }
+    const std::pair<std::string, int> key(ccid, componentType);
+    auto it = m_components.find(key);
+    if (it != m_components.end())
+    {
+        return it->second;
+    }
+    std::shared_ptr<const ComponentList> components = std::make_shared<const ComponentList>(
+        platform->Broadcast_GetComponents(ccid, componentType));
+    // Not kept if the components changed while they were fetched
+    if (m_componentsVersion.load() == version)
+    {
+        m_components[key] = components;
+    }
+    return components;
+}
+
+/**
+ * @brief BroadcastCache::InvalidateChannelList
+ *
+ * Mark the channel list as out of date.
+ */
+void BroadcastCache::InvalidateChannelList()
+{
+    m_channelListVersion++;
+}
+
+/**
+ * @brief BroadcastCache::InvalidateComponents
+ *
+ * Mark the components of every channel as out of date.
+ */
+void BroadcastCache::InvalidateComponents()
+{
+    m_componentsVersion++;
+}
+} // namespace orb
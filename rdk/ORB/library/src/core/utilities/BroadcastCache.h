@@ -0,0 +1,106 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Channel.h"
+#include "Component.h"
+
+class ORBPlatform;
+
+namespace orb {
+/**
+ * @brief orb::BroadcastCache
+ *
+ * Shared, immutable snapshots of the channel list and of the components of each channel, as
+ * last returned by the platform. The snapshots are fetched again after the platform reports
+ * that they may have changed, instead of on every request.
+ */
+class BroadcastCache {
+public:
+
+    struct ChannelList
+    {
+        std::vector<Channel> channels;
+        std::string json; // Serialised JSON array, as returned by Broadcast.getChannelList
+    };
+
+    typedef std::vector<Component> ComponentList;
+
+    /**
+     * Constructor.
+     */
+    BroadcastCache();
+
+    /**
+     * Destructor.
+     */
+    ~BroadcastCache();
+
+    /**
+     * @brief BroadcastCache::GetChannelList
+     *
+     * @param platform The platform to get the channel list from if it is not cached
+     *
+     * @return The channel list
+     */
+    std::shared_ptr<const ChannelList> GetChannelList(ORBPlatform *platform);
+
+    /**
+     * @brief BroadcastCache::GetComponents
+     *
+     * @param platform      The platform to get the components from if they are not cached
+     * @param ccid          The ID of the channel
+     * @param componentType The component type, or COMPONENT_TYPE_ANY
+     *
+     * @return The components of the channel of the specified type
+     */
+    std::shared_ptr<const ComponentList> GetComponents(ORBPlatform *platform,
+        const std::string &ccid, int componentType);
+
+    /**
+     * @brief BroadcastCache::InvalidateChannelList
+     *
+     * Mark the channel list as out of date.
+     */
+    void InvalidateChannelList();
+
+    /**
+     * @brief BroadcastCache::InvalidateComponents
+     *
+     * Mark the components of every channel as out of date.
+     */
+    void InvalidateComponents();
+
+private:
+
+    std::mutex m_mutex; // Held while snapshots are fetched
+    std::atomic<uint32_t> m_channelListVersion;
+    uint32_t m_cachedChannelListVersion;
+    std::shared_ptr<const ChannelList> m_channelList;
+    std::atomic<uint32_t> m_componentsVersion;
+    uint32_t m_cachedComponentsVersion;
+    std::map<std::pair<std::string, int>, std::shared_ptr<const ComponentList> > m_components;
+}; // class BroadcastCache
+} // namespace orb
@@ -0,0 +1,92 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CpuFeatures.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+namespace orb {
+
+static
+unsigned int Detect()
+{
+    unsigned int features = 0;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        features |= CpuFeatures::FEATURE_SSSE3;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        features |= CpuFeatures::FEATURE_AVX2;
+    }
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA) &&
+        __builtin_cpu_supports("sse4.1"))
+    {
+        features |= CpuFeatures::FEATURE_SHA_NI;
+    }
+#elif defined(__aarch64__)
+    // Advanced SIMD is part of the AArch64 base architecture
+    features |= CpuFeatures::FEATURE_NEON;
+    if (getauxval(AT_HWCAP) & HWCAP_SHA2)
+    {
+        features |= CpuFeatures::FEATURE_ARM_SHA2;
+    }
+#endif
+    return features;
+}
+
+static
+std::atomic<unsigned int>& Enabled()
+{
+    static std::atomic<unsigned int> enabled(Detect());
+    return enabled;
+}
+
+/**
+ * @brief CpuFeatures::Has
+ *
+ * @param feature The feature
+ *
+ * @return true if the CPU supports the feature and it is not restricted, otherwise false
+ */
+bool CpuFeatures::Has(Feature feature)
+{
+    return (Enabled().load(std::memory_order_relaxed) & feature) != 0;
+}
+
+/**
+ * @brief CpuFeatures::Restrict
+ *
+ * Limit the features that are used to those in the specified mask, for example to compare
+ * the kernels. FEATURE_ALL restores the detected features.
+ *
+ * @param features The mask of features that may be used
+ */
+void CpuFeatures::Restrict(unsigned int features)
+{
+    Enabled().store(Detect() & features);
+}
+} // namespace orb
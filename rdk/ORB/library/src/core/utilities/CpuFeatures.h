@@ -0,0 +1,58 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace orb {
+/**
+ * @brief orb::CpuFeatures
+ *
+ * The instruction set extensions of the CPU that the SHA256 and Base64 kernels can use, as
+ * detected at run time.
+ */
+class CpuFeatures {
+public:
+
+    enum Feature
+    {
+        FEATURE_SSSE3 = 1u << 0,
+        FEATURE_AVX2 = 1u << 1,
+        FEATURE_SHA_NI = 1u << 2,
+        FEATURE_NEON = 1u << 3,
+        FEATURE_ARM_SHA2 = 1u << 4,
+        FEATURE_ALL = ~0u
+    };
+
+    /**
+     * @brief CpuFeatures::Has
+     *
+     * @param feature The feature
+     *
+     * @return true if the CPU supports the feature and it is not restricted, otherwise false
+     */
+    static bool Has(Feature feature);
+
+    /**
+     * @brief CpuFeatures::Restrict
+     *
+     * Limit the features that are used to those in the specified mask, for example to compare
+     * the kernels. FEATURE_ALL restores the detected features.
+     *
+     * @param features The mask of features that may be used
+     */
+    static void Restrict(unsigned int features);
+}; // class CpuFeatures
+} // namespace orb
@@ -0,0 +1,272 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DsmccFileCache.h"
+#include "ORBLogging.h"
+
+#include <utility>
+
+namespace orb {
+/**
+ * Constructor.
+ *
+ * @param capacityBytes The total size of the files that may be cached
+ */
+DsmccFileCache::DsmccFileCache(size_t capacityBytes)
+    : m_capacityBytes(capacityBytes)
+    , m_platformDeliversContent(false)
+    , m_stats{0, 0, 0, 0, 0, 0, 0, 0, 0}
+{
+}
+
+/**
+ * Destructor.
+ */
+DsmccFileCache::~DsmccFileCache()
+{
+}
+
+/**
+ * @brief DsmccFileCache::Find
+ *
+ * Find the file, or else record that the request loads it or waits for it.
+ *
+ * @param carouselId    The ID of the carousel
+ * @param url           The DVB URL of the file
+ * @param moduleVersion The version of the module that carries the file
+ * @param requestId     The ID of the request
+ * @param content       Set to the file content on LOOKUP_HIT
+ *
+ * @return LOOKUP_HIT, LOOKUP_JOINED or LOOKUP_MISS
+ */
+DsmccFileCache::Lookup DsmccFileCache::Find(uint32_t carouselId, const std::string &url,
+    uint32_t moduleVersion, int requestId, Content &content)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Key key{carouselId, url, moduleVersion};
+    EvictOtherVersions(key);
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        content = it->second->content;
+        m_stats.hits++;
+        m_stats.savedLatencyUs += it->second->loadUs;
+        ORB_LOG("Hit url=%s saved=%lluus", url.c_str(),
+            static_cast<unsigned long long>(it->second->loadUs));
+        return LOOKUP_HIT;
+    }
+    auto loading = m_loading.find(key);
+    if (m_platformDeliversContent && loading != m_loading.end())
+    {
+        m_loads[loading->second].waiters.push_back(requestId);
+        m_stats.joined++;
+        return LOOKUP_JOINED;
+    }
+    AddLoad(key, requestId);
+    m_stats.misses++;
+    return LOOKUP_MISS;
+}
+
+/**
+ * @brief DsmccFileCache::StartPrefetch
+ *
+ * Record that the request prefetches the file, unless it is cached or being loaded.
+ *
+ * @param carouselId    The ID of the carousel
+ * @param url           The DVB URL of the file
+ * @param moduleVersion The version of the module that carries the file
+ * @param requestId     The ID of the prefetch request
+ *
+ * @return true if the file should be requested from the carousel, otherwise false
+ */
+bool DsmccFileCache::StartPrefetch(uint32_t carouselId, const std::string &url,
+    uint32_t moduleVersion, int requestId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Key key{carouselId, url, moduleVersion};
+    EvictOtherVersions(key);
+    if (!m_platformDeliversContent || m_index.count(key) > 0 || m_loading.count(key) > 0)
+    {
+        return false;
+    }
+    AddLoad(key, requestId);
+    m_stats.prefetches++;
+    return true;
+}
+
+/**
+ * @brief DsmccFileCache::Complete
+ *
+ * Cache the content loaded by the request. The content is shared with the cache, not copied.
+ *
+ * @param requestId The ID of the request
+ * @param content   The loaded content, empty if the load failed
+ *
+ * @return The IDs of the requests that waited for this load
+ */
+std::vector<int> DsmccFileCache::Complete(int requestId, const Content &content)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_loads.find(requestId);
+    if (it == m_loads.end())
+    {
+        return std::vector<int>();
+    }
+    Load load = std::move(it->second);
+    m_loads.erase(it);
+    auto loading = m_loading.find(load.key);
+    if (loading != m_loading.end() && loading->second == requestId)
+    {
+        m_loading.erase(loading);
+    }
+    if (content->empty())
+    {
+        return load.waiters;
+    }
+    m_platformDeliversContent = true;
+
+    // Not kept if the carousel changed while the file was loaded, or if it can never fit
+    if (m_carouselGenerations[load.key.carouselId] != load.generation ||
+        content->size() > m_capacityBytes)
+    {
+        return load.waiters;
+    }
+    auto existing = m_index.find(load.key);
+    if (existing != m_index.end())
+    {
+        Evict(existing->second);
+    }
+    while (!m_entries.empty() && m_stats.bytes + content->size() > m_capacityBytes)
+    {
+        Evict(std::prev(m_entries.end()));
+        m_stats.evictions++;
+    }
+    const uint64_t loadUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - load.started).count();
+    m_entries.push_front(Entry{load.key, content, loadUs});
+    m_index[load.key] = m_entries.begin();
+    m_stats.bytes += content->size();
+    m_stats.files++;
+    return load.waiters;
+}
+
+/**
+ * @brief DsmccFileCache::CompleteWithoutContent
+ *
+ * End a load whose content the platform delivered directly to the browser. Requests that
+ * waited for it must load the file themselves.
+ *
+ * @param requestId The ID of the request
+ * @param url       Set to the DVB URL of the file
+ *
+ * @return The IDs of the requests that waited for this load
+ */
+std::vector<int> DsmccFileCache::CompleteWithoutContent(int requestId, std::string &url)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_platformDeliversContent = false;
+    auto it = m_loads.find(requestId);
+    if (it == m_loads.end())
+    {
+        return std::vector<int>();
+    }
+    url = it->second.key.url;
+    std::vector<int> waiters = std::move(it->second.waiters);
+    auto loading = m_loading.find(it->second.key);
+    if (loading != m_loading.end() && loading->second == requestId)
+    {
+        m_loading.erase(loading);
+    }
+    m_loads.erase(it);
+    return waiters;
+}
+
+/**
+ * @brief DsmccFileCache::InvalidateCarousel
+ *
+ * Drop the files of the carousel, including those still being loaded.
+ *
+ * @param carouselId The ID of the carousel
+ */
+void DsmccFileCache::InvalidateCarousel(uint32_t carouselId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_carouselGenerations[carouselId]++;
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        auto next = std::next(it);
+        if (it->key.carouselId == carouselId)
+        {
+            Evict(it);
+        }
+        it = next;
+    }
+    m_stats.invalidations++;
+}
+
+/**
+ * @brief DsmccFileCache::GetStats
+ *
+ * @return The cache activity so far
+ */
+DsmccFileCache::Stats DsmccFileCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/**
+ * Record a load of the file by the request. Called with the mutex held.
+ */
+void DsmccFileCache::AddLoad(const Key &key, int requestId)
+{
+    m_loads[requestId] = Load{key, m_carouselGenerations[key.carouselId],
+                              std::chrono::steady_clock::now(), std::vector<int>()};
+    m_loading.insert(std::make_pair(key, requestId));
+}
+
+/**
+ * Remove the entry from the cache. Called with the mutex held.
+ */
+void DsmccFileCache::Evict(std::list<Entry>::iterator entry)
+{
+    m_stats.bytes -= entry->content->size();
+    m_stats.files--;
+    m_index.erase(entry->key);
+    m_entries.erase(entry);
+}
+
+/**
+ * Remove the entries of the file of the key that are from other versions of its module, which
+ * can no longer be served. Called with the mutex held.
+ */
+void DsmccFileCache::EvictOtherVersions(const Key &key)
+{
+    auto it = m_index.lower_bound(Key{key.carouselId, key.url, 0});
+    while (it != m_index.end() && it->first.carouselId == key.carouselId &&
+           it->first.url == key.url)
+    {
+        auto entry = it->second;
+        ++it;
+        if (entry->key.moduleVersion != key.moduleVersion)
+        {
+            Evict(entry);
+            m_stats.evictions++;
+        }
+    }
+}
+} // namespace orb
@@ -0,0 +1,203 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace orb {
+/**
+ * @brief orb::DsmccFileCache
+ *
+ * Files loaded from DSM-CC object carousels, kept up to a size in bytes and evicted least
+ * recently used first. Files are keyed by carousel, DVB URL and the version of the module that
+ * carries them, so a file is never served from an older version of its module. The files of a
+ * carousel are also dropped when the platform reports that one of its modules changed version.
+ * Requests for a file that is already being loaded wait for that load rather than asking the
+ * carousel again.
+ *
+ * Only files whose content the platform passes through the engine (OnDvbUrlLoaded) can be
+ * cached. Until the platform has done so, files are neither prefetched nor shared between
+ * requests.
+ */
+class DsmccFileCache {
+public:
+
+    static const size_t DEFAULT_CAPACITY_BYTES = 8 * 1024 * 1024;
+
+    typedef std::shared_ptr<const std::vector<uint8_t> > Content;
+
+    enum Lookup
+    {
+        LOOKUP_HIT, // The file was cached
+        LOOKUP_JOINED, // The file is being loaded and the request will complete with that load
+        LOOKUP_MISS // The file must be loaded by the request
+    };
+
+    /**
+     * Cache activity so far. Saved latency is the sum of the load times of the files served
+     * from the cache, in microseconds.
+     */
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t joined;
+        uint64_t misses;
+        uint64_t prefetches;
+        uint64_t evictions;
+        uint64_t invalidations;
+        uint64_t savedLatencyUs;
+        size_t bytes;
+        size_t files;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param capacityBytes The total size of the files that may be cached
+     */
+    explicit DsmccFileCache(size_t capacityBytes = DEFAULT_CAPACITY_BYTES);
+
+    /**
+     * Destructor.
+     */
+    ~DsmccFileCache();
+
+    /**
+     * @brief DsmccFileCache::Find
+     *
+     * Find the file, or else record that the request loads it or waits for it.
+     *
+     * @param carouselId    The ID of the carousel
+     * @param url           The DVB URL of the file
+     * @param moduleVersion The version of the module that carries the file
+     * @param requestId     The ID of the request
+     * @param content       Set to the file content on LOOKUP_HIT
+     *
+     * @return LOOKUP_HIT, LOOKUP_JOINED or LOOKUP_MISS
+     */
+    Lookup Find(uint32_t carouselId, const std::string &url, uint32_t moduleVersion,
+        int requestId, Content &content);
+
+    /**
+     * @brief DsmccFileCache::StartPrefetch
+     *
+     * Record that the request prefetches the file, unless it is cached or being loaded.
+     *
+     * @param carouselId    The ID of the carousel
+     * @param url           The DVB URL of the file
+     * @param moduleVersion The version of the module that carries the file
+     * @param requestId     The ID of the prefetch request
+     *
+     * @return true if the file should be requested from the carousel, otherwise false
+     */
+    bool StartPrefetch(uint32_t carouselId, const std::string &url, uint32_t moduleVersion,
+        int requestId);
+
+    /**
+     * @brief DsmccFileCache::Complete
+     *
+     * Cache the content loaded by the request. The content is shared with the cache, not copied.
+     *
+     * @param requestId The ID of the request
+     * @param content   The loaded content, empty if the load failed
+     *
+     * @return The IDs of the requests that waited for this load
+     */
+    std::vector<int> Complete(int requestId, const Content &content);
+
+    /**
+     * @brief DsmccFileCache::CompleteWithoutContent
+     *
+     * End a load whose content the platform delivered directly to the browser. Requests that
+     * waited for it must load the file themselves.
+     *
+     * @param requestId The ID of the request
+     * @param url       Set to the DVB URL of the file
+     *
+     * @return The IDs of the requests that waited for this load
+     */
+    std::vector<int> CompleteWithoutContent(int requestId, std::string &url);
+
+    /**
+     * @brief DsmccFileCache::InvalidateCarousel
+     *
+     * Drop the files of the carousel, including those still being loaded.
+     *
+     * @param carouselId The ID of the carousel
+     */
+    void InvalidateCarousel(uint32_t carouselId);
+
+    /**
+     * @brief DsmccFileCache::GetStats
+     *
+     * @return The cache activity so far
+     */
+    Stats GetStats();
+
+private:
+
+    struct Key
+    {
+        uint32_t carouselId;
+        std::string url;
+        uint32_t moduleVersion;
+
+        bool operator<(const Key &other) const
+        {
+            return std::tie(carouselId, url, moduleVersion) <
+                   std::tie(other.carouselId, other.url, other.moduleVersion);
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        Content content;
+        uint64_t loadUs;
+    };
+
+    struct Load
+    {
+        Key key;
+        uint32_t generation; // Of the carousel when the load started
+        std::chrono::steady_clock::time_point started;
+        std::vector<int> waiters;
+    };
+
+    void AddLoad(const Key &key, int requestId);
+    void Evict(std::list<Entry>::iterator entry);
+    void EvictOtherVersions(const Key &key);
+
+    size_t m_capacityBytes;
+    std::mutex m_mutex;
+    std::list<Entry> m_entries; // Most recently used first
+    std::map<Key, std::list<Entry>::iterator> m_index;
+    std::map<int, Load> m_loads; // By request ID
+    std::map<Key, int> m_loading; // The request ID loading each file
+    std::map<uint32_t, uint32_t> m_carouselGenerations; // Incremented by InvalidateCarousel
+    bool m_platformDeliversContent;
+    Stats m_stats;
+}; // class DsmccFileCache
+} // namespace orb
@@ -0,0 +1,173 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JavaScriptEventQueue.h"
+#include "ORBLogging.h"
+#include <iterator>
+
+namespace orb {
+/**
+ * Constructor.
+ *
+ * @param dispatcher Called on the queue thread with the events of each tick
+ * @param tickMs     How long the first event of a batch waits for others, in milliseconds
+ */
+JavaScriptEventQueue::JavaScriptEventQueue(Dispatcher dispatcher, unsigned int tickMs)
+    : m_dispatcher(dispatcher)
+    , m_tick(tickMs)
+    , m_stopping(false)
+    , m_flushing(false)
+    , m_dispatching(false)
+    , m_stats{0, 0, 0}
+{
+}
+
+/**
+ * Destructor. Events that have not been dispatched yet are dispatched before it returns.
+ */
+JavaScriptEventQueue::~JavaScriptEventQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+/**
+ * @brief JavaScriptEventQueue::Post
+ *
+ * Queue the event for the next batch. The queue thread is started by the first event.
+ *
+ * @param name             The JavaScript event name
+ * @param properties       The JavaScript event properties
+ * @param targetOrigin     The target origin
+ * @param broadcastRelated Indicates whether the JavaScript event is broadcast-related or not
+ * @param coalesceKey      Identifies events that supersede each other, or empty if the event
+ *                         must always be dispatched
+ */
+void JavaScriptEventQueue::Post(const std::string &name, const std::string &properties,
+    const std::string &targetOrigin, bool broadcastRelated, const std::string &coalesceKey)
+{
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.posted++;
+        if (!coalesceKey.empty())
+        {
+            auto it = m_coalesced.find(coalesceKey);
+            if (it != m_coalesced.end())
+            {
+                // The superseded event is dropped and the latest takes its place at the end, so
+                // it is not dispatched ahead of the events posted before it
+                m_pending.erase(it->second);
+                m_coalesced.erase(it);
+                m_stats.coalesced++;
+            }
+        }
+        if (m_pending.empty())
+        {
+            m_batchStarted = std::chrono::steady_clock::now();
+            notify = true;
+        }
+        m_pending.push_back(Event{name, properties, targetOrigin, broadcastRelated});
+        if (!coalesceKey.empty())
+        {
+            m_coalesced[coalesceKey] = std::prev(m_pending.end());
+        }
+        if (!m_thread.joinable())
+        {
+            m_thread = std::thread(&JavaScriptEventQueue::ThreadLoop, this);
+        }
+    }
+    if (notify)
+    {
+        m_condition.notify_one();
+    }
+}
+
+/**
+ * @brief JavaScriptEventQueue::Flush
+ *
+ * Dispatch the pending events without waiting for the end of the tick, and return once they
+ * have been dispatched. Must not be called from the dispatcher.
+ */
+void JavaScriptEventQueue::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_pending.empty() && !m_dispatching)
+    {
+        return;
+    }
+    m_flushing = true;
+    m_condition.notify_all();
+    m_condition.wait(lock, [this] {
+        return m_pending.empty() && !m_dispatching;
+    });
+    m_flushing = false;
+}
+
+/**
+ * @brief JavaScriptEventQueue::GetStats
+ *
+ * @return The events posted and coalesced, and the batches dispatched so far
+ */
+JavaScriptEventQueue::Stats JavaScriptEventQueue::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void JavaScriptEventQueue::ThreadLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this] {
+            return m_stopping || !m_pending.empty();
+        });
+        // Let the rest of the burst arrive
+        m_condition.wait_until(lock, m_batchStarted + m_tick, [this] {
+            return m_stopping || m_flushing;
+        });
+        if (!m_pending.empty())
+        {
+            std::vector<Event> events(std::make_move_iterator(m_pending.begin()),
+                std::make_move_iterator(m_pending.end()));
+            m_pending.clear();
+            m_coalesced.clear();
+            m_stats.batches++;
+            m_dispatching = true;
+            lock.unlock();
+
+            ORB_LOG("Dispatching %zu events", events.size());
+            m_dispatcher(events);
+
+            lock.lock();
+            m_dispatching = false;
+            m_condition.notify_all();
+        }
+        if (m_stopping && m_pending.empty())
+        {
+            break;
+        }
+    }
+}
+} // namespace orb
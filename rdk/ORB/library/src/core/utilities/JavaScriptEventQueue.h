@@ -0,0 +1,122 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace orb {
+/**
+ * @brief orb::JavaScriptEventQueue
+ *
+ * Collects the JavaScript events requested during a tick and dispatches them together, in the
+ * order they were posted. An event posted with a coalescing key replaces the pending event with
+ * the same key and takes the position of the latest post, so a burst of events that only report
+ * the latest state is dispatched once, after the events that preceded its last post.
+ */
+class JavaScriptEventQueue {
+public:
+
+    static const unsigned int DEFAULT_TICK_MS = 16;
+
+    struct Event
+    {
+        std::string name;
+        std::string properties;
+        std::string targetOrigin;
+        bool broadcastRelated;
+    };
+
+    typedef std::function<void (const std::vector<Event> &events)> Dispatcher;
+
+    struct Stats
+    {
+        uint64_t posted;
+        uint64_t coalesced;
+        uint64_t batches;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param dispatcher Called on the queue thread with the events of each tick
+     * @param tickMs     How long the first event of a batch waits for others, in milliseconds
+     */
+    explicit JavaScriptEventQueue(Dispatcher dispatcher, unsigned int tickMs = DEFAULT_TICK_MS);
+
+    /**
+     * Destructor. Events that have not been dispatched yet are dispatched before it returns.
+     */
+    ~JavaScriptEventQueue();
+
+    /**
+     * @brief JavaScriptEventQueue::Post
+     *
+     * Queue the event for the next batch. The queue thread is started by the first event.
+     *
+     * @param name             The JavaScript event name
+     * @param properties       The JavaScript event properties
+     * @param targetOrigin     The target origin
+     * @param broadcastRelated Indicates whether the JavaScript event is broadcast-related or not
+     * @param coalesceKey      Identifies events that supersede each other, or empty if the event
+     *                         must always be dispatched
+     */
+    void Post(const std::string &name, const std::string &properties,
+        const std::string &targetOrigin, bool broadcastRelated,
+        const std::string &coalesceKey = "");
+
+    /**
+     * @brief JavaScriptEventQueue::Flush
+     *
+     * Dispatch the pending events without waiting for the end of the tick, and return once they
+     * have been dispatched. Must not be called from the dispatcher.
+     */
+    void Flush();
+
+    /**
+     * @brief JavaScriptEventQueue::GetStats
+     *
+     * @return The events posted and coalesced, and the batches dispatched so far
+     */
+    Stats GetStats();
+
+private:
+
+    void ThreadLoop();
+
+    Dispatcher m_dispatcher;
+    std::chrono::milliseconds m_tick;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::list<Event> m_pending;
+    std::map<std::string, std::list<Event>::iterator> m_coalesced; // Pending event by key
+    std::chrono::steady_clock::time_point m_batchStarted;
+    std::thread m_thread;
+    bool m_stopping;
+    bool m_flushing;
+    bool m_dispatching;
+    Stats m_stats;
+}; // class JavaScriptEventQueue
+} // namespace orb
@@ -228,7 +228,7 @@ std::shared_ptr<Programme> JsonUtil::ProgrammeFromJsonObject(json jsonProgramme)
         );
 }
 
-json JsonUtil::ProgrammeToJsonObject(Programme programme)
+json JsonUtil::ProgrammeToJsonObject(const Programme &programme)
 {
     json json_programme;
     json_programme.emplace("programmeID", programme.GetProgrammeId());
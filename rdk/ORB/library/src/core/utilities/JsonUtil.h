@@ -61,7 +61,7 @@ public:
 
     static std::shared_ptr<Programme> ProgrammeFromJsonObject(json jsonProgramme);
 
-    static json ProgrammeToJsonObject(Programme programme);
+    static json ProgrammeToJsonObject(const Programme &programme);
 
     // ParentalRating
 
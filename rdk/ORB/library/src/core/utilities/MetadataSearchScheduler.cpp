@@ -0,0 +1,178 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetadataSearchScheduler.h"
+#include "MetadataSearchTask.h"
+#include "ORBLogging.h"
+
+#include <algorithm>
+
+namespace orb {
+
+static
+uint64_t MicrosecondsBetween(std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+
+/**
+ * Constructor.
+ *
+ * @param workerCount      The number of worker threads
+ * @param maxRunningPerApp The number of searches each application may have running at once
+ */
+MetadataSearchScheduler::MetadataSearchScheduler(size_t workerCount, size_t maxRunningPerApp)
+    : m_workerCount(std::max<size_t>(workerCount, 1))
+    , m_maxRunningPerApp(std::max<size_t>(maxRunningPerApp, 1))
+    , m_sequence(0)
+    , m_stopping(false)
+    , m_stats{0, 0, 0, 0, 0, 0}
+{
+}
+
+/**
+ * Destructor. Searches that have not started are dropped.
+ */
+MetadataSearchScheduler::~MetadataSearchScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        for (auto &entry : m_pending)
+        {
+            entry.second.task->Stop();
+        }
+        m_pending.clear();
+    }
+    m_condition.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief MetadataSearchScheduler::Submit
+ *
+ * Queue the search task, aborting any searches the application has queued that have not
+ * started yet. The worker threads are started by the first search.
+ *
+ * @param appId      The ID of the application that started the search
+ * @param searchTask The search task
+ */
+void MetadataSearchScheduler::Submit(int appId, std::shared_ptr<MetadataSearchTask> searchTask)
+{
+    std::vector<std::shared_ptr<MetadataSearchTask> > superseded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_pending.begin(); it != m_pending.end();)
+        {
+            if (it->second.appId == appId)
+            {
+                superseded.push_back(it->second.task);
+                it = m_pending.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        m_stats.superseded += superseded.size();
+        m_pending[++m_sequence] = Pending{searchTask, appId, std::chrono::steady_clock::now()};
+        while (m_workers.size() < m_workerCount)
+        {
+            m_workers.emplace_back(&MetadataSearchScheduler::WorkerLoop, this);
+        }
+    }
+    m_condition.notify_one();
+
+    for (auto &task : superseded)
+    {
+        task->Supersede();
+    }
+}
+
+/**
+ * @brief MetadataSearchScheduler::GetStats
+ *
+ * @return The queue wait and execution times of the searches run so far
+ */
+MetadataSearchScheduler::Stats MetadataSearchScheduler::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void MetadataSearchScheduler::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        Pending pending;
+        m_condition.wait(lock, [this, &pending] {
+            return m_stopping || TakeNext(pending);
+        });
+        if (m_stopping)
+        {
+            break;
+        }
+        m_running[pending.appId]++;
+        lock.unlock();
+
+        auto started = std::chrono::steady_clock::now();
+        pending.task->Worker();
+        auto finished = std::chrono::steady_clock::now();
+        uint64_t waitUs = MicrosecondsBetween(pending.queued, started);
+        uint64_t runUs = MicrosecondsBetween(started, finished);
+        ORB_LOG("wait=%lluus run=%lluus", static_cast<unsigned long long>(waitUs),
+            static_cast<unsigned long long>(runUs));
+        pending.task.reset();
+
+        lock.lock();
+        if (--m_running[pending.appId] == 0)
+        {
+            m_running.erase(pending.appId);
+        }
+        m_stats.completed++;
+        m_stats.totalWaitUs += waitUs;
+        m_stats.maxWaitUs = std::max(m_stats.maxWaitUs, waitUs);
+        m_stats.totalRunUs += runUs;
+        m_stats.maxRunUs = std::max(m_stats.maxRunUs, runUs);
+        // A search of this application may now be allowed to run
+        m_condition.notify_all();
+    }
+}
+
+/**
+ * Take the newest queued search whose application is below its running limit. Called with
+ * the mutex held.
+ */
+bool MetadataSearchScheduler::TakeNext(Pending &pending)
+{
+    for (auto it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+        auto running = m_running.find(it->second.appId);
+        if (running == m_running.end() || running->second < m_maxRunningPerApp)
+        {
+            pending = std::move(it->second);
+            m_pending.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace orb
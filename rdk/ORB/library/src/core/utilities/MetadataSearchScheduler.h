@@ -0,0 +1,113 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orb {
+class MetadataSearchTask;
+
+/**
+ * @brief orb::MetadataSearchScheduler
+ *
+ * Runs metadata search tasks on a fixed number of worker threads. Queued searches run newest
+ * first, a new search from an application supersedes the searches it still has queued, and
+ * each application may only have a limited number of searches running at once.
+ */
+class MetadataSearchScheduler {
+public:
+
+    static const size_t DEFAULT_WORKER_COUNT = 2;
+    static const size_t DEFAULT_MAX_RUNNING_PER_APP = 1;
+
+    /**
+     * Queue wait and execution times of the searches run so far, in microseconds.
+     */
+    struct Stats
+    {
+        uint64_t completed;
+        uint64_t superseded;
+        uint64_t totalWaitUs;
+        uint64_t maxWaitUs;
+        uint64_t totalRunUs;
+        uint64_t maxRunUs;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param workerCount      The number of worker threads
+     * @param maxRunningPerApp The number of searches each application may have running at once
+     */
+    MetadataSearchScheduler(size_t workerCount = DEFAULT_WORKER_COUNT,
+        size_t maxRunningPerApp = DEFAULT_MAX_RUNNING_PER_APP);
+
+    /**
+     * Destructor. Searches that have not started are dropped.
+     */
+    ~MetadataSearchScheduler();
+
+    /**
+     * @brief MetadataSearchScheduler::Submit
+     *
+     * Queue the search task, aborting any searches the application has queued that have not
+     * started yet. The worker threads are started by the first search.
+     *
+     * @param appId      The ID of the application that started the search
+     * @param searchTask The search task
+     */
+    void Submit(int appId, std::shared_ptr<MetadataSearchTask> searchTask);
+
+    /**
+     * @brief MetadataSearchScheduler::GetStats
+     *
+     * @return The queue wait and execution times of the searches run so far
+     */
+    Stats GetStats();
+
+private:
+
+    struct Pending
+    {
+        std::shared_ptr<MetadataSearchTask> task;
+        int appId;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    void WorkerLoop();
+    bool TakeNext(Pending &pending);
+
+    size_t m_workerCount;
+    size_t m_maxRunningPerApp;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::map<uint64_t, Pending, std::greater<uint64_t> > m_pending; // Newest first
+    std::map<int, size_t> m_running; // By application
+    std::vector<std::thread> m_workers;
+    uint64_t m_sequence;
+    bool m_stopping;
+    Stats m_stats;
+}; // class MetadataSearchScheduler
+} // namespace orb
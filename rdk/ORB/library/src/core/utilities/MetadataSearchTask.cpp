@@ -16,21 +16,15 @@
 
 #include "MetadataSearchTask.h"
 #include "Channel.h"
+#include "ProgrammeIndex.h"
+#include "QueryPlan.h"
 #include "ORBEngine.h"
 #include "JsonUtil.h"
 #include "ORBLogging.h"
 
-namespace orb {
+#include <algorithm>
 
-static
-std::string ToLowerCase(std::string s)
-{
-    std::transform(s.begin(), s.end(), s.begin(),
-        [](unsigned char c){
-            return std::tolower(c);
-        });
-    return s;
-}
+namespace orb {
 
 /**
  * Constructor.
@@ -39,13 +33,23 @@ std::string ToLowerCase(std::string s)
  * @param offset             The specified offset for the search results
  * @param count              The specified count for the search results
  * @param channelConstraints The additional channel constraints
+ * @param stopAtCount        true to stop the scan once count results have been found, in
+ *                           which case totalSize is the number of matches found so far
+ * @param pageSize           If greater than 0, the results are also delivered in
+ *                           MetadataSearchPage events of this many programmes as they are found
  */
 MetadataSearchTask::MetadataSearchTask(std::shared_ptr<Query> query, int offset, int count,
-                                       std::vector<std::string> channelConstraints)
+                                       std::vector<std::string> channelConstraints,
+                                       bool stopAtCount, int pageSize)
     : m_query(query)
     , m_offset(offset)
     , m_count(count)
     , m_channelConstraints(channelConstraints)
+    , m_stopAtCount(stopAtCount)
+    , m_pageSize(pageSize)
+    , m_programmeList("[")
+    , m_resultCount(0)
+    , m_pageOffset(std::max(offset, 0))
 {
     ORB_LOG("queryId=%d", query->GetQueryId());
 }
@@ -62,61 +66,54 @@ MetadataSearchTask::~MetadataSearchTask()
  * Dispatch the MetadataSearch bridge event to the current page's JavaScript context.
  *
  * @param search        The search id
- * @param status        0 (Completed) or 3 (Aborted) or 4 (No resource found)
- * @param searchResults The list of JSON programme objects that match the search criteria
+ * @param status        0 (Completed), 3 (Aborted) or 4 (No resource found)
+ * @param programmeList The serialised JSON array of programmes that match the search
+ *                      criteria
  * @param offset        Offset value
  * @param totalSize     The total size of search
  */
 void MetadataSearchTask::OnMetadataSearchCompleted(int search, int status,
-    std::vector<std::string> searchResults, int offset, int totalSize)
+    const std::string &programmeList, int offset, int totalSize)
 {
     ORB_LOG("search=%d status=%d", search, status);
 
-    // prepare event properties and request event dispatching
-    json properties;
-    properties["search"] = search;
-    properties["status"] = status;
-    properties["offset"] = offset;
-    properties["totalSize"] = totalSize;
-
-    // use emplace to set programmeList attribute as array
-    properties.emplace("programmeList", json::array());
-    for (auto programme : searchResults)
-    {
-        // since programmeList is initialised as array, just push
-        json jsonProgramme = json::parse(programme);
-        properties["programmeList"].push_back(jsonProgramme);
-    }
+    // prepare event properties and request event dispatching, the programme list is already
+    // serialised so it is written as is
+    std::string properties = "{\"search\":" + std::to_string(search) +
+        ",\"status\":" + std::to_string(status) +
+        ",\"offset\":" + std::to_string(offset) +
+        ",\"totalSize\":" + std::to_string(totalSize) +
+        ",\"programmeList\":" + programmeList + "}";
 
-    ORBEngine::GetSharedInstance().GetEventListener()->OnJavaScriptEventDispatchRequested(
-        "MetadataSearch", properties.dump(), "", true);
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "MetadataSearch", properties, "", true);
 }
 
 /**
- * @brief Run
+ * Stop the search task thread.
  */
-void MetadataSearchTask::Start()
+void MetadataSearchTask::Stop()
 {
     ORB_LOG_NO_ARGS();
-    auto thread = std::thread(&MetadataSearchTask::Worker, shared_from_this());
-    thread.detach();
+    m_cancelled.store(true, std::memory_order_relaxed);
 }
 
 /**
- * Stop the search task thread.
+ * Abort the search because a newer search of the application replaced it before it
+ * started, dispatching the MetadataSearch bridge event with status 3 (Aborted).
  */
-void MetadataSearchTask::Stop()
+void MetadataSearchTask::Supersede()
 {
-    ORB_LOG_NO_ARGS();
-    m_cancelled.store(true, std::memory_order_relaxed);
+    ORB_LOG("queryId=%d", m_query->GetQueryId());
+    Stop();
+    ORBEngine::GetSharedInstance().RemoveMetadataSearchTask(m_query->GetQueryId(), this);
+    OnMetadataSearchCompleted(m_query->GetQueryId(), SEARCH_STATUS_ABORTED, "[]", m_offset, 0);
 }
 
 /**
  * @brief MetadataSearch::Worker
  *
- * Worker method that runs in a dedicated thread.
- *
- * @return infinite
+ * Worker method, run on a MetadataSearchScheduler thread.
  */
 void MetadataSearchTask::Worker()
 {
@@ -130,18 +127,23 @@ void MetadataSearchTask::Worker()
     struct TaskReleaser
     {
         int m_queryId;
+        const MetadataSearchTask *m_task;
 
-        explicit TaskReleaser(int mQueryId) : m_queryId(mQueryId) {}
+        TaskReleaser(int mQueryId, const MetadataSearchTask *task)
+            : m_queryId(mQueryId)
+            , m_task(task)
+        {
+        }
 
         ~TaskReleaser()
         {
             ORB_LOG("Removing search task");
-            ORBEngine::GetSharedInstance().RemoveMetadataSearchTask(m_queryId);
+            ORBEngine::GetSharedInstance().RemoveMetadataSearchTask(m_queryId, m_task);
         }
     };
 
     const auto queryId = m_query->GetQueryId();
-    const TaskReleaser taskReleaser{queryId};
+    const TaskReleaser taskReleaser{queryId, this};
 
     // Get pointer to platform implementation
     ORBPlatform *platform = ORBEngine::GetSharedInstance().GetORBPlatform();
@@ -156,256 +158,123 @@ void MetadataSearchTask::Worker()
         return;
     }
 
-    // Get channels
+    // Get the indexed programmes of the searchable channels
     ORB_LOG("Getting channels for query");
-    std::vector<Channel> channelList = platform->Broadcast_GetChannelList();
-
-    int initialOffset = m_offset;
-    int totalSize;
-
-    if (totalSize != 0)
+    ORBEngine &engine = ORBEngine::GetSharedInstance();
+    std::shared_ptr<const BroadcastCache::ChannelList> channelList =
+        engine.GetBroadcastCache()->GetChannelList(platform);
+    std::vector<ProgrammeIndex::Entry> channels = engine.GetProgrammeIndex()->GetChannels(
+        platform, channelList->channels, m_channelConstraints);
+    if(hasBeenCancelled())
     {
-        totalSize = 0;
+        return;
     }
 
-    // For each channel, if searchable, get programmes
-    for (auto channel : channelList)
+    // Compile the query once for all programmes
+    const QueryPlan plan(*m_query);
+
+    int skip = m_offset;
+    int remaining = m_count;
+    int totalSize = 0;
+
+    for (const ProgrammeIndex::Entry &channel : channels)
     {
         if(hasBeenCancelled())
         {
             return;
         }
 
-        if (channel.IsHidden())
+        // Only the candidate programmes need to be matched against the query
+        const std::vector<Programme> &programmes = channel.programmes->GetProgrammes();
+        ChannelProgrammes::Candidates candidates = channel.programmes->Find(*m_query);
+        if(hasBeenCancelled())
         {
-            continue;
+            return;
         }
-
-        // Filter out channel if channelConstraints (1) is not empty, and (2) does not include the channel's ccid
-        std::string constraint = channel.GetCcid();
-        if (!m_channelConstraints.empty())
+        for (size_t i = 0; i < programmes.size(); i++)
         {
-            if (std::find(m_channelConstraints.begin(), m_channelConstraints.end(), constraint) ==
-                m_channelConstraints.end())
+            if ((i & 0x3ff) == 0x3ff && hasBeenCancelled())
             {
-                continue;
+                return;
             }
-        }
-        std::vector<Programme> programmes = platform->Broadcast_GetProgrammes(channel.GetCcid());
-
-        // For each programme, match against query
-        for (auto programme : programmes)
-        {
-            // If programme matches add it to search results
-            if (Match(m_query, programme, channel.GetCcid()))
+            if (!candidates.positions.Test(i) ||
+                !(candidates.exact || plan.Matches(channel.programmes->GetColumns(), i)))
             {
-                totalSize++;
-                if (m_offset > 0)
-                {
-                    m_offset--;
-                }
-                else
-                {
-                    while (m_count != 0)
-                    {
-                        // Add programme to search results
-                        json jsonProgramme = JsonUtil::ProgrammeToJsonObject(programme);
-                        m_searchResults.push_back(jsonProgramme.dump());
-                        m_count--;
-                        break;
-                    }
-                }
+                continue;
             }
-        }
-    }
 
-    if(hasBeenCancelled())
-    {
-        return;
-    }
-
-    m_offset = initialOffset;
-
-    // Trigger notification
-    OnMetadataSearchCompleted(queryId, SEARCH_STATUS_COMPLETED, m_searchResults,
-                              m_offset, totalSize);
-}
-
-/**
- * @brief MetadataSearchTask::Match
- *
- * Matches the specified programme against the specified query.
- *
- * @param query     The specified query
- * @param programme The specified programme
- * @param ccid      The ID of the channel that the specified programme belongs to
- *
- * @return true if the programme matches the query, or else false
- */
-bool MetadataSearchTask::Match(
-    std::shared_ptr<Query> query,
-    Programme programme,
-    std::string ccid
-    )
-{
-    ORB_LOG("query=%s", query->ToString().c_str());
-    bool result = false;
-    switch (query->GetOperation())
-    {
-        case Query::Operation::OP_ID:
-        {
-            std::string field = query->GetField();
-            if (field == "Programme.channelID")
+            totalSize++;
+            if (skip > 0)
             {
-                result = CompareStringValues(query->GetComparison(),
-                    ccid,
-                    query->GetValue());
-                break;
+                skip--;
             }
-            else if (field == "Programme.startTime")
+            else if (remaining != 0)
             {
-                result = CompareLongValues(query->GetComparison(),
-                    programme.GetStartTime(),
-                    std::stol(query->GetValue()));
-                break;
-            }
-            else if (field == "Programme.endTime")
-            {
-                result = CompareLongValues(query->GetComparison(),
-                    programme.GetStartTime() + programme.GetDuration(),
-                    std::stol(query->GetValue()));
-                break;
-            }
-            else if (field == "Programme.name")
-            {
-                result = CompareStringValues(query->GetComparison(),
-                    programme.GetName(),
-                    query->GetValue());
-                break;
+                AddResult(programmes[i]);
+                remaining--;
+                if (m_pageSize > 0 && m_resultCount >= m_pageSize && remaining != 0)
+                {
+                    DispatchPage();
+                }
             }
-            else if (field == "Programme.programmeID")
+
+            // The scan only continues past the last result when the total is wanted
+            if (remaining == 0 && m_stopAtCount)
             {
-                result = CompareStringValues(query->GetComparison(),
-                    programme.GetProgrammeId(),
-                    query->GetValue());
                 break;
             }
-            break;
-        }
-        case Query::Operation::OP_AND:
-        {
-            result = Match(query->GetOperator1(), programme, ccid) &&
-                Match(query->GetOperator2(), programme, ccid);
-            break;
         }
-        case Query::Operation::OP_OR:
+        if (remaining == 0 && m_stopAtCount)
         {
-            result = Match(query->GetOperator1(), programme, ccid) ||
-                Match(query->GetOperator2(), programme, ccid);
             break;
         }
-        case Query::Operation::OP_NOT:
-        {
-            result = !Match(query->GetOperator1(), programme, ccid);
-            break;
-        }
-        default:
-            break;
     }
-    return result;
+
+    if(hasBeenCancelled())
+    {
+        return;
+    }
+
+    // Trigger notification, with the remaining results when they were delivered in pages
+    m_programmeList += ']';
+    OnMetadataSearchCompleted(queryId, SEARCH_STATUS_COMPLETED, m_programmeList,
+        m_pageSize > 0 ? m_pageOffset : m_offset, totalSize);
 }
 
 /**
- * @brief MetadataSearchTask::CompareStringValues
+ * @brief MetadataSearchTask::AddResult
  *
- * Compare the given programme and query string values.
+ * Append the programme to the search results being written.
  *
- * @param comparison     The comparison type
- * @param programmeValue The programme value
- * @param queryValue     The query value
- *
- * @return true if the programme and query values match, or else false
+ * @param programme The matching programme
  */
-bool MetadataSearchTask::CompareStringValues(
-    Query::Comparison comparison,
-    std::string programmeValue,
-    std::string queryValue)
+void MetadataSearchTask::AddResult(const Programme &programme)
 {
-    bool result = false;
-    programmeValue = ToLowerCase(programmeValue);
-    queryValue = ToLowerCase(queryValue);
-    switch (comparison)
+    if (m_resultCount > 0)
     {
-        case Query::Comparison::CMP_EQUAL:
-            result = (programmeValue == queryValue);
-            break;
-        case Query::Comparison::CMP_NOT_EQL:
-            result = (programmeValue != queryValue);
-            break;
-        case Query::Comparison::CMP_MORE:
-            result = (programmeValue.compare(queryValue) > 0);
-            break;
-        case Query::Comparison::CMP_MORE_EQL:
-            result = (programmeValue.compare(queryValue) >= 0);
-            break;
-        case Query::Comparison::CMP_LESS:
-            result = (programmeValue.compare(queryValue) < 0);
-            break;
-        case Query::Comparison::CMP_LESS_EQL:
-            result = (programmeValue.compare(queryValue) <= 0);
-            break;
-        case Query::Comparison::CMP_CONTAINS:
-            result = (programmeValue.find(queryValue) != std::string::npos);
-            break;
-        default:
-            break;
+        m_programmeList += ',';
     }
-    return result;
+    m_programmeList += JsonUtil::ProgrammeToJsonObject(programme).dump();
+    m_resultCount++;
 }
 
 /**
- * @brief MetadataSearchTask::CompareLongValues
+ * @brief MetadataSearchTask::DispatchPage
  *
- * Compare the given programme and query long values.
- *
- * @param comparison     The comparison type
- * @param programmeValue The programme value
- * @param queryValue     The query value
- *
- * @return true if the programme and query values match, or else false
+ * Dispatch the results written so far in a MetadataSearchPage bridge event and start a new
+ * page. The search is still running, so the event has no status or total size.
  */
-bool MetadataSearchTask::CompareLongValues(Query::Comparison comparison,
-    long programmeValue,
-    long queryValue)
+void MetadataSearchTask::DispatchPage()
 {
-    bool result = false;
-    switch (comparison)
-    {
-        case Query::Comparison::CMP_EQUAL:
-            result = (programmeValue == queryValue);
-            break;
-        case Query::Comparison::CMP_NOT_EQL:
-            result = (programmeValue != queryValue);
-            break;
-        case Query::Comparison::CMP_MORE:
-            ORB_LOG("Checking %ld > %ld", programmeValue, queryValue);
-            result = (programmeValue > queryValue);
-            break;
-        case Query::Comparison::CMP_MORE_EQL:
-            result = (programmeValue >= queryValue);
-            break;
-        case Query::Comparison::CMP_LESS:
-            result = (programmeValue < queryValue);
-            break;
-        case Query::Comparison::CMP_LESS_EQL:
-            result = (programmeValue <= queryValue);
-            break;
-        case Query::Comparison::CMP_CONTAINS:
-            result = (programmeValue == queryValue);
-            break;
-        default:
-            break;
-    }
-    return result;
+    m_programmeList += ']';
+    std::string properties = "{\"search\":" + std::to_string(m_query->GetQueryId()) +
+        ",\"offset\":" + std::to_string(m_pageOffset) +
+        ",\"programmeList\":" + m_programmeList + "}";
+    ORBEngine::GetSharedInstance().GetJavaScriptEventQueue()->Post(
+        "MetadataSearchPage", properties, "", true);
+
+    m_programmeList = "[";
+    m_pageOffset += m_resultCount;
+    m_resultCount = 0;
 }
 } // namespace orb
@@ -21,7 +21,6 @@
 #include <vector>
 #include "Programme.h"
 #include "Query.h"
-#include <thread>
 #include <atomic>
 
 // Supported search status values
@@ -46,9 +45,15 @@ public:
      * @param offset             The specified offset for the search results
      * @param count              The specified count for the search results
      * @param channelConstraints The additional channel constraints
+     * @param stopAtCount        true to stop the scan once count results have been found, in
+     *                           which case totalSize is the number of matches found so far
+     * @param pageSize           If greater than 0, the results are also delivered in
+     *                           MetadataSearchPage events of this many programmes as they are
+     *                           found, and the final MetadataSearch event only carries the
+     *                           last page
      */
     MetadataSearchTask(std::shared_ptr<Query> query, int offset, int count,
-        std::vector<std::string> channelConstraints);
+        std::vector<std::string> channelConstraints, bool stopAtCount = false, int pageSize = 0);
 
     /**
      * Destructor.
@@ -59,81 +64,62 @@ public:
      * Dispatch the MetadataSearch bridge event to the current page's JavaScript context.
      *
      * @param search        The search id
-     * @param status        0 (Completed) or 3 (Aborted) or 4 (No resource found)
-     * @param searchResults The list of JSON programme objects that match the search criteria
+     * @param status        0 (Completed), 3 (Aborted) or 4 (No resource found)
+     * @param programmeList The serialised JSON array of programmes that match the search
+     *                      criteria
      * @param offset        Offset value
      * @param totalSize     The total size of search
      */
     static void OnMetadataSearchCompleted(int search, int status,
-        std::vector<std::string> searchResults, int offset, int totalSize);
+        const std::string &programmeList, int offset, int totalSize);
 
     /**
      * @brief MetadataSearch::Worker
      *
-     * Worker method that runs in a dedicated thread.
-     *
-     * @return infinite
+     * Worker method, run on a MetadataSearchScheduler thread.
      */
     void Worker();
 
-    /**
-     * Start the search task thread.
-     */
-    void Start();
-
     /**
      * Stop the search task thread.
      */
     void Stop();
 
-private:
-
     /**
-     * @brief MetadataSearchTask::Match
-     *
-     * Matches the specified programme against the specified query.
-     *
-     * @param query     The specified query
-     * @param programme The specified programme
-     * @param ccid      The ID of the channel that the specified programme belongs to
-     *
-     * @return true if the programme matches the query, or else false
+     * Abort the search because a newer search of the application replaced it before it
+     * started, dispatching the MetadataSearch bridge event with status 3 (Aborted).
      */
-    bool Match(std::shared_ptr<Query> query, Programme programme, std::string ccid);
+    void Supersede();
+
+private:
 
     /**
-     * @brief MetadataSearchTask::CompareStringValues
+     * @brief MetadataSearchTask::AddResult
      *
-     * Compare the given programme and query string values.
+     * Append the programme to the search results being written.
      *
-     * @param comparison     The comparison type
-     * @param programmeValue The programme value
-     * @param queryValue     The query value
-     *
-     * @return true if the programme and query values match, or else false
+     * @param programme The matching programme
      */
-    bool CompareStringValues(Query::Comparison comparison, std::string programmeValue, std::string
-        queryValue);
+    void AddResult(const Programme &programme);
 
     /**
-     * @brief MetadataSearchTask::CompareLongValues
-     *
-     * Compare the given programme and query long values.
-     *
-     * @param comparison     The comparison type
-     * @param programmeValue The programme value
-     * @param queryValue     The query value
+     * @brief MetadataSearchTask::DispatchPage
      *
-     * @return true if the programme and query values match, or else false
+     * Dispatch the results written so far in a MetadataSearchPage bridge event and start a
+     * new page.
      */
-    bool CompareLongValues(Query::Comparison comparison, long programmeValue, long queryValue);
+    void DispatchPage();
 
     // member variables
     std::shared_ptr<Query> m_query;
     int m_offset;
     int m_count;
     std::vector<std::string> m_channelConstraints;
-    std::vector<std::string> m_searchResults;
+    bool m_stopAtCount;
+    int m_pageSize;
+    std::string m_programmeList; // Serialised JSON array, without the closing bracket
+    int m_resultCount; // Results in m_programmeList
+    int m_pageOffset; // Offset of the first result in m_programmeList
     std::atomic<bool> m_cancelled{false};
 }; // class MetadataSearchTask
 } // namespace orb
@@ -0,0 +1,438 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProgrammeIndex.h"
+#include "ORBPlatform.h"
+#include "ORBLogging.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+namespace orb {
+
+static
+uint32_t Trigram(const std::string &s, size_t pos)
+{
+    return (uint32_t(uint8_t(s[pos])) << 16) | (uint32_t(uint8_t(s[pos + 1])) << 8) |
+           uint32_t(uint8_t(s[pos + 2]));
+}
+
+/**
+ * Constructor.
+ *
+ * @param size The number of positions
+ * @param full true to start with every position in the set, or else false
+ */
+PositionSet::PositionSet(size_t size, bool full)
+    : m_size(size)
+    , m_words((size + 63) / 64, full ? ~uint64_t(0) : 0)
+{
+    ClearUnused();
+}
+
+void PositionSet::Intersect(const PositionSet &other)
+{
+    for (size_t i = 0; i < m_words.size(); i++)
+    {
+        m_words[i] &= other.m_words[i];
+    }
+}
+
+void PositionSet::Unite(const PositionSet &other)
+{
+    for (size_t i = 0; i < m_words.size(); i++)
+    {
+        m_words[i] |= other.m_words[i];
+    }
+}
+
+void PositionSet::Complement()
+{
+    for (auto &word : m_words)
+    {
+        word = ~word;
+    }
+    ClearUnused();
+}
+
+void PositionSet::ClearUnused()
+{
+    if ((m_size & 63) != 0)
+    {
+        m_words.back() &= (uint64_t(1) << (m_size & 63)) - 1;
+    }
+}
+
+/**
+ * Constructor.
+ *
+ * @param ccid       The ID of the channel
+ * @param programmes The programmes of the channel
+ */
+ChannelProgrammes::ChannelProgrammes(std::string ccid, std::vector<Programme> programmes)
+    : m_ccid(ccid)
+    , m_programmes(std::move(programmes))
+    , m_columns(m_ccid, m_programmes)
+{
+    const size_t count = m_programmes.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        m_programmeIdIndex[m_columns.lowerProgrammeIds[i]].push_back(i);
+
+        const std::string &name = m_columns.lowerNames[i];
+        for (size_t j = 0; j + 3 <= name.size(); j++)
+        {
+            std::vector<uint32_t> &postings = m_nameTrigramIndex[Trigram(name, j)];
+            if (postings.empty() || postings.back() != i)
+            {
+                postings.push_back(i);
+            }
+        }
+    }
+
+    const std::vector<int64_t> &startTimes = m_columns.startTimes;
+    const std::vector<int64_t> &endTimes = m_columns.endTimes;
+    m_startOrder.resize(count);
+    std::iota(m_startOrder.begin(), m_startOrder.end(), 0);
+    std::stable_sort(m_startOrder.begin(), m_startOrder.end(),
+        [&startTimes](uint32_t a, uint32_t b) {
+            return startTimes[a] < startTimes[b];
+        });
+    m_endOrder.resize(count);
+    std::iota(m_endOrder.begin(), m_endOrder.end(), 0);
+    std::stable_sort(m_endOrder.begin(), m_endOrder.end(),
+        [&endTimes](uint32_t a, uint32_t b) {
+            return endTimes[a] < endTimes[b];
+        });
+    m_sortedStartTimes.reserve(count);
+    m_sortedEndTimes.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        m_sortedStartTimes.push_back(startTimes[m_startOrder[i]]);
+        m_sortedEndTimes.push_back(endTimes[m_endOrder[i]]);
+    }
+}
+
+/**
+ * @brief ChannelProgrammes::Find
+ *
+ * Find the programmes that may match the query, using the indexes wherever the AND/OR/NOT
+ * tree of the query allows it.
+ *
+ * @param query The query
+ *
+ * @return The candidate positions
+ */
+ChannelProgrammes::Candidates ChannelProgrammes::Find(const Query &query) const
+{
+    const size_t count = m_programmes.size();
+    switch (query.GetOperation())
+    {
+        case Query::Operation::OP_ID:
+        {
+            return FindField(query);
+        }
+        case Query::Operation::OP_AND:
+        case Query::Operation::OP_OR:
+        {
+            std::shared_ptr<Query> operator1 = query.GetOperator1();
+            std::shared_ptr<Query> operator2 = query.GetOperator2();
+            if (!operator1 || !operator2)
+            {
+                break;
+            }
+            Candidates result = Find(*operator1);
+            Candidates other = Find(*operator2);
+            if (query.GetOperation() == Query::Operation::OP_AND)
+            {
+                result.positions.Intersect(other.positions);
+            }
+            else
+            {
+                result.positions.Unite(other.positions);
+            }
+            result.exact = result.exact && other.exact;
+            return result;
+        }
+        case Query::Operation::OP_NOT:
+        {
+            std::shared_ptr<Query> operator1 = query.GetOperator1();
+            if (!operator1)
+            {
+                break;
+            }
+            Candidates result = Find(*operator1);
+            if (!result.exact)
+            {
+                // Any programme may match
+                return Candidates{PositionSet(count, true), false};
+            }
+            result.positions.Complement();
+            return result;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    // Matches nothing, as QueryPlan compiles it
+    return Candidates{PositionSet(count, false), true};
+}
+
+ChannelProgrammes::Candidates ChannelProgrammes::FindField(const Query &query) const
+{
+    const size_t count = m_programmes.size();
+    const std::string field = query.GetField();
+    const Query::Comparison comparison = query.GetComparison();
+
+    if (field == "Programme.channelID")
+    {
+        bool match = QueryPlan::CompareStrings(comparison, m_columns.lowerCcid,
+            QueryPlan::ToLowerCase(query.GetValue()));
+        return Candidates{PositionSet(count, match), true};
+    }
+    if (field == "Programme.startTime" || field == "Programme.endTime")
+    {
+        int64_t value;
+        try
+        {
+            value = std::stoll(query.GetValue());
+        }
+        catch (const std::exception &)
+        {
+            return Candidates{PositionSet(count, false), true};
+        }
+        if (field == "Programme.startTime")
+        {
+            return Candidates{FindTime(m_sortedStartTimes, m_startOrder, comparison, value), true};
+        }
+        return Candidates{FindTime(m_sortedEndTimes, m_endOrder, comparison, value), true};
+    }
+    if (field == "Programme.name")
+    {
+        return FindName(comparison, QueryPlan::ToLowerCase(query.GetValue()));
+    }
+    if (field == "Programme.programmeID")
+    {
+        return FindProgrammeId(comparison, QueryPlan::ToLowerCase(query.GetValue()));
+    }
+    return Candidates{PositionSet(count, false), true};
+}
+
+PositionSet ChannelProgrammes::FindTime(const std::vector<int64_t> &sortedTimes,
+    const std::vector<uint32_t> &order, Query::Comparison comparison, int64_t value) const
+{
+    const size_t lower = std::lower_bound(sortedTimes.begin(), sortedTimes.end(), value) -
+        sortedTimes.begin();
+    const size_t upper = std::upper_bound(sortedTimes.begin(), sortedTimes.end(), value) -
+        sortedTimes.begin();
+    size_t first = 0;
+    size_t last = 0;
+    bool complement = false;
+
+    switch (comparison)
+    {
+        case Query::Comparison::CMP_EQUAL:
+        case Query::Comparison::CMP_CONTAINS:
+            first = lower;
+            last = upper;
+            break;
+        case Query::Comparison::CMP_NOT_EQL:
+            first = lower;
+            last = upper;
+            complement = true;
+            break;
+        case Query::Comparison::CMP_MORE:
+            first = upper;
+            last = sortedTimes.size();
+            break;
+        case Query::Comparison::CMP_MORE_EQL:
+            first = lower;
+            last = sortedTimes.size();
+            break;
+        case Query::Comparison::CMP_LESS:
+            last = lower;
+            break;
+        case Query::Comparison::CMP_LESS_EQL:
+            last = upper;
+            break;
+        default:
+            break;
+    }
+
+    PositionSet result(m_programmes.size(), false);
+    for (size_t i = first; i < last; i++)
+    {
+        result.Set(order[i]);
+    }
+    if (complement)
+    {
+        result.Complement();
+    }
+    return result;
+}
+
+ChannelProgrammes::Candidates ChannelProgrammes::FindProgrammeId(Query::Comparison comparison,
+    const std::string &value) const
+{
+    if (comparison != Query::Comparison::CMP_EQUAL && comparison != Query::Comparison::CMP_NOT_EQL)
+    {
+        // Left to the query plan
+        return Candidates{PositionSet(m_programmes.size(), true), false};
+    }
+
+    PositionSet result(m_programmes.size(), false);
+    auto it = m_programmeIdIndex.find(value);
+    if (it != m_programmeIdIndex.end())
+    {
+        for (uint32_t pos : it->second)
+        {
+            result.Set(pos);
+        }
+    }
+    if (comparison == Query::Comparison::CMP_NOT_EQL)
+    {
+        result.Complement();
+    }
+    return Candidates{result, true};
+}
+
+ChannelProgrammes::Candidates ChannelProgrammes::FindName(Query::Comparison comparison,
+    const std::string &value) const
+{
+    if ((comparison != Query::Comparison::CMP_CONTAINS &&
+         comparison != Query::Comparison::CMP_EQUAL) || value.size() < 3)
+    {
+        // Left to the query plan
+        return Candidates{PositionSet(m_programmes.size(), true), false};
+    }
+
+    // Every matching name contains every 3 byte sequence of the value, so only the names in
+    // the shortest of their position lists need to be compared
+    const std::vector<uint32_t> *shortest = nullptr;
+    for (size_t i = 0; i + 3 <= value.size(); i++)
+    {
+        auto it = m_nameTrigramIndex.find(Trigram(value, i));
+        if (it == m_nameTrigramIndex.end())
+        {
+            return Candidates{PositionSet(m_programmes.size(), false), true};
+        }
+        if (shortest == nullptr || it->second.size() < shortest->size())
+        {
+            shortest = &it->second;
+        }
+    }
+
+    PositionSet result(m_programmes.size(), false);
+    for (uint32_t pos : *shortest)
+    {
+        if (QueryPlan::CompareStrings(comparison, m_columns.lowerNames[pos], value))
+        {
+            result.Set(pos);
+        }
+    }
+    return Candidates{result, true};
+}
+
+/**
+ * Constructor.
+ */
+ProgrammeIndex::ProgrammeIndex()
+    : m_version(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+ProgrammeIndex::~ProgrammeIndex()
+{
+}
+
+/**
+ * @brief ProgrammeIndex::GetChannels
+ *
+ * Get the indexed programmes of the searchable channels, in channel list order. Channels
+ * that have not been indexed since the programmes last changed are indexed first.
+ *
+ * @param platform           The platform to get programmes from
+ * @param channelList        The channel list
+ * @param channelConstraints If not empty, the ccids of the channels to include
+ *
+ * @return The channels
+ */
+std::vector<ProgrammeIndex::Entry> ProgrammeIndex::GetChannels(ORBPlatform *platform,
+    const std::vector<Channel> &channelList, const std::vector<std::string> &channelConstraints)
+{
+    std::vector<Entry> result;
+    std::unordered_set<std::string> listed;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t version = m_version.load();
+    for (const Channel &channel : channelList)
+    {
+        const std::string ccid = channel.GetCcid();
+        listed.insert(ccid);
+        if (channel.IsHidden())
+        {
+            continue;
+        }
+        // Filter out channel if channelConstraints (1) is not empty, and (2) does not include the channel's ccid
+        if (!channelConstraints.empty() &&
+            std::find(channelConstraints.begin(), channelConstraints.end(), ccid) ==
+            channelConstraints.end())
+        {
+            continue;
+        }
+
+        Indexed &indexed = m_channels[ccid];
+        if (!indexed.programmes || indexed.version != version)
+        {
+            indexed.programmes = std::make_shared<const ChannelProgrammes>(ccid,
+                platform->Broadcast_GetProgrammes(ccid));
+            indexed.version = version;
+        }
+        result.push_back(Entry{ccid, indexed.programmes});
+    }
+
+    // Forget channels that have been removed from the list
+    for (auto it = m_channels.begin(); it != m_channels.end();)
+    {
+        if (listed.count(it->first) == 0)
+        {
+            it = m_channels.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief ProgrammeIndex::Invalidate
+ *
+ * Mark the indexed programmes of every channel as out of date.
+ */
+void ProgrammeIndex::Invalidate()
+{
+    ORB_LOG_NO_ARGS();
+    m_version++;
+}
+} // namespace orb
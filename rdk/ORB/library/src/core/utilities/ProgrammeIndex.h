@@ -0,0 +1,215 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Channel.h"
+#include "Programme.h"
+#include "Query.h"
+#include "QueryPlan.h"
+
+class ORBPlatform;
+
+namespace orb {
+/**
+ * @brief orb::PositionSet
+ *
+ * A set of programme positions within a channel, stored as a bitset.
+ */
+class PositionSet {
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param size The number of positions
+     * @param full true to start with every position in the set, or else false
+     */
+    PositionSet(size_t size, bool full);
+
+    void Set(size_t pos)
+    {
+        m_words[pos >> 6] |= (uint64_t(1) << (pos & 63));
+    }
+
+    bool Test(size_t pos) const
+    {
+        return (m_words[pos >> 6] >> (pos & 63)) & 1;
+    }
+
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    void Intersect(const PositionSet &other);
+    void Unite(const PositionSet &other);
+    void Complement();
+
+private:
+
+    void ClearUnused();
+
+    size_t m_size;
+    std::vector<uint64_t> m_words;
+}; // class PositionSet
+
+/**
+ * @brief orb::ChannelProgrammes
+ *
+ * The programmes of one channel, as returned by the platform, with the indexes used to answer
+ * metadata queries. Immutable once constructed, so it can be shared by concurrent searches.
+ */
+class ChannelProgrammes {
+public:
+
+    /**
+     * The positions of the programmes that may match a query. If exact is true every position
+     * matches, or else each must still be checked against the query.
+     */
+    struct Candidates
+    {
+        PositionSet positions;
+        bool exact;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param ccid       The ID of the channel
+     * @param programmes The programmes of the channel
+     */
+    ChannelProgrammes(std::string ccid, std::vector<Programme> programmes);
+
+    const std::string& GetCcid() const
+    {
+        return m_ccid;
+    }
+
+    const std::vector<Programme>& GetProgrammes() const
+    {
+        return m_programmes;
+    }
+
+    const ProgrammeColumns& GetColumns() const
+    {
+        return m_columns;
+    }
+
+    /**
+     * @brief ChannelProgrammes::Find
+     *
+     * Find the programmes that may match the query, using the indexes wherever the AND/OR/NOT
+     * tree of the query allows it. Inexact candidates are checked with the QueryPlan of the
+     * query.
+     *
+     * @param query The query
+     *
+     * @return The candidate positions
+     */
+    Candidates Find(const Query &query) const;
+
+private:
+
+    Candidates FindField(const Query &query) const;
+    PositionSet FindTime(const std::vector<int64_t> &sortedTimes,
+        const std::vector<uint32_t> &order, Query::Comparison comparison, int64_t value) const;
+    Candidates FindProgrammeId(Query::Comparison comparison, const std::string &value) const;
+    Candidates FindName(Query::Comparison comparison, const std::string &value) const;
+
+    std::string m_ccid;
+    std::vector<Programme> m_programmes;
+    ProgrammeColumns m_columns;
+
+    // Start and end times in ascending order, with the position of each
+    std::vector<int64_t> m_sortedStartTimes;
+    std::vector<uint32_t> m_startOrder;
+    std::vector<int64_t> m_sortedEndTimes;
+    std::vector<uint32_t> m_endOrder;
+
+    // Positions by lowercase programme ID, and by each 3 byte sequence of the lowercase name
+    std::unordered_map<std::string, std::vector<uint32_t> > m_programmeIdIndex;
+    std::unordered_map<uint32_t, std::vector<uint32_t> > m_nameTrigramIndex;
+}; // class ChannelProgrammes
+
+/**
+ * @brief orb::ProgrammeIndex
+ *
+ * In-process index of the EPG used by metadata searches. The programmes of a channel are
+ * fetched from the platform and indexed the first time a search needs them, and again after
+ * OnProgrammesChanged, instead of on every search.
+ */
+class ProgrammeIndex {
+public:
+
+    struct Entry
+    {
+        std::string ccid;
+        std::shared_ptr<const ChannelProgrammes> programmes;
+    };
+
+    /**
+     * Constructor.
+     */
+    ProgrammeIndex();
+
+    /**
+     * Destructor.
+     */
+    ~ProgrammeIndex();
+
+    /**
+     * @brief ProgrammeIndex::GetChannels
+     *
+     * Get the indexed programmes of the searchable channels, in channel list order. Channels
+     * that have not been indexed since the programmes last changed are indexed first.
+     *
+     * @param platform           The platform to get programmes from
+     * @param channelList        The channel list
+     * @param channelConstraints If not empty, the ccids of the channels to include
+     *
+     * @return The channels
+     */
+    std::vector<Entry> GetChannels(ORBPlatform *platform, const std::vector<Channel> &channelList,
+        const std::vector<std::string> &channelConstraints);
+
+    /**
+     * @brief ProgrammeIndex::Invalidate
+     *
+     * Mark the indexed programmes of every channel as out of date.
+     */
+    void Invalidate();
+
+private:
+
+    struct Indexed
+    {
+        std::shared_ptr<const ChannelProgrammes> programmes;
+        uint32_t version;
+    };
+
+    std::mutex m_mutex; // Held while channels are indexed
+    std::unordered_map<std::string, Indexed> m_channels;
+    std::atomic<uint32_t> m_version;
+}; // class ProgrammeIndex
+} // namespace orb
@@ -0,0 +1,275 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryPlan.h"
+#include "ORBLogging.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace orb {
+
+static
+bool CompareNumbers(Query::Comparison comparison, int64_t programmeValue, int64_t queryValue)
+{
+    switch (comparison)
+    {
+        case Query::Comparison::CMP_EQUAL:
+        case Query::Comparison::CMP_CONTAINS:
+            return programmeValue == queryValue;
+        case Query::Comparison::CMP_NOT_EQL:
+            return programmeValue != queryValue;
+        case Query::Comparison::CMP_MORE:
+            return programmeValue > queryValue;
+        case Query::Comparison::CMP_MORE_EQL:
+            return programmeValue >= queryValue;
+        case Query::Comparison::CMP_LESS:
+            return programmeValue < queryValue;
+        case Query::Comparison::CMP_LESS_EQL:
+            return programmeValue <= queryValue;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief QueryPlan::ToLowerCase
+ *
+ * @param s The string
+ *
+ * @return The string with ASCII letters in lowercase
+ */
+std::string QueryPlan::ToLowerCase(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(),
+        [](unsigned char c){
+            return std::tolower(c);
+        });
+    return s;
+}
+
+/**
+ * @brief QueryPlan::CompareStrings
+ *
+ * @param comparison     The comparison
+ * @param programmeValue The lowercase value of the programme field
+ * @param queryValue     The lowercase value of the query
+ *
+ * @return true if the comparison holds, or else false
+ */
+bool QueryPlan::CompareStrings(Query::Comparison comparison, const std::string &programmeValue,
+    const std::string &queryValue)
+{
+    switch (comparison)
+    {
+        case Query::Comparison::CMP_EQUAL:
+            return programmeValue == queryValue;
+        case Query::Comparison::CMP_NOT_EQL:
+            return programmeValue != queryValue;
+        case Query::Comparison::CMP_MORE:
+            return programmeValue.compare(queryValue) > 0;
+        case Query::Comparison::CMP_MORE_EQL:
+            return programmeValue.compare(queryValue) >= 0;
+        case Query::Comparison::CMP_LESS:
+            return programmeValue.compare(queryValue) < 0;
+        case Query::Comparison::CMP_LESS_EQL:
+            return programmeValue.compare(queryValue) <= 0;
+        case Query::Comparison::CMP_CONTAINS:
+            return programmeValue.find(queryValue) != std::string::npos;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Constructor.
+ *
+ * @param ccid       The ID of the channel
+ * @param programmes The programmes of the channel
+ */
+ProgrammeColumns::ProgrammeColumns(const std::string &ccid,
+    const std::vector<Programme> &programmes)
+    : lowerCcid(QueryPlan::ToLowerCase(ccid))
+{
+    startTimes.reserve(programmes.size());
+    endTimes.reserve(programmes.size());
+    lowerNames.reserve(programmes.size());
+    lowerProgrammeIds.reserve(programmes.size());
+    for (const Programme &programme : programmes)
+    {
+        startTimes.push_back(programme.GetStartTime());
+        endTimes.push_back(programme.GetStartTime() + programme.GetDuration());
+        lowerNames.push_back(QueryPlan::ToLowerCase(programme.GetName()));
+        lowerProgrammeIds.push_back(QueryPlan::ToLowerCase(programme.GetProgrammeId()));
+    }
+}
+
+/**
+ * Constructor.
+ *
+ * Compile the query. Comparisons on unknown fields, or on times that are not numbers,
+ * match no programme.
+ *
+ * @param query The query
+ */
+QueryPlan::QueryPlan(const Query &query)
+{
+    Compile(&query);
+}
+
+/**
+ * @brief QueryPlan::Matches
+ *
+ * Matches the programme at the specified position against the compiled query.
+ *
+ * @param columns  The programmes of a channel
+ * @param position The position of the programme within the columns
+ *
+ * @return true if the programme matches the query, or else false
+ */
+bool QueryPlan::Matches(const ProgrammeColumns &columns, size_t position) const
+{
+    bool result = false;
+    size_t pc = 0;
+    while (pc < m_program.size())
+    {
+        const Instruction &instruction = m_program[pc++];
+        switch (instruction.opcode)
+        {
+            case OPCODE_FALSE:
+                result = false;
+                break;
+            case OPCODE_TEST_CHANNEL_ID:
+                result = CompareStrings(instruction.comparison, columns.lowerCcid,
+                    instruction.text);
+                break;
+            case OPCODE_TEST_START_TIME:
+                result = CompareNumbers(instruction.comparison, columns.startTimes[position],
+                    instruction.number);
+                break;
+            case OPCODE_TEST_END_TIME:
+                result = CompareNumbers(instruction.comparison, columns.endTimes[position],
+                    instruction.number);
+                break;
+            case OPCODE_TEST_NAME:
+                result = CompareStrings(instruction.comparison, columns.lowerNames[position],
+                    instruction.text);
+                break;
+            case OPCODE_TEST_PROGRAMME_ID:
+                result = CompareStrings(instruction.comparison,
+                    columns.lowerProgrammeIds[position], instruction.text);
+                break;
+            case OPCODE_NOT:
+                result = !result;
+                break;
+            case OPCODE_JUMP_IF_FALSE:
+                if (!result)
+                {
+                    pc = instruction.target;
+                }
+                break;
+            case OPCODE_JUMP_IF_TRUE:
+                if (result)
+                {
+                    pc = instruction.target;
+                }
+                break;
+        }
+    }
+    return result;
+}
+
+/**
+ * Append the instructions for the query. Each leaves the result of its subtree in the result
+ * register, so AND and OR jump past their second operand when the first decides the result.
+ */
+void QueryPlan::Compile(const Query *query)
+{
+    if (query == nullptr)
+    {
+        m_program.push_back(Instruction{OPCODE_FALSE, Query::Comparison::CMP_INVALID, 0, "", 0});
+        return;
+    }
+    switch (query->GetOperation())
+    {
+        case Query::Operation::OP_ID:
+        {
+            CompileIdentity(*query);
+            break;
+        }
+        case Query::Operation::OP_AND:
+        case Query::Operation::OP_OR:
+        {
+            Compile(query->GetOperator1().get());
+            size_t jump = m_program.size();
+            m_program.push_back(Instruction{query->GetOperation() == Query::Operation::OP_AND ?
+                                            OPCODE_JUMP_IF_FALSE : OPCODE_JUMP_IF_TRUE,
+                                            Query::Comparison::CMP_INVALID, 0, "", 0});
+            Compile(query->GetOperator2().get());
+            m_program[jump].target = m_program.size();
+            break;
+        }
+        case Query::Operation::OP_NOT:
+        {
+            Compile(query->GetOperator1().get());
+            m_program.push_back(Instruction{OPCODE_NOT, Query::Comparison::CMP_INVALID, 0, "", 0});
+            break;
+        }
+        default:
+        {
+            m_program.push_back(Instruction{OPCODE_FALSE, Query::Comparison::CMP_INVALID, 0, "",
+                                            0});
+            break;
+        }
+    }
+}
+
+void QueryPlan::CompileIdentity(const Query &query)
+{
+    const std::string field = query.GetField();
+    Instruction instruction{OPCODE_FALSE, query.GetComparison(), 0, "", 0};
+
+    if (field == "Programme.channelID")
+    {
+        instruction.opcode = OPCODE_TEST_CHANNEL_ID;
+        instruction.text = ToLowerCase(query.GetValue());
+    }
+    else if (field == "Programme.startTime" || field == "Programme.endTime")
+    {
+        try
+        {
+            instruction.number = std::stoll(query.GetValue());
+            instruction.opcode = (field == "Programme.startTime") ?
+                OPCODE_TEST_START_TIME : OPCODE_TEST_END_TIME;
+        }
+        catch (const std::exception &)
+        {
+            ORB_LOG("Invalid time value %s", query.GetValue().c_str());
+        }
+    }
+    else if (field == "Programme.name")
+    {
+        instruction.opcode = OPCODE_TEST_NAME;
+        instruction.text = ToLowerCase(query.GetValue());
+    }
+    else if (field == "Programme.programmeID")
+    {
+        instruction.opcode = OPCODE_TEST_PROGRAMME_ID;
+        instruction.text = ToLowerCase(query.GetValue());
+    }
+    m_program.push_back(instruction);
+}
+} // namespace orb
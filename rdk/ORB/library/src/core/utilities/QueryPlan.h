@@ -0,0 +1,137 @@
+/**
+ * ORB Software. Copyright (c) 2025 Ocean Blue Software Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Programme.h"
+#include "Query.h"
+
+namespace orb {
+/**
+ * @brief orb::ProgrammeColumns
+ *
+ * The searchable fields of the programmes of one channel, one column per field, with string
+ * values lowercased as queries compare them case-insensitively.
+ */
+struct ProgrammeColumns
+{
+    /**
+     * Constructor.
+     *
+     * @param ccid       The ID of the channel
+     * @param programmes The programmes of the channel
+     */
+    ProgrammeColumns(const std::string &ccid, const std::vector<Programme> &programmes);
+
+    size_t Size() const
+    {
+        return startTimes.size();
+    }
+
+    std::string lowerCcid;
+    std::vector<int64_t> startTimes;
+    std::vector<int64_t> endTimes;
+    std::vector<std::string> lowerNames;
+    std::vector<std::string> lowerProgrammeIds;
+}; // struct ProgrammeColumns
+
+/**
+ * @brief orb::QueryPlan
+ *
+ * A Query compiled into a flat program of typed predicates and short-circuit jumps, so that
+ * matching a programme does no field name comparisons, value parsing or tree recursion.
+ */
+class QueryPlan {
+public:
+
+    /**
+     * Constructor.
+     *
+     * Compile the query. Comparisons on unknown fields, or on times that are not numbers,
+     * match no programme.
+     *
+     * @param query The query
+     */
+    explicit QueryPlan(const Query &query);
+
+    /**
+     * @brief QueryPlan::Matches
+     *
+     * Matches the programme at the specified position against the compiled query.
+     *
+     * @param columns  The programmes of a channel
+     * @param position The position of the programme within the columns
+     *
+     * @return true if the programme matches the query, or else false
+     */
+    bool Matches(const ProgrammeColumns &columns, size_t position) const;
+
+    /**
+     * @brief QueryPlan::ToLowerCase
+     *
+     * @param s The string
+     *
+     * @return The string with ASCII letters in lowercase
+     */
+    static std::string ToLowerCase(std::string s);
+
+    /**
+     * @brief QueryPlan::CompareStrings
+     *
+     * Compares lowercase strings as queries compare them.
+     *
+     * @param comparison     The comparison
+     * @param programmeValue The lowercase value of the programme field
+     * @param queryValue     The lowercase value of the query
+     *
+     * @return true if the comparison holds, or else false
+     */
+    static bool CompareStrings(Query::Comparison comparison, const std::string &programmeValue,
+        const std::string &queryValue);
+
+private:
+
+    enum Opcode
+    {
+        OPCODE_FALSE,
+        OPCODE_TEST_CHANNEL_ID,
+        OPCODE_TEST_START_TIME,
+        OPCODE_TEST_END_TIME,
+        OPCODE_TEST_NAME,
+        OPCODE_TEST_PROGRAMME_ID,
+        OPCODE_NOT,
+        OPCODE_JUMP_IF_FALSE,
+        OPCODE_JUMP_IF_TRUE
+    };
+
+    struct Instruction
+    {
+        Opcode opcode;
+        Query::Comparison comparison;
+        int64_t number; // Time operand
+        std::string text; // Lowercase string operand
+        size_t target; // Jump target
+    };
+
+    void Compile(const Query *query);
+    void CompileIdentity(const Query &query);
+
+    std::vector<Instruction> m_program;
+}; // class QueryPlan
+} // namespace orb
@@ -15,9 +15,17 @@
  */
 
 #include "SHA256.h"
+#include "CpuFeatures.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #define uchar unsigned char
 #define uint unsigned int
 
@@ -33,15 +41,18 @@
 #define SIG1(x) (ROTRIGHT(x, 17) ^ ROTRIGHT(x, 19) ^ ((x) >> 10))
 
 
+typedef void (*TransformFunction)(uint state[8], const uchar *data, size_t blocks);
+
 typedef struct
 {
     uchar data[64];
     uint datalen;
     uint bitlen[2];
     uint state[8];
+    TransformFunction transform;
 } SHA256_CTX;
 
-uint k[64] = {
+static const uint k[64] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
     0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
     0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
@@ -53,46 +64,158 @@ uint k[64] = {
 };
 
 static
-void SHA256Transform(SHA256_CTX *ctx, uchar data[])
+void SHA256TransformScalar(uint state[8], const uchar *data, size_t blocks)
 {
     uint a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
 
-    for (i = 0, j = 0; i < 16; ++i, j += 4)
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-    for (; i < 64; ++i)
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
-
-    a = ctx->state[0];
-    b = ctx->state[1];
-    c = ctx->state[2];
-    d = ctx->state[3];
-    e = ctx->state[4];
-    f = ctx->state[5];
-    g = ctx->state[6];
-    h = ctx->state[7];
-
-    for (i = 0; i < 64; ++i)
+    for (; blocks > 0; blocks--, data += 64)
+    {
+        for (i = 0, j = 0; i < 16; ++i, j += 4)
+            m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+        for (; i < 64; ++i)
+            m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        for (i = 0; i < 64; ++i)
+        {
+            t1 = h + EP1(e) + CH(e, f, g) + k[i] + m[i];
+            t2 = EP0(a) + MAJ(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * SHA256 extensions (SHA-NI). Each sha256rnds2 performs two rounds on the state held as
+ * ABEF/CDGH, and sha256msg1/sha256msg2 compute the message schedule four words at a time.
+ */
+__attribute__((target("sha,sse4.1")))
+static
+void SHA256TransformShaNi(uint state[8], const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[0]), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[4]), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+    for (; blocks > 0; blocks--, data += 64)
+    {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++)
+        {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 16 * i)),
+                byteSwap);
+        }
+        for (int i = 0; i < 16; i++)
+        {
+            __m128i wk = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i *) &k[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            if (i < 12)
+            {
+                msg[i & 3] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+                    _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4)),
+                    msg[(i + 3) & 3]);
+            }
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+        }
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+    _mm_storeu_si128((__m128i *) &state[0], _mm_blend_epi16(tmp, state1, 0xF0)); // DCBA
+    _mm_storeu_si128((__m128i *) &state[4], _mm_alignr_epi8(state1, tmp, 8)); // HGFE
+}
+#endif
+
+#if defined(__aarch64__)
+/**
+ * ARMv8 cryptography extensions. Each sha256h/sha256h2 pair performs four rounds, and
+ * sha256su0/sha256su1 compute the message schedule four words at a time.
+ */
+__attribute__((target("+crypto")))
+static
+void SHA256TransformArm(uint state[8], const uchar *data, size_t blocks)
+{
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    for (; blocks > 0; blocks--, data += 64)
     {
-        t1 = h + EP1(e) + CH(e, f, g) + k[i] + m[i];
-        t2 = EP0(a) + MAJ(a, b, c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+        const uint32x4_t abcdSave = state0;
+        const uint32x4_t efghSave = state1;
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; i++)
+        {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        }
+        for (int i = 0; i < 16; i++)
+        {
+            const uint32x4_t wk = vaddq_u32(msg[i & 3], vld1q_u32(&k[4 * i]));
+            const uint32x4_t abcd = state0;
+            if (i < 12)
+            {
+                msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+                    msg[(i + 2) & 3], msg[(i + 3) & 3]);
+            }
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+        }
+        state0 = vaddq_u32(state0, abcdSave);
+        state1 = vaddq_u32(state1, efghSave);
     }
 
-    ctx->state[0] += a;
-    ctx->state[1] += b;
-    ctx->state[2] += c;
-    ctx->state[3] += d;
-    ctx->state[4] += e;
-    ctx->state[5] += f;
-    ctx->state[6] += g;
-    ctx->state[7] += h;
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+#endif
+
+static
+TransformFunction SelectTransform()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (orb::CpuFeatures::Has(orb::CpuFeatures::FEATURE_SHA_NI))
+    {
+        return SHA256TransformShaNi;
+    }
+#elif defined(__aarch64__)
+    if (orb::CpuFeatures::Has(orb::CpuFeatures::FEATURE_ARM_SHA2))
+    {
+        return SHA256TransformArm;
+    }
+#endif
+    return SHA256TransformScalar;
 }
 
 static
@@ -109,22 +232,44 @@ void SHA256Init(SHA256_CTX *ctx)
     ctx->state[5] = 0x9b05688c;
     ctx->state[6] = 0x1f83d9ab;
     ctx->state[7] = 0x5be0cd19;
+    ctx->transform = SelectTransform();
 }
 
 static
-void SHA256Update(SHA256_CTX *ctx, uchar data[], uint len)
+void SHA256Update(SHA256_CTX *ctx, const uchar data[], size_t len)
 {
-    for (uint i = 0; i < len; ++i)
+    // Top up a partially filled block first
+    if (ctx->datalen > 0)
+    {
+        size_t count = std::min<size_t>(64 - ctx->datalen, len);
+        memcpy(ctx->data + ctx->datalen, data, count);
+        ctx->datalen += count;
+        data += count;
+        len -= count;
+        if (ctx->datalen < 64)
+        {
+            return;
+        }
+        ctx->transform(ctx->state, ctx->data, 1);
+        DBL_INT_ADD(ctx->bitlen[0], ctx->bitlen[1], 512);
+        ctx->datalen = 0;
+    }
+
+    // Then hash the whole blocks in place
+    size_t blocks = len / 64;
+    if (blocks > 0)
     {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
-        if (ctx->datalen == 64)
+        ctx->transform(ctx->state, data, blocks);
+        for (size_t i = 0; i < blocks; i++)
         {
-            SHA256Transform(ctx, ctx->data);
             DBL_INT_ADD(ctx->bitlen[0], ctx->bitlen[1], 512);
-            ctx->datalen = 0;
         }
+        data += blocks * 64;
+        len -= blocks * 64;
     }
+
+    memcpy(ctx->data, data, len);
+    ctx->datalen = len;
 }
 
 static
@@ -146,7 +291,7 @@ void SHA256Final(SHA256_CTX *ctx, uchar hash[])
         while (i < 64)
             ctx->data[i++] = 0x00;
 
-        SHA256Transform(ctx, ctx->data);
+        ctx->transform(ctx->state, ctx->data, 1);
         memset(ctx->data, 0, 56);
     }
 
@@ -159,7 +304,7 @@ void SHA256Final(SHA256_CTX *ctx, uchar hash[])
     ctx->data[58] = ctx->bitlen[1] >> 8;
     ctx->data[57] = ctx->bitlen[1] >> 16;
     ctx->data[56] = ctx->bitlen[1] >> 24;
-    SHA256Transform(ctx, ctx->data);
+    ctx->transform(ctx->state, ctx->data, 1);
 
     for (i = 0; i < 4; ++i)
     {
@@ -186,22 +331,73 @@ namespace orb {
  */
 std::string SHA256::Encrypt(std::string data)
 {
-    int strLen = data.length();
+    static const char hex[] = "0123456789abcdef";
     SHA256_CTX ctx;
     unsigned char hash[32];
-    std::string hashStr = "";
+    std::string hashStr(64, '\0');
 
     SHA256Init(&ctx);
-    SHA256Update(&ctx, (unsigned char *)data.c_str(), strLen);
+    SHA256Update(&ctx, reinterpret_cast<const uchar *>(data.data()), data.length());
     SHA256Final(&ctx, hash);
 
-    char s[3];
     for (int i = 0; i < 32; i++)
     {
-        sprintf(s, "%02x", hash[i]);
-        hashStr += s;
+        hashStr[2 * i] = hex[hash[i] >> 4];
+        hashStr[2 * i + 1] = hex[hash[i] & 0x0f];
     }
 
     return hashStr;
 }
+
+/**
+ * @brief SHA256::Hmac
+ *
+ * Compute the HMAC-SHA256 (RFC 2104) of the specified message.
+ *
+ * @param key     The secret key
+ * @param message The message to be authenticated
+ *
+ * @return The 32 byte message authentication code
+ */
+std::string SHA256::Hmac(const std::string &key, const std::string &message)
+{
+    const uint blockSize = 64;
+    uchar block[blockSize] = {0};
+    uchar hash[32];
+    SHA256_CTX ctx;
+
+    // Keys longer than a block are hashed first
+    if (key.length() > blockSize)
+    {
+        SHA256Init(&ctx);
+        SHA256Update(&ctx, reinterpret_cast<const uchar *>(key.data()), key.length());
+        SHA256Final(&ctx, block);
+    }
+    else
+    {
+        memcpy(block, key.data(), key.length());
+    }
+
+    // inner = H((K ^ ipad) || message)
+    for (uint i = 0; i < blockSize; i++)
+    {
+        block[i] ^= 0x36;
+    }
+    SHA256Init(&ctx);
+    SHA256Update(&ctx, block, blockSize);
+    SHA256Update(&ctx, reinterpret_cast<const uchar *>(message.data()), message.length());
+    SHA256Final(&ctx, hash);
+
+    // outer = H((K ^ opad) || inner)
+    for (uint i = 0; i < blockSize; i++)
+    {
+        block[i] ^= 0x36 ^ 0x5c;
+    }
+    SHA256Init(&ctx);
+    SHA256Update(&ctx, block, blockSize);
+    SHA256Update(&ctx, hash, sizeof(hash));
+    SHA256Final(&ctx, hash);
+
+    return std::string(reinterpret_cast<char *>(hash), sizeof(hash));
+}
 } // namespace orb
@@ -37,5 +37,17 @@ public:
      * @return The encrypted data
      */
     static std::string Encrypt(std::string data);
+
+    /**
+     * @brief SHA256::Hmac
+     *
+     * Compute the HMAC-SHA256 (RFC 2104) of the specified message.
+     *
+     * @param key     The secret key
+     * @param message The message to be authenticated
+     *
+     * @return The 32 byte message authentication code
+     */
+    static std::string Hmac(const std::string &key, const std::string &message);
 }; // class SHA256
 } // namespace orb
@@ -20,6 +20,7 @@
 #include "SHA256.h"
 #include "ORBLogging.h"
 #include <uuid/uuid.h>
+#include <functional>
 
 using namespace orb;
 
@@ -43,78 +44,65 @@ std::string GenerateUUID(void)
 }
 
 /**
- * @brief GetHash
+ * @brief GenerateKey
  *
- * Resolve and return the SHA256 hash of the specified message and key.
+ * Generate and return a random 256 bit key.
  *
- * @param key     The key to be used as input
- * @param message The message to be hashed
- *
- * @return The SHA256 hash
+ * @return a random key
  */
 static
-std::string GetHash(std::string key, std::string message)
+std::string GenerateKey(void)
 {
-    std::string encryptedMessage = SHA256::Encrypt(message + key);
-    return Base64::Encode(encryptedMessage);
+    std::string key;
+    for (int i = 0; i < 2; i++)
+    {
+        uuid_t uuid;
+        uuid_generate_random(uuid);
+        key.append(reinterpret_cast<const char *>(uuid), sizeof(uuid));
+    }
+    return key;
 }
 
 /**
- * @brief CreateTokenFromPayload
+ * @brief GetSignature
  *
- * Create a new JSON token using the specified key and payload.
+ * Resolve and return the signature of the specified payload. The payload is signed in its
+ * compact serialisation, which is canonical as the keys of JSON objects are kept sorted.
  *
- * @param key     The key to be used for creating the JSON token
- * @param payload The payload to be included in the JSON token
+ * @param key     The key to be used for signing
+ * @param payload The payload to be signed
  *
- * @return The resulting JSON token
+ * @return The Base64 encoded HMAC-SHA256 of the payload
  */
 static
-json CreateTokenFromPayload(std::string key, json payload)
+std::string GetSignature(const std::string &key, const json &payload)
 {
-    json token;
-    std::string signature;
-    signature = GetHash(key, payload.dump());
-    if (signature.empty())
-    {
-        return token;
-    }
-    token["payload"] = payload;
-    token["signature"] = signature;
-    return token;
+    return Base64::Encode(SHA256::Hmac(key, payload.dump()));
 }
 
 /**
- * @brief GetTokenPayload
+ * @brief ConstantTimeEquals
  *
- * Get the payload from the specified JSON token.
+ * Compare two signatures in a time that does not depend on where they differ.
  *
- * @param key   The key to be used for assessing the JSON token's claimed signature
- * @param token The JSON token
+ * @param a The first signature
+ * @param b The second signature
  *
- * @return A JSON object containing the payload
+ * @return true if the signatures are equal, otherwise false
  */
 static
-json GetPayloadFromToken(std::string key, json token)
+bool ConstantTimeEquals(const std::string &a, const std::string &b)
 {
-    json payload;
-    std::string claimedSignature;
-    std::string signature;
-    if (token["payload"].is_null() || token["payload"].empty() ||
-        token["signature"].is_null() || token["signature"].empty())
+    if (a.length() != b.length())
     {
-        return "{}"_json;
+        return false;
     }
-    payload = token["payload"];
-    claimedSignature = token["signature"];
-    signature = GetHash(key, payload.dump());
-    ORB_LOG("signature=%s", signature.c_str());
-    if (!signature.empty() && signature == claimedSignature)
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.length(); i++)
     {
-        return payload;
+        difference |= static_cast<unsigned char>(a[i] ^ b[i]);
     }
-    payload = "{}"_json;
-    return payload;
+    return difference == 0;
 }
 
 /**
@@ -145,9 +133,10 @@ namespace orb {
  * Constructor.
  */
 TokenManager::TokenManager()
+    : m_tokenSecretKey(GenerateKey())
+    , m_verifiedTokens(VERIFIED_TOKEN_SLOTS)
 {
     ORB_LOG_NO_ARGS();
-    m_tokenSecretKey = GenerateUUID();
 }
 
 /**
@@ -173,7 +162,10 @@ json TokenManager::CreateToken(int appId, std::string uri)
     payload["appId"] = appId;
     payload["uri"] = uri;
     payload["origin"] = GetOrigin(uri);
-    return CreateTokenFromPayload(m_tokenSecretKey, payload);
+    json token;
+    token["payload"] = payload;
+    token["signature"] = GetSignature(m_tokenSecretKey, payload);
+    return token;
 }
 
 /**
@@ -187,11 +179,33 @@ json TokenManager::CreateToken(int appId, std::string uri)
  */
 json TokenManager::GetTokenPayload(json token)
 {
-    json payload = "{}"_json;
-    if (!token.is_null() && !token.empty())
+    if (!token.is_object())
     {
-        payload = GetPayloadFromToken(m_tokenSecretKey, token);
+        return "{}"_json;
+    }
+    auto payload = token.find("payload");
+    auto claimedSignature = token.find("signature");
+    if (payload == token.end() || payload->is_null() || payload->empty() ||
+        claimedSignature == token.end() || !claimedSignature->is_string())
+    {
+        return "{}"_json;
+    }
+    const std::string &signature = claimedSignature->get_ref<const std::string &>();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    VerifiedToken &verified = m_verifiedTokens[std::hash<std::string>()(signature) %
+                                               VERIFIED_TOKEN_SLOTS];
+    if (ConstantTimeEquals(verified.signature, signature) && verified.payload == *payload)
+    {
+        return verified.payload;
+    }
+    if (!ConstantTimeEquals(GetSignature(m_tokenSecretKey, *payload), signature))
+    {
+        ORB_LOG("Invalid token signature");
+        return "{}"_json;
     }
-    return payload;
+    verified.signature = signature;
+    verified.payload = *payload;
+    return verified.payload;
 }
 } // namespace orb
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -28,6 +30,10 @@ namespace orb {
  * Implementation of a token manager that is used to create and process
  * JSON tokens that are intended to be used by the WPE bridge when issuing
  * requests to the ORB plugin.
+ *
+ * Tokens are signed with HMAC-SHA256 over the compact serialisation of the payload. Tokens that
+ * have been verified recently are remembered, so checking them again costs a table lookup
+ * rather than a serialisation and a hash.
  */
 class TokenManager {
 public:
@@ -67,6 +73,16 @@ public:
 
 private:
 
+    static const size_t VERIFIED_TOKEN_SLOTS = 64;
+
+    struct VerifiedToken
+    {
+        std::string signature;
+        json payload;
+    };
+
     std::string m_tokenSecretKey;
+    std::mutex m_mutex;
+    std::vector<VerifiedToken> m_verifiedTokens; // Indexed by a hash of the signature
 }; // class TokenManager
 } // namespace orb
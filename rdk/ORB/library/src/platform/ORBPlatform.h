@@ -535,7 +535,10 @@ public:
 
 
     /**
-     * Request the specified DVB file from the DSM-CC implementation.
+     * Request the specified DVB file from the DSM-CC implementation. Negative request
+     * identifiers are prefetches by the engine, which can only be cached if the file content is
+     * returned through ORBPlatformEventHandler::OnDvbUrlLoaded and Dsmcc_GetFileVersion is
+     * implemented.
      *
      * @param url       The URL of the requested DVB file
      * @param requestId The unique request identifier
@@ -751,6 +754,26 @@ public:
      * @return true if the call was successful, false otherwise
      */
     virtual bool Drm_SetActiveDrm(std::string drmSystemId) = 0;
+
+    // Methods added after the first release. They are appended with default bodies, so that
+    // platform implementations built against the earlier interface keep working.
+
+    /**
+     * Get the carousel and the version of the module that carry the specified DVB file, from the
+     * DSM-CC implementation's current view of the carousel. ORB only caches the files of
+     * platforms that implement this.
+     *
+     * @param url           The URL of the DVB file
+     * @param carouselId    Set to the ID of the carousel
+     * @param moduleVersion Set to the version of the module that carries the file
+     *
+     * @return true on success, false if the versions are not known
+     */
+    virtual bool Dsmcc_GetFileVersion(std::string url, uint32_t &carouselId,
+        uint32_t &moduleVersion)
+    {
+        return false;
+    }
 }; // class ORBPlatform
 
 /**
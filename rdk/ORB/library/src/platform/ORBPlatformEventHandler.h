@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "ParentalRating.h"
@@ -168,7 +169,8 @@ public:
         std::string status) = 0;
 
     /**
-     * Notify all subscribers that the specified DVB URL load has finished.
+     * Notify all subscribers that the specified DVB URL load has finished. The content is moved,
+     * not copied, on its way to the subscribers, so it should be passed with std::move.
      *
      * @param requestId         The request identifier
      * @param fileContent       The file content
@@ -249,5 +251,31 @@ public:
      * @param drmSystemId ID of the DRM System
      */
     virtual void OnDrmSystemMessage(std::string message, std::string drmSystemId) = 0;
+
+    // Methods added after the first release. They are appended with default bodies, so that
+    // platform implementations built against the earlier interface keep working.
+
+    /**
+     * Notify that the channel list has changed, for example after a channel scan. The channel
+     * list is cached, so the platform must call this whenever it adds, removes or changes
+     * channels without a channel status change.
+     */
+    virtual void OnChannelListChanged()
+    {
+    }
+
+    /**
+     * Notify the engine that a module of the specified DSM-CC object carousel has changed version,
+     * so that the cached files of the carousel are released early. Files of an older module
+     * version are never served, whether or not this is called.
+     *
+     * @param carouselId    The carousel ID
+     * @param moduleId      The module ID
+     * @param moduleVersion The new module version
+     */
+    virtual void OnDsmccModuleVersionChanged(uint32_t carouselId, uint16_t moduleId, uint8_t
+        moduleVersion)
+    {
+    }
 }; // class ORBPlatformEventHandler
 } // namespace orb
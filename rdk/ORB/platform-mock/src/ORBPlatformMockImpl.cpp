@@ -1045,7 +1045,7 @@ void ORBPlatformMockImpl::Dsmcc_RequestFile(std::string url, int requestId)
     std::string content =
         "<html><body style=\"background-color: #333333; color: #aaaaaa;\"><h1>DVB</h1></body></html>";
     std::vector<uint8_t> contentVector(content.begin(), content.end());
-    m_platformEventHandler->OnDvbUrlLoaded(requestId, contentVector, content.length());
+    m_platformEventHandler->OnDvbUrlLoaded(requestId, std::move(contentVector), content.length());
 }
 
 /**
@@ -1104,6 +1104,25 @@ uint32_t ORBPlatformMockImpl::Dsmcc_RequestCarouselId(uint32_t componentTag)
     return 1;
 }
 
+/**
+ * Get the carousel and module version of the given DVB URL. The mock content never changes, so
+ * every file is reported from the first version of carousel 1.
+ *
+ * @param url           The DVB URL
+ * @param carouselId    Receives the carousel id
+ * @param moduleVersion Receives the version of the module that carries the file
+ *
+ * @return true
+ */
+bool ORBPlatformMockImpl::Dsmcc_GetFileVersion(std::string url, uint32_t &carouselId,
+    uint32_t &moduleVersion)
+{
+    ORB_LOG("url=%s", url.c_str());
+    carouselId = 1;
+    moduleVersion = 0;
+    return true;
+}
+
 /******************************************************************************
 ** Manager API
 *****************************************************************************/
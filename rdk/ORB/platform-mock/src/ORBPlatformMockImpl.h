@@ -102,6 +102,8 @@ public:
         listenId) override;
     virtual void Dsmcc_UnsubscribeFromStreamEvents(int listenId) override;
     virtual uint32_t Dsmcc_RequestCarouselId(uint32_t componentTag) override;
+    virtual bool Dsmcc_GetFileVersion(std::string url, uint32_t &carouselId,
+        uint32_t &moduleVersion) override;
 
     // Manager api
     virtual std::string Manager_GetKeyIcon(int keyCode) override;
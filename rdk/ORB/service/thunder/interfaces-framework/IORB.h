@@ -70,6 +70,13 @@ struct EXTERNAL IORB : virtual public Core::IUnknown
         virtual ~INotification()
         {
         }
+
+        // events added after the first release, appended to keep the interface compatible
+
+        // @brief Batch of JavaScriptEventDispatchRequest events, in dispatch order
+        // @param events: JSON array of objects with the eventName, eventProperties, targetOrigin
+        //                and broadcastRelated members
+        virtual void JavaScriptEventsDispatchRequest(std::string events) = 0;
     };
 
     virtual ~IORB()
@@ -113,6 +120,10 @@ struct EXTERNAL IORB : virtual public Core::IUnknown
     virtual void EventInputKeyGenerated(int keyCode, uint8_t keyAction) = 0;
 
     virtual void ExitButtonPressed() = 0;
+
+    // methods added after the first release, appended to keep the interface compatible
+    virtual std::string GetStatistics() = 0;
+    virtual void JavaScriptEventsDispatchRequest(std::string events) = 0;
 };
 } // Exchange
 } // WPEFramework
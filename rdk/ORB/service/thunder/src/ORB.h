@@ -122,6 +122,7 @@ private:
     uint32_t SendKeyEvent(const SendKeyEventParamsData& params, Core::JSON::Boolean& response);
     uint32_t SetPreferredUILanguage(Core::JSON::String preferredUiLanguage);
     uint32_t LaunchApplication(Core::JSON::String url, Core::JSON::Boolean& response);
+    uint32_t GetStatistics(Core::JSON::String& response);
 
 private:
 
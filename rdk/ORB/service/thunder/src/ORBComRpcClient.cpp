@@ -16,6 +16,7 @@
 
 #include "ORBComRpcClient.h"
 #include "ORBLogging.h"
+#include <nlohmann/json.hpp>
 
 MODULE_NAME_DECLARATION(BUILD_REFERENCE)
 
@@ -139,6 +140,37 @@ void ORBComRpcClient::NotificationHandler::ExitButtonPressed()
     }
 }
 
+/**
+ * @brief ORBComRpcClient::NotificationHandler::JavaScriptEventsDispatchRequest
+ *
+ * React to the 'JavaScriptEventsDispatchRequest' event by handling each event in turn as a
+ * 'JavaScriptEventDispatchRequest' event, with its own origin and broadcast relation
+ *
+ * @param events
+ */
+void ORBComRpcClient::NotificationHandler::JavaScriptEventsDispatchRequest(std::string events)
+{
+    ORB_LOG("%s", events.c_str());
+    if (_parent.m_subscribedEvents[EVENT_JAVASCRIPT_EVENT_DISPATCH_REQUESTED] == true)
+    {
+        nlohmann::json array = nlohmann::json::parse(events, nullptr, false);
+        if (!array.is_array())
+        {
+            ORB_LOG("Malformed events");
+            return;
+        }
+        for (const nlohmann::json &event : array)
+        {
+            JavaScriptEventDispatchRequest(
+                event.value("eventName", ""),
+                event.value("eventProperties", ""),
+                event.value("broadcastRelated", false),
+                event.value("targetOrigin", "")
+                );
+        }
+    }
+}
+
 /******************************************************************************
 ** Initialise/Deinitialise and helper methods
 *****************************************************************************/
@@ -56,6 +56,8 @@ public:
 
         virtual void ExitButtonPressed() override;
 
+        virtual void JavaScriptEventsDispatchRequest(std::string events) override;
+
         // Must define an interface map since we are implementing an interface on the exchange
         // so Thunder knows what type we are
         BEGIN_INTERFACE_MAP(NotificationHandler)
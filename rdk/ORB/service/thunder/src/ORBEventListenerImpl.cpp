@@ -72,7 +72,7 @@ void ORBEventListenerImpl::OnDvbUrlLoaded(int requestId, std::vector<uint8_t> co
     contentLength)
 {
     ORB_LOG("PID=%d", getpid());
-    ORBImplementation::instance(nullptr)->DvbUrlLoaded(requestId, &content[0], contentLength);
+    ORBImplementation::instance(nullptr)->DvbUrlLoaded(requestId, content.data(), contentLength);
 }
 
 /**
@@ -106,4 +106,29 @@ void ORBEventListenerImpl::OnExitButtonPressed()
     ORB_LOG_NO_ARGS();
     ORBImplementation::instance(nullptr)->ExitButtonPressed();
 }
+
+/**
+ * Trigger the DvbUrlLoaded event with shared content, without copying it.
+ *
+ * @param requestId The original request identifier
+ * @param content   The retrieved content
+ */
+void ORBEventListenerImpl::OnDvbUrlLoadedShared(int requestId,
+    std::shared_ptr<const std::vector<uint8_t> > content)
+{
+    ORB_LOG("PID=%d", getpid());
+    ORBImplementation::instance(nullptr)->DvbUrlLoaded(requestId, content->data(),
+        content->size());
+}
+
+/**
+ * Trigger the JavaScriptEventDispatchRequested event for each of a batch of events.
+ *
+ * @param events JSON array of the events in dispatch order
+ */
+void ORBEventListenerImpl::OnJavaScriptEventsDispatchRequested(std::string events)
+{
+    ORB_LOG("PID=%d", getpid());
+    ORBImplementation::instance(nullptr)->JavaScriptEventsDispatchRequest(events);
+}
 } // namespace orb
@@ -72,5 +72,21 @@ public:
     virtual void OnInputKeyGenerated(int keyCode, uint8_t keyAction) override;
 
     virtual void OnExitButtonPressed() override;
+
+    /**
+     * Trigger the DvbUrlLoaded event with shared content, without copying it.
+     *
+     * @param requestId The original request identifier
+     * @param content   The retrieved content
+     */
+    virtual void OnDvbUrlLoadedShared(int requestId,
+        std::shared_ptr<const std::vector<uint8_t> > content) override;
+
+    /**
+     * Trigger the JavaScriptEventDispatchRequested event for each of a batch of events.
+     *
+     * @param events JSON array of the events in dispatch order
+     */
+    virtual void OnJavaScriptEventsDispatchRequested(std::string events) override;
 }; // class ORVEventListenerImpl
 } // namespace orb
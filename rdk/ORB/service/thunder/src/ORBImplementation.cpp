@@ -386,5 +386,37 @@ bool ORBImplementation::LaunchApplication(std::string url)
     ORB_LOG_NO_ARGS();
     return ORBEngine::GetSharedInstance().GetApplicationManager()->CreateApplication(0, url);
 }
+
+/**
+ * @brief ORBImplementation::GetStatistics
+ *
+ * Get the statistics of the ORB engine components.
+ *
+ * @return A string representation of the JSON statistics
+ */
+std::string ORBImplementation::GetStatistics()
+{
+    ORB_LOG_NO_ARGS();
+    return ORBEngine::GetSharedInstance().GetStatistics();
+}
+
+/**
+ * @brief ORBImplementation::JavaScriptEventsDispatchRequest
+ *
+ * This method is used to notify each client for the 'JavaScriptEventsDispatchRequest' event
+ *
+ * @param events
+ */
+void ORBImplementation::JavaScriptEventsDispatchRequest(std::string events)
+{
+    ORB_LOG_NO_ARGS();
+
+    // Loop through all the registered callbacks and fire off the notification
+    std::lock_guard<std::mutex> locker(_notificationMutex);
+    for (const auto client : _notificationClients)
+    {
+        client->JavaScriptEventsDispatchRequest(events);
+    }
+}
 }  // namespace Plugin
 }  // namespace WPEFramework
\ No newline at end of file
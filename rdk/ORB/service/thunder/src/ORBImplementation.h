@@ -96,6 +96,10 @@ public:
 
     void ExitButtonPressed() override;
 
+    std::string GetStatistics() override;
+
+    void JavaScriptEventsDispatchRequest(std::string events) override;
+
 private:
 
     mutable Core::CriticalSection _adminLock;
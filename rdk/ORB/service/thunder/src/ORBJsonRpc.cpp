@@ -36,6 +36,7 @@ void ORB::RegisterAll()
         &ORB::SetPreferredUILanguage, this);
     JSONRPC::Register<Core::JSON::String, Core::JSON::Boolean>(_T("LaunchApplication"),
         &ORB::LaunchApplication, this);
+    JSONRPC::Register<void, Core::JSON::String>(_T("GetStatistics"), &ORB::GetStatistics, this);
 }
 
 /**
@@ -49,6 +50,7 @@ void ORB::UnregisterAll()
     JSONRPC::Unregister(_T("SendKeyEvent"));
     JSONRPC::Unregister(_T("SetPreferredUILanguage"));
     JSONRPC::Unregister(_T("LaunchApplication"));
+    JSONRPC::Unregister(_T("GetStatistics"));
 }
 
 /**
@@ -123,5 +125,21 @@ uint32_t ORB::LaunchApplication(Core::JSON::String url, Core::JSON::Boolean& res
     response = _orb->LaunchApplication(url.Value());
     return result;
 }
+
+/**
+ * @brief ORB::GetStatistics
+ *
+ * Get the statistics of the ORB engine components, such as the metadata search queue wait and
+ * execution times.
+ *
+ * @param response A string representation of the JSON statistics
+ *
+ * @return Core::ERROR_NONE
+ */
+uint32_t ORB::GetStatistics(Core::JSON::String& response)
+{
+    response = _orb->GetStatistics();
+    return Core::ERROR_NONE;
+}
 } // namespace Plugin
 } // namespace WPEFramework
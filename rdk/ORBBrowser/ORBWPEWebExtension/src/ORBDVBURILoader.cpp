@@ -32,7 +32,6 @@ ORBDVBURILoader::ORBDVBURILoader(int requestId, WebKitURISchemeRequest *request)
     , m_request(request)
     , m_dataReady(false)
     , m_data(nullptr)
-    , m_dataLength(0)
 {
     ORB_LOG("requestId=%d requestUri=%s", requestId, webkit_uri_scheme_request_get_uri(request));
 }
@@ -46,7 +45,7 @@ ORBDVBURILoader::~ORBDVBURILoader()
     m_request = nullptr;
     if (m_data)
     {
-        free(m_data);
+        g_bytes_unref(m_data);
     }
 }
 
@@ -80,24 +79,19 @@ void ORBDVBURILoader::Finish()
     {
         ORB_LOG("DVB URI scheme request completed with data");
 
-        GInputStream *stream = nullptr;
-        unsigned char *data = (unsigned char *)malloc(sizeof(unsigned char) * m_dataLength);
-        memmove(data, m_data, m_dataLength);
-        stream = g_memory_input_stream_new_from_data((const void *)data, m_dataLength, free);
-
-        if (stream)
-        {
-            ORB_LOG("GInputStream created with dataLength=%d", m_dataLength);
-        }
+        // The stream reads the loaded data in place
+        GInputStream *stream = g_memory_input_stream_new_from_bytes(m_data);
+        ORB_LOG("GInputStream created with dataLength=%u", GetDataLength());
 
         const gchar *uri = webkit_uri_scheme_request_get_uri(m_request);
         ORB_LOG("The uri is: %s", uri);
-        
-        const gchar *mimeType = ORBWPEWebExtensionHelper::GetSharedInstance().GetMimeTypeFromUrl(uri).c_str();
-        ORB_LOG("The mime type is: %s", mimeType);
-        
+
+        std::string mimeType = ORBWPEWebExtensionHelper::GetSharedInstance().GetMimeTypeFromUrl(
+            uri);
+        ORB_LOG("The mime type is: %s", mimeType.c_str());
+
         // Signal completion of the DVB URI scheme request
-        webkit_uri_scheme_request_finish(m_request, stream, m_dataLength, mimeType);
+        webkit_uri_scheme_request_finish(m_request, stream, GetDataLength(), mimeType.c_str());
 
         g_object_unref(stream);
     }
@@ -138,27 +132,22 @@ void ORBDVBURILoader::Finish()
 }
 
 /**
- * Set the loaded data.
+ * Set the loaded data. The loader takes its own reference to the data, which is handed to the
+ * browser without being copied.
  *
- * @param data       The data
- * @param dataLength The data length
+ * @param data The data or nullptr
  */
-void ORBDVBURILoader::SetData(unsigned char *data, unsigned int dataLength)
+void ORBDVBURILoader::SetData(GBytes *data)
 {
-    ORB_LOG("dataLength=%u", dataLength);
+    ORB_LOG("dataLength=%zu", data ? g_bytes_get_size(data) : 0);
     if (m_data)
     {
-        free(m_data);
+        g_bytes_unref(m_data);
+        m_data = nullptr;
     }
-    if (data != nullptr && dataLength > 0)
+    if (data != nullptr && g_bytes_get_size(data) > 0)
     {
-        m_data = (unsigned char *) malloc(sizeof(unsigned char) * (dataLength + 1));
-        for (int i = 0; i < dataLength; i++)
-        {
-            m_data[i] = data[i];
-        }
-        m_data[dataLength] = '\0';
-        m_dataLength = dataLength;
+        m_data = g_bytes_ref(data);
     }
 }
 } // namespace orb
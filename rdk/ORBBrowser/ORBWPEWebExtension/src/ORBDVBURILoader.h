@@ -61,12 +61,12 @@ public:
     }
 
     /**
-     * Set the loaded data.
+     * Set the loaded data. The loader takes its own reference to the data, which is handed to
+     * the browser without being copied.
      *
-     * @param data       The data
-     * @param dataLength The data length
+     * @param data The data or nullptr
      */
-    void SetData(unsigned char *data, unsigned int dataLength);
+    void SetData(GBytes *data);
 
     /**
      * Get the dataReady flag.
@@ -83,7 +83,7 @@ public:
      *
      * @return The loaded data or nullptr
      */
-    unsigned char* GetData()
+    GBytes* GetData()
     {
         return m_data;
     }
@@ -95,7 +95,7 @@ public:
      */
     unsigned int GetDataLength()
     {
-        return m_dataLength;
+        return m_data ? g_bytes_get_size(m_data) : 0;
     }
 
 private:
@@ -103,7 +103,6 @@ private:
     int m_requestId;
     WebKitURISchemeRequest *m_request;
     bool m_dataReady;
-    unsigned char *m_data;
-    unsigned int m_dataLength;
+    GBytes *m_data;
 }; // class ORBDVBURILoader
 } // namespace orb
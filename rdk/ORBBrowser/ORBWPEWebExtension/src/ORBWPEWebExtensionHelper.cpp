@@ -110,32 +110,60 @@ static std::string ReadFileContentsIntoString(std::string filePath)
 }
 
 /**
- * Read the available Dsmcc file from the shared memory.
+ * A Dsmcc file mapped from the shared memory.
+ */
+struct DsmccFileMapping
+{
+    void *address;
+    size_t length;
+};
+
+/**
+ * Unmap a Dsmcc file once the last reference to its content is released.
+ *
+ * @param userData The DsmccFileMapping
+ */
+static void UnmapDsmccFile(gpointer userData)
+{
+    DsmccFileMapping *mapping = static_cast<DsmccFileMapping *>(userData);
+    munmap(mapping->address, mapping->length);
+    delete mapping;
+}
+
+/**
+ * Map the available Dsmcc file from the shared memory. The content is not copied; the mapping
+ * is released with the last reference to the returned bytes.
  *
  * @param requestId The corresponding Dsmcc request id
  * @param fileSize  The Dsmcc file size
  *
- * @return The Dsmcc file content
+ * @return The Dsmcc file content, or nullptr if it could not be mapped
  */
-static unsigned char* ReadDsmccFileFromSharedMemory(int requestId, int fileSize)
+static GBytes* MapDsmccFileFromSharedMemory(int requestId, unsigned int fileSize)
 {
-    unsigned char *buffer = (unsigned char *) malloc(fileSize);
-
     std::string name = "orb-dsmcc-request-" + std::to_string(requestId);
 
-    ORB_LOG("requestId=%d fileName=%s fileSize=%d", requestId, name.c_str(), fileSize);
+    ORB_LOG("requestId=%d fileName=%s fileSize=%u", requestId, name.c_str(), fileSize);
 
     int shm_fd = shm_open(name.c_str(), O_RDONLY, 0666);
-    uint8_t *ptr = (uint8_t *) mmap(0, fileSize, PROT_READ, MAP_SHARED, shm_fd, 0);
-
-    memmove(buffer, ptr, fileSize);
+    if (shm_fd < 0)
+    {
+        ORB_LOG("Failed to open %s", name.c_str());
+        return nullptr;
+    }
+    void *ptr = mmap(0, fileSize, PROT_READ, MAP_SHARED, shm_fd, 0);
 
-    munmap(ptr, fileSize);
+    // The mapping remains valid after the object is unlinked and the descriptor closed
     shm_unlink(name.c_str());
-
     close(shm_fd);
 
-    return buffer;
+    if (ptr == MAP_FAILED)
+    {
+        ORB_LOG("Failed to map %s", name.c_str());
+        return nullptr;
+    }
+    return g_bytes_new_with_free_func(ptr, fileSize, UnmapDsmccFile,
+        new DsmccFileMapping{ptr, fileSize});
 }
 
 /**
@@ -162,22 +190,22 @@ static void OnDvbUrlLoadedNoData(int requestId, unsigned int contentLength)
 {
     ORB_LOG("requestId=%d contentLength=%u", requestId, contentLength);
 
-    unsigned char *content = nullptr;
+    GBytes *content = nullptr;
 
-    // Read file content from shared memory only if the DVB URL was successfully loaded
+    // Map file content from shared memory only if the DVB URL was successfully loaded
     if (contentLength > 0)
     {
-        ORB_LOG("Read dsmcc file content from shared memory");
-        content = ReadDsmccFileFromSharedMemory(requestId, contentLength);
+        ORB_LOG("Map dsmcc file content from shared memory");
+        content = MapDsmccFileFromSharedMemory(requestId, contentLength);
     }
 
     {
         std::lock_guard<std::mutex> lk(m);
-        s_dvbUriLoaders[requestId]->SetData(content, contentLength);
+        s_dvbUriLoaders[requestId]->SetData(content);
         s_dvbUriLoaders[requestId]->SetDataReady(true);
         if (content)
         {
-            free(content);
+            g_bytes_unref(content);
         }
     }
     cv.notify_one();